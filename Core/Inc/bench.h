@@ -0,0 +1,31 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdint.h>
+
+// Benchmarks report one line at a time through this callback
+typedef void (*BenchPrintFn)(const char *line);
+
+void Bench_init(void);
+uint64_t Bench_ticks(void);
+const char *Bench_tickUnit(void);
+
+void Bench_canonicalSort(BenchPrintFn print, int tripleCount);
+void Bench_canonicalize(BenchPrintFn print, int credentials, int ringSize);
+void Bench_recanonicalize(BenchPrintFn print, int claims);
+void Bench_index(BenchPrintFn print, int tripleCount);
+void Bench_tripleColumns(BenchPrintFn print, int tripleCount);
+void Bench_jsonld(BenchPrintFn print, int claims);
+void Bench_credentialTemplate(BenchPrintFn print);
+void Bench_jsonldRead(BenchPrintFn print, int proofCount);
+void Bench_jcs(BenchPrintFn print, int proofCount);
+void Bench_signingMidstate(BenchPrintFn print);
+void Bench_presign(BenchPrintFn print, int signatures);
+void Bench_ed25519(BenchPrintFn print, int signatures);
+void Bench_ed25519Hash(BenchPrintFn print);
+void Bench_ed25519Batch(BenchPrintFn print, int signatures);
+void Bench_nquadsRead(BenchPrintFn print, int claims);
+void Bench_vocabLookup(BenchPrintFn print);
+void Bench_runAll(BenchPrintFn print);
+
+#endif /* BENCH_H */
@@ -0,0 +1,53 @@
+#ifndef CREDENTIAL_TEMPLATE_H
+#define CREDENTIAL_TEMPLATE_H
+
+#include <stdint.h>
+
+#include "credential_template_tables.h"
+#include "rdf_graph.h"
+#include "sha256.h"
+
+// A value's place in CredentialTemplate_text
+typedef struct {
+    uint16_t offset;
+    uint16_t length;
+} CredentialHole;
+
+// The credential as JSONLD_writeDocument() prints it, compiled in by
+// Tools/gen_template.py, with room reserved at each hole
+extern const char CredentialTemplate_text[CREDENTIAL_TEMPLATE_SIZE + 1];
+extern const CredentialHole CredentialTemplate_holes[CREDENTIAL_HOLE_COUNT];
+
+// The credential without its jws in JCS form, what hashCredential() signs
+// with CREDSIGN_JCS. Holes it does not contain have length 0.
+extern const char CredentialTemplate_signingText[CREDENTIAL_SIGNING_SIZE + 1];
+extern const CredentialHole CredentialTemplate_signingHoles[CREDENTIAL_HOLE_COUNT];
+
+// Copy the template to out[0..size), NUL-terminated, and patch in
+// values[i] for hole i. Every value must fill its hole exactly and need no
+// JSON escaping; otherwise RDF_ERR_INVALID is returned and out is left
+// alone, as it is with RDF_ERR_OVERFLOW when size is too small.
+RDFStatus CredentialTemplate_write(char *out, size_t size, const char *const values[CREDENTIAL_HOLE_COUNT]);
+
+// Overwrite one hole of a credential CredentialTemplate_write() produced,
+// e.g. the jws once it has been computed
+RDFStatus CredentialTemplate_patch(char *out, CredentialHoleId hole, const char *value);
+
+// Stream the template with the holes filled to sink, in as many chunks as
+// there are holes plus one, without copying it
+RDFStatus CredentialTemplate_stream(const char *const values[CREDENTIAL_HOLE_COUNT], RDFSinkFn sink, void *ctx);
+
+// SHA-224 midstate after the whole blocks of the signing input that come
+// before its first hole. They are the same for every credential, so it is
+// computed once and kept.
+void CredentialTemplate_signingPrefix(SHA256Midstate *prefix);
+
+// SHA-224 of the signing input with values patched in, resumed from
+// prefix: only the bytes from prefix->length on are hashed. The digest is
+// that of the whole text, so signatures do not change. values[i] is read
+// for the holes the signing input contains; they must fit as for
+// CredentialTemplate_write(), or RDF_ERR_INVALID is returned.
+RDFStatus CredentialTemplate_signingDigest(const SHA256Midstate *prefix, const char *const values[CREDENTIAL_HOLE_COUNT],
+                                           uint8_t digest[SHA224_DIGEST_SIZE]);
+
+#endif /* CREDENTIAL_TEMPLATE_H */
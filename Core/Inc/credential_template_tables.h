@@ -0,0 +1,18 @@
+/* Generated by Tools/gen_template.py from Tools/credential_template.json, do not edit. */
+
+#ifndef CREDENTIAL_TEMPLATE_TABLES_H
+#define CREDENTIAL_TEMPLATE_TABLES_H
+
+typedef enum {
+    CREDENTIAL_HOLE_CREATED = 0,
+    CREDENTIAL_HOLE_JWS = 1,
+    CREDENTIAL_HOLE_COUNT = 2
+} CredentialHoleId;
+
+// Bytes of the document and of its signing input, without a terminating NUL
+#define CREDENTIAL_TEMPLATE_SIZE 480
+#define CREDENTIAL_SIGNING_SIZE 284
+#define CREDENTIAL_CREATED_SIZE 20
+#define CREDENTIAL_JWS_SIZE 128
+
+#endif /* CREDENTIAL_TEMPLATE_TABLES_H */
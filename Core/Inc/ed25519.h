@@ -0,0 +1,41 @@
+#ifndef ED25519_H
+#define ED25519_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Ed25519 as RFC 8032 defines it, with SHA-512, on monocypher's curve
+// arithmetic. monocypher's own crypto_eddsa_* hash with BLAKE2b instead;
+// keys and signatures of the two do not mix. Key layout is monocypher's:
+// the secret key is the 32-byte seed followed by the public key.
+
+// Derive the key pair from a 32-byte seed, which is wiped
+void Ed25519_keyPair(uint8_t secretKey[64], uint8_t publicKey[32], uint8_t seed[32]);
+
+void Ed25519_sign(uint8_t signature[64], const uint8_t secretKey[64], const uint8_t *message, size_t length);
+
+// 0 when signature is publicKey's over message[0..length), -1 otherwise
+int Ed25519_check(const uint8_t signature[64], const uint8_t publicKey[32], const uint8_t *message, size_t length);
+
+// One (signature, key, message) tuple of a batch
+typedef struct {
+    const uint8_t *signature;
+    const uint8_t *publicKey;
+    const uint8_t *message;
+    size_t length;
+} Ed25519BatchItem;
+
+// Check count tuples at once. Each run of up to CRYPTO_EDDSA_BATCH_MAX
+// (16) is one multi-scalar multiplication, under half the cost per item
+// of Ed25519_check(); a run that fails is checked item by item to find
+// the culprits. Throughput per item is flat past one full run: a longer
+// batch is simply more runs. results[i] receives what Ed25519_check() would return for
+// items[i]. Returns 0 when every item holds, -1 otherwise.
+//
+// random must be 32 secret bytes, fresh for each call (getrandom() on
+// the gateway): the items are weighted by values derived from it, and
+// whoever can predict them can craft a batch that passes with a forgery.
+// Like the single check, the batch equation is cofactored.
+int Ed25519_checkBatch(const Ed25519BatchItem *items, size_t count, const uint8_t random[32], int *results);
+
+#endif /* ED25519_H */
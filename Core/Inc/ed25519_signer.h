@@ -0,0 +1,36 @@
+#ifndef ED25519_SIGNER_H
+#define ED25519_SIGNER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define ED25519_PUBLIC_KEY_SIZE 32
+#define ED25519_SIGNATURE_SIZE 64
+
+// Ed25519Signer "class": an RFC 8032 Ed25519 key pair and the calls that
+// sign and verify with it, the counterpart of Signer for the Ed25519 Data
+// Integrity suites. EdDSA nonces are derived from the key and the message,
+// so unlike ECDSA it needs no entropy after the seed.
+typedef struct {
+    uint8_t secretKey[64];      // seed, then the public key
+    uint8_t publicKey[ED25519_PUBLIC_KEY_SIZE];
+    uint32_t cycles;            // DWT cycles the last call took
+} Ed25519Signer;
+
+// Derive the key pair from seed, at least 32 random bytes. Also starts the
+// DWT cycle counter.
+void Ed25519Signer_init(Ed25519Signer *signer, const uint8_t *seed, size_t seedLength);
+
+// Sign message[0..length), the whole signing input: EdDSA hashes it itself
+void Ed25519Signer_sign(Ed25519Signer *signer, const uint8_t *message, size_t length,
+                        uint8_t signature[ED25519_SIGNATURE_SIZE]);
+
+// Check signature over message[0..length) against publicKey, or the
+// signer's own key when it is NULL. 1 when it holds, 0 otherwise.
+int Ed25519Signer_verify(Ed25519Signer *signer, const uint8_t *publicKey, const uint8_t *message, size_t length,
+                         const uint8_t signature[ED25519_SIGNATURE_SIZE]);
+
+// Wipe the secret key
+void Ed25519Signer_free(Ed25519Signer *signer);
+
+#endif /* ED25519_SIGNER_H */
@@ -0,0 +1,29 @@
+#ifndef JSON_CANON_H
+#define JSON_CANON_H
+
+#include "jsonld_writer.h"
+#include "rdf_graph.h"
+
+// Longest number JSONCanon_write() reads that is not a plain integer of up
+// to 15 digits; longer ones fail with RDF_ERR_LIMIT
+#ifndef JSON_CANON_NUMBER_MAX
+#define JSON_CANON_NUMBER_MAX 40
+#endif
+
+// Write json[0..length) in the JSON Canonicalization Scheme (RFC 8785):
+// no whitespace, members sorted by the UTF-16 code units of their keys,
+// strings with the minimal escapes and numbers as ECMAScript prints them.
+// Members whose key is omit are left out wherever they occur, e.g. the
+// signature of a signed document; omit may be NULL. The document is read
+// in place and the result goes straight to writer, so with a sink the
+// canonical form is never assembled; the writer is finished.
+//
+// scratch takes 12 bytes (24 on a 64-bit host) per member of each object
+// being written, released again. Malformed JSON, duplicate keys, lone
+// surrogates, invalid UTF-8 and numbers beyond double range fail with
+// RDF_ERR_INVALID. Numbers other than short integers are converted with
+// strtod() and snprintf("%e"), which newlib-nano only offers when linked
+// with -u _printf_float.
+RDFStatus JSONCanon_write(const char *json, size_t length, const char *omit, RDFArena *scratch, JSONWriter *writer);
+
+#endif /* JSON_CANON_H */
@@ -0,0 +1,68 @@
+#ifndef JSON_PARSER_H
+#define JSON_PARSER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rdf_graph.h"
+
+// Deepest nesting of objects and arrays a document may use (at most 32)
+#ifndef JSON_MAX_DEPTH
+#define JSON_MAX_DEPTH 16
+#endif
+
+typedef enum {
+    JSON_OBJECT_BEGIN,
+    JSON_OBJECT_END,
+    JSON_ARRAY_BEGIN,
+    JSON_ARRAY_END,
+    JSON_KEY,
+    JSON_STRING,
+    JSON_NUMBER,
+    JSON_TRUE,
+    JSON_FALSE,
+    JSON_NULL
+} JSONEvent;
+
+// Keys, strings and numbers point into the parsed buffer. For keys and
+// strings text excludes the quotes, which are at text[-1] and text[length];
+// escaped says the text still contains backslash escapes.
+typedef struct {
+    const char *text;
+    size_t length;
+    int escaped;
+} JSONToken;
+
+// Called once per event; anything but RDF_OK stops the parser and is
+// returned from JSONParser_feed()
+typedef RDFStatus (*JSONHandlerFn)(void *ctx, JSONEvent event, const JSONToken *token);
+
+// JSONParser "class": a SAX-style tokenizer that never copies the input.
+// The document is read from one buffer the caller keeps filling, so a
+// token can span several feeds and still be handed out as a pointer.
+typedef struct {
+    const char *buffer;
+    size_t offset;          // next byte to scan
+    size_t tokenStart;      // first byte of the string or number being scanned
+    uint32_t objects;       // bit n set: nesting level n is an object
+    uint8_t depth;
+    uint8_t state;
+    uint8_t substate;       // progress through an escape, number or literal
+    uint8_t flags;
+    JSONHandlerFn handler;
+    void *ctx;
+    RDFStatus status;
+} JSONParser;
+
+void JSONParser_init(JSONParser *parser, const char *buffer, JSONHandlerFn handler, void *ctx);
+
+// Scan buffer[0..available), which extends what previous calls saw.
+// Returns RDF_ERR_INVALID on malformed input, RDF_ERR_LIMIT when nesting
+// exceeds JSON_MAX_DEPTH, or the first error the handler returned.
+RDFStatus JSONParser_feed(JSONParser *parser, size_t available);
+
+// Non-zero once the top-level object or array is complete; the document
+// must be an object or an array
+int JSONParser_done(const JSONParser *parser);
+
+#endif /* JSON_PARSER_H */
@@ -0,0 +1,98 @@
+#ifndef JSONLD_CONTEXT_H
+#define JSONLD_CONTEXT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "jsonld_context_tables.h"
+#include "rdf_graph.h"
+#include "rdf_vocab.h"
+
+// Deepest nesting of node objects a document may use
+#ifndef JSONLD_MAX_DEPTH
+#define JSONLD_MAX_DEPTH 8
+#endif
+
+// Contexts one document may list in @context
+#ifndef JSONLD_MAX_CONTEXTS
+#define JSONLD_MAX_CONTEXTS 4
+#endif
+
+// What a string value of a property stands for
+typedef enum {
+    JSONLD_UNDEFINED,          // no term definition
+    JSONLD_COERCE_NONE,        // plain literal
+    JSONLD_COERCE_ID,          // IRI
+    JSONLD_COERCE_VOCAB,       // term if the context defines one, IRI otherwise
+    JSONLD_COERCE_DATETIME,    // xsd:dateTime literal
+    JSONLD_COERCE_GRAPH,       // node objects go to a graph of their own
+    JSONLD_COERCE_UNSUPPORTED  // a container or datatype this processor lacks
+} JSONLDCoercion;
+
+// Keywords a context aliases
+#define JSONLD_ALIAS_ID   0x01  // "id": "@id"
+#define JSONLD_ALIAS_TYPE 0x02  // "type": "@type"
+
+// A term whose name is not the vocabulary's compact name for its IRI
+typedef struct {
+    const char *name;
+    const char *iri;
+    uint8_t nameLength;
+    uint8_t iriLength;
+    uint8_t coercion;
+} JSONLDTermDefinition;
+
+// A context document compiled by Tools/gen_context.py. Vocabulary terms it
+// defines under their compact name cost one byte each; other definitions
+// are binary searched by name, or through termsByIri by IRI.
+typedef struct {
+    const char *url;
+    uint8_t urlLength;
+    uint8_t aliases;                      // JSONLD_ALIAS_* flags
+    const char *vocab;                    // @vocab, NULL if there is none
+    uint8_t vocabLength;
+    const uint8_t *coercions;             // vocabulary term -> JSONLDCoercion
+    const JSONLDTermDefinition *terms;    // sorted by name
+    const uint8_t *termsByIri;            // indexes into terms, sorted by IRI
+    uint8_t termCount;
+} JSONLDContextEntry;
+
+extern const JSONLDContextEntry JSONLD_contexts[JSONLD_CONTEXT_COUNT];
+
+// The contexts in effect for a document, later ones taking precedence as
+// in an @context array
+typedef struct {
+    uint8_t ids[JSONLD_MAX_CONTEXTS];
+    uint8_t count;
+} JSONLDActiveContext;
+
+// An expanded key or @type value: a vocabulary term, or iri[0..iriLength)
+// followed by the name itself when it is relative to @vocab
+typedef struct {
+    RDFVocabTerm term;
+    const char *iri;
+    size_t iriLength;
+    uint8_t vocabRelative;
+    uint8_t coercion;
+} JSONLDExpansion;
+
+void JSONLDActiveContext_init(JSONLDActiveContext *context);
+
+// Append the context the document refers to by url. RDF_ERR_INVALID if it
+// was not compiled in, RDF_ERR_LIMIT beyond JSONLD_MAX_CONTEXTS.
+RDFStatus JSONLDActiveContext_add(JSONLDActiveContext *context, const char *url, size_t len);
+
+int JSONLDActiveContext_aliases(const JSONLDActiveContext *context, uint8_t alias);
+
+// Expand name as a key. Returns its coercion, JSONLD_UNDEFINED when no
+// context defines the name and there is no @vocab.
+uint8_t JSONLDActiveContext_expand(const JSONLDActiveContext *context, const char *name, size_t len,
+                                   JSONLDExpansion *out);
+
+// A name that expands back to iri (term is its vocabulary term or
+// RDF_VOCAB_NONE), NULL if only the IRI itself will do. Sets *coercion to
+// the name's coercion; names whose coercion is unsupported are not used.
+const char *JSONLDActiveContext_compact(const JSONLDActiveContext *context, const char *iri, size_t len,
+                                        RDFVocabTerm term, size_t *nameLength, uint8_t *coercion);
+
+#endif /* JSONLD_CONTEXT_H */
@@ -0,0 +1,19 @@
+/* Generated by Tools/gen_context.py from Tools/contexts, do not edit. */
+
+#ifndef JSONLD_CONTEXT_TABLES_H
+#define JSONLD_CONTEXT_TABLES_H
+
+typedef enum {
+    JSONLD_CONTEXT_SCHEMA_ORG = 0,
+    JSONLD_CONTEXT_SECURITY_V1 = 1,
+    JSONLD_CONTEXT_SECURITY_V2 = 2,
+    JSONLD_CONTEXT_CREDENTIALS_V1 = 3,
+    JSONLD_CONTEXT_COUNT = 4
+} JSONLDContextId;
+
+#define JSONLD_URL_SCHEMA_ORG "http://schema.org/"
+#define JSONLD_URL_SECURITY_V1 "https://w3id.org/security/v1"
+#define JSONLD_URL_SECURITY_V2 "https://w3id.org/security/v2"
+#define JSONLD_URL_CREDENTIALS_V1 "https://www.w3.org/2018/credentials/v1"
+
+#endif /* JSONLD_CONTEXT_TABLES_H */
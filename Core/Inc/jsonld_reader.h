@@ -0,0 +1,61 @@
+#ifndef JSONLD_READER_H
+#define JSONLD_READER_H
+
+#include "json_parser.h"
+#include "jsonld_context.h"
+#include "rdf_graph.h"
+
+// Room for a term that does not appear in the input as it stands: a typed
+// literal, or a string that has to be unescaped. Longer ones fail with
+// RDF_ERR_LIMIT.
+#ifndef JSONLD_TERM_SCRATCH
+#define JSONLD_TERM_SCRATCH 256
+#endif
+
+typedef struct {
+    RDFTermId subject;        // RDF_NO_TERM until @id or the first property
+    RDFTermId graph;          // graph the node's statements go to
+    RDFTermId parent;         // statement linking the node to its parent,
+    RDFTermId parentProperty; // made once the subject is known
+    RDFTermId property;       // property whose value is being read
+    uint8_t coercion;         // how string values of property become terms
+    uint8_t expectId;         // the next string is the value of @id
+    uint8_t valueState;       // where in a value object the reader is
+    uint8_t nodes;            // the top-level @graph, its values are nodes
+} JSONLDFrame;
+
+// JSONLDReader "class": turns a JSON-LD document into RDF as it arrives.
+// Terms that occur verbatim in the input, and vocabulary IRIs, are interned
+// by reference, so the buffer must outlive the graph. Supported are node
+// objects with @id first, @type, arrays, absolute IRIs as keys, terms and
+// type coercions of the contexts compiled in by Tools/gen_context.py, and
+// value objects with a string @value first and then @language or @type,
+// and a top-level @graph of node objects after @context, as
+// JSONLD_writeDocument() writes them.
+// The top-level node lists those by URL in @context, first of its keys;
+// inline contexts, unknown URLs and @context in nested nodes fail with
+// RDF_ERR_INVALID, as do keywords and coercions beyond the above and
+// non-integer numbers. Terms no context defines are dropped as JSON-LD
+// does.
+typedef struct {
+    JSONParser parser;
+    RDFGraph *graph;
+    JSONLDFrame frames[JSONLD_MAX_DEPTH];
+    JSONLDActiveContext context;
+    uint8_t contextState;     // reading the value of @context
+    int depth;
+    int skip;                 // open containers of a value being dropped
+    int skipNext;             // drop the next value
+    unsigned blankNodes;
+    size_t termLength;
+    char term[JSONLD_TERM_SCRATCH];
+} JSONLDReader;
+
+void JSONLDReader_init(JSONLDReader *reader, RDFGraph *graph, const char *buffer);
+
+// Read buffer[0..available), continuing where the previous call stopped
+RDFStatus JSONLDReader_feed(JSONLDReader *reader, size_t available);
+
+int JSONLDReader_done(const JSONLDReader *reader);
+
+#endif /* JSONLD_READER_H */
@@ -0,0 +1,53 @@
+#ifndef JSONLD_WRITER_H
+#define JSONLD_WRITER_H
+
+#include "jsonld_context.h"
+#include "rdf_graph.h"
+#include "rdf_index.h"
+
+// Cursor-based output writer. Every write is O(length of the data): the
+// writer knows where the text ends and how much room is left, so nothing
+// rescans the output and nothing is written past the buffer.
+//
+//  - buffer NULL:  measure only, total ends up as the exact output size
+//  - sink NULL:    bounded string, overflow fails with RDF_ERR_OVERFLOW
+//  - sink set:     the buffer is flushed to sink whenever it fills up
+typedef struct {
+    char *buffer;
+    size_t capacity;          // usable bytes, excluding the terminating NUL
+    size_t length;            // bytes currently held in buffer
+    size_t total;             // bytes produced so far, flushed or not
+    RDFSinkFn sink;
+    void *ctx;
+    RDFStatus status;
+} JSONWriter;
+
+void JSONWriter_init(JSONWriter *writer, char *buffer, size_t size, RDFSinkFn sink, void *ctx);
+void JSONWriter_write(JSONWriter *writer, const char *data, size_t len);
+void JSONWriter_puts(JSONWriter *writer, const char *str);
+void JSONWriter_string(JSONWriter *writer, const char *str, size_t len);
+// str escaped as inside a JSON string, without the quotes: '"', '\\' and
+// control characters only, as RFC 8785 has it
+void JSONWriter_escape(JSONWriter *writer, const char *str, size_t len);
+RDFStatus JSONWriter_finish(JSONWriter *writer);
+
+// Write graph as one JSON-LD document in a single pass over its triples.
+// Each subject becomes a node object; a blank node used once as an object
+// is nested where it is used, and so is the node of a blank graph name
+// used once (the proof under "proof"). A predicate with several values
+// gets an array. Keys and @type values are compacted, and values coerced,
+// with the term definitions of context; "@context" lists its URLs. IRIs it
+// has no term for are written in full, and context may be NULL. Several
+// top-level nodes, and named graphs that do not nest, go in "@graph".
+//
+// A subject's triples must be contiguous and in one graph, and its values
+// of a predicate adjacent, as after RDFGraph_canonicalize(); otherwise
+// RDF_ERR_INVALID is returned. scratch takes up to 20 bytes per term and
+// is released again.
+RDFStatus JSONLD_writeDocument(const RDFGraph *graph, const JSONLDActiveContext *context, RDFArena *scratch,
+                               JSONWriter *writer);
+
+// Exact number of bytes JSONLD_writeDocument() produces, without the NUL
+size_t JSONLD_documentSize(const RDFGraph *graph, const JSONLDActiveContext *context, RDFArena *scratch);
+
+#endif /* JSONLD_WRITER_H */
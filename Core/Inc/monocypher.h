@@ -241,6 +241,21 @@ int crypto_eddsa_check_equation(const uint8_t signature[64],
                                 const uint8_t public_key[32],
                                 const uint8_t h_ram[32]);
 
+// Batch of check equations, weighted by 128-bit secret random weights
+// (local addition).  0 when the whole batch holds, -1 when any item fails
+// or count exceeds CRYPTO_EDDSA_BATCH_MAX.  Takes about 1.3 KB of stack
+// per item of the cap, 21 KB at 16.  Throughput per item stops improving
+// at about 16 items (Straus shares only the doublings), so raising the cap
+// costs stack and gains little; see monocypher.c.
+#ifndef CRYPTO_EDDSA_BATCH_MAX
+#define CRYPTO_EDDSA_BATCH_MAX 16
+#endif
+int crypto_eddsa_check_batch_equation(const uint8_t *const signatures[],
+                                      const uint8_t *const public_keys[],
+                                      const uint8_t h_rams[][32],
+                                      const uint8_t weights[][16],
+                                      size_t count);
+
 
 // Chacha20
 // --------
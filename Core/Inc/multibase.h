@@ -0,0 +1,24 @@
+#ifndef MULTIBASE_H
+#define MULTIBASE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Multibase base58btc: 'z' and the Bitcoin base58 digits, how Data
+// Integrity proofs carry their proofValue and Multikey their keys.
+
+// Characters Multibase_encode() needs for length bytes, without the
+// terminating NUL; a bound, 90 for a 64-byte signature that takes 89
+#define MULTIBASE_MAX_LENGTH(length) (2 + (length) * 138 / 100)
+
+// Write data[0..length) as "z<base58>" and a NUL to out[0..size), which
+// MULTIBASE_MAX_LENGTH(length) + 1 bytes always fit. Returns the
+// characters written, 0 when out is too small. Quadratic in length,
+// meant for signatures and keys.
+size_t Multibase_encode(const uint8_t *data, size_t length, char *out, size_t size);
+
+// Decode text[0..textLength), which must be base58btc of exactly
+// outLength bytes, into out. 1 on success, 0 otherwise.
+int Multibase_decode(const char *text, size_t textLength, uint8_t *out, size_t outLength);
+
+#endif /* MULTIBASE_H */
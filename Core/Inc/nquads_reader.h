@@ -0,0 +1,44 @@
+#ifndef NQUADS_READER_H
+#define NQUADS_READER_H
+
+#include "rdf_graph.h"
+
+// Room for the term being read, in the graph's text convention. Longer
+// terms fail with RDF_ERR_LIMIT.
+#ifndef NQUADS_TERM_SCRATCH
+#define NQUADS_TERM_SCRATCH 256
+#endif
+
+// NQuadsReader "class": turns N-Quads (and so N-Triples) into RDF as the
+// bytes arrive, in chunks of any size and split anywhere, e.g. as a UART
+// delivers them. Each term is interned by copy as soon as it ends, so the
+// input need not outlive the call that passed it, and the reader takes no
+// memory beyond itself and the graph. Escapes are decoded, literals are
+// kept with the canonical N-Quads escapes and ^^xsd:string is dropped, as
+// RDFCanon expects. Relative IRIs and other syntax errors fail with
+// RDF_ERR_INVALID; after any error the reader has to be initialized again.
+typedef struct {
+    RDFGraph *graph;
+    RDFTermId terms[4];         // of the statement being read
+    uint8_t count;              // terms in terms[]
+    uint8_t state;
+    uint8_t resume;             // state to return to after an escape
+    uint8_t digits;             // hex digits of a \u or \U escape still to come
+    uint8_t dots;               // '.' read after a blank node label, held back
+    uint32_t codePoint;
+    size_t datatype;            // where a typed literal's datatype IRI starts in term
+    unsigned long line;         // line being read, from 1, for error reports
+    size_t termLength;
+    char term[NQUADS_TERM_SCRATCH];
+} NQuadsReader;
+
+void NQuadsReader_init(NQuadsReader *reader, RDFGraph *graph);
+
+// Read data[0..len), continuing where the previous call stopped
+RDFStatus NQuadsReader_feed(NQuadsReader *reader, const char *data, size_t len);
+
+// End of input: fails with RDF_ERR_INVALID inside an unfinished statement.
+// The last line needs no line break.
+RDFStatus NQuadsReader_finish(NQuadsReader *reader);
+
+#endif /* NQUADS_READER_H */
@@ -0,0 +1,34 @@
+#ifndef P256_H
+#define P256_H
+
+#include <stdint.h>
+
+// NIST P-256 arithmetic for the parts of ECDSA that cmox does not expose:
+// the nonce point k·G on its own and scalars mod the group order n. It is
+// what signing ahead of the message needs; cmox still verifies.
+
+#define P256_BYTES 32
+
+// 256-bit integer as 32-bit limbs, least significant first
+typedef struct {
+    uint32_t limb[8];
+} P256Int;
+
+// Big-endian bytes, as keys and signatures are laid out
+void P256Int_fromBytes(P256Int *a, const uint8_t bytes[P256_BYTES]);
+void P256Int_toBytes(uint8_t bytes[P256_BYTES], const P256Int *a);
+int P256Int_isZero(const P256Int *a);
+
+// Scalars mod n. Operands must be below n except for P256_scalarReduce(),
+// which takes any 256-bit value.
+int P256_scalarIsValid(const P256Int *k);  // 0 < k < n
+void P256_scalarReduce(P256Int *a);
+void P256_scalarAdd(P256Int *r, const P256Int *a, const P256Int *b);
+void P256_scalarMul(P256Int *r, const P256Int *a, const P256Int *b);
+void P256_scalarInvert(P256Int *r, const P256Int *a);
+
+// x coordinate of k·G reduced mod n: the r of an ECDSA signature with
+// nonce k, for a valid scalar k. The work does not depend on k's bits.
+void P256_baseMultiplyX(P256Int *x, const P256Int *k);
+
+#endif /* P256_H */
@@ -0,0 +1,111 @@
+#ifndef RDF_CANON_H
+#define RDF_CANON_H
+
+#include "rdf_graph.h"
+#include "sha256.h"
+
+// RDF Dataset Canonicalization (RDFC-1.0, formerly URDNA2015)
+
+// Scratch size to give RDFCanon_run() on the device. A run takes about 8
+// bytes per quad and 50 per blank node, plus a few hundred bytes per level
+// of Hash N-Degree Quads recursion; RDF_ERR_ARENA_FULL means it was short.
+#ifndef RDFC_SCRATCH_SIZE
+#define RDFC_SCRATCH_SIZE 8192
+#endif
+
+typedef enum {
+    RDFC_PHASE_MAP,           // blank node to quads map
+    RDFC_PHASE_FIRST_DEGREE,  // Hash First Degree Quads for every blank node
+    RDFC_PHASE_UNIQUE,        // label blank nodes with unique hashes
+    RDFC_PHASE_N_DEGREE,      // Hash N-Degree Quads for the rest
+    RDFC_PHASE_OUTPUT,        // relabel and sort the canonical quads
+    RDFC_PHASE_COUNT
+} RDFCanonPhase;
+
+typedef struct {
+    // Optional tick source for per-phase timing (e.g. the DWT cycle counter)
+    uint32_t (*clock)(void);
+    // Upper bound on Hash N-Degree Quads invocations, 0 for no bound. Keeps
+    // crafted graphs with many indistinguishable blank nodes from running
+    // for ever; exceeding it fails with RDF_ERR_LIMIT.
+    uint32_t maxNDegreeCalls;
+} RDFCanonOptions;
+
+typedef struct {
+    uint32_t phaseTicks[RDFC_PHASE_COUNT];
+    uint32_t blankNodes;
+    uint32_t nDegreeCalls;
+    size_t scratchPeak;       // highest scratch offset reached outside of sorting
+} RDFCanonStats;
+
+// Canonical form of a graph. Term ids below labelBase refer to the graph,
+// id labelBase + n is the canonical blank node _:c14n<n>.
+typedef struct {
+    const RDFGraph *graph;
+    const RDFTriple *quads;   // canonical order, duplicates removed
+    int count;
+    RDFTermId labelBase;
+} RDFCanonDataset;
+
+// Canonicalize graph without modifying it. Every allocation, including the
+// quads of the result, comes from scratch, so the whole run is bounded by
+// the scratch size; the result stays valid until scratch is released.
+RDFStatus RDFCanon_run(const RDFGraph *graph, RDFArena *scratch, const RDFCanonOptions *options,
+                       RDFCanonDataset *out, RDFCanonStats *stats);
+
+// Emit the canonical N-Quads document, one sink call per term or separator
+void RDFCanon_writeNQuads(const RDFCanonDataset *dataset, RDFSinkFn sink, void *ctx);
+
+// Canonicalize graph and stream the N-Quads document into sink, so it is
+// never held in memory as a whole. Scratch is released before returning.
+RDFStatus RDFCanon_serialize(const RDFGraph *graph, RDFArena *scratch, const RDFCanonOptions *options,
+                             RDFSinkFn sink, void *ctx);
+
+// Digest states RDFCanonCache keeps along the canonical document; a change
+// is rehashed from the last one before it
+#ifndef RDFC_CACHE_CHECKPOINTS
+#define RDFC_CACHE_CHECKPOINTS 8
+#endif
+
+// Blank nodes whose canonical labels RDFCanonCache remembers. Graphs with
+// more are canonicalized in full on every digest.
+#ifndef RDFC_CACHE_BLANKS
+#define RDFC_CACHE_BLANKS 8
+#endif
+
+typedef struct {
+    SHA256Context hash;       // state before line `line` was absorbed
+    int line;
+} RDFCanonCheckpoint;
+
+// RDFCanonCache "class": the canonical quads of one graph in document
+// order, the blank node labels and digest checkpoints, so that a graph
+// which only had a few triples added, rewritten or truncated is rehashed
+// from the first line that changed instead of canonicalized again. The
+// cache follows the graph's change tracking; RDFC is rerun when triples
+// were reordered, when a change involves a blank node whose label it
+// could move, or when the graph has duplicate triples.
+typedef struct {
+    RDFTriple quads[MAX_TRIPLES];   // blank nodes as RDF_MAX_TERMS + label
+    uint32_t source[MAX_TRIPLES];   // index of the graph triple behind each line
+    int count;
+    RDFTermId blank[RDFC_CACHE_BLANKS];  // label -> graph term id
+    int blankCount;
+    RDFCanonCheckpoint checkpoints[RDFC_CACHE_CHECKPOINTS];
+    int checkpointCount;
+    uint8_t valid;
+    uint8_t reusable;         // lines map one to one onto the graph's triples
+    uint8_t fullRun;          // the last digest ran RDFC
+    uint32_t linesHashed;     // lines the last digest absorbed
+} RDFCanonCache;
+
+// digestSize selects SHA-256 (SHA256_DIGEST_SIZE) or SHA-224 (SHA224_DIGEST_SIZE)
+void RDFCanonCache_init(RDFCanonCache *cache, size_t digestSize);
+
+// Hash of graph's canonical N-Quads document, the same bytes
+// RDFCanon_serialize() produces. Clears the graph's change tracking.
+// Graphs of more than MAX_TRIPLES triples fail with RDF_ERR_GRAPH_FULL.
+RDFStatus RDFCanonCache_digest(RDFCanonCache *cache, RDFGraph *graph, RDFArena *scratch,
+                               const RDFCanonOptions *options, uint8_t *digest);
+
+#endif /* RDF_CANON_H */
@@ -0,0 +1,54 @@
+#ifndef RDF_COLUMNS_H
+#define RDF_COLUMNS_H
+
+#include "rdf_graph.h"
+
+// RDFColumns "class": quads stored column by column, four parallel arrays
+// of term ids carved from one caller-supplied block. A scan that binds
+// only the predicate reads 2 bytes per quad instead of the 8 an
+// RDFTriple takes, and the sort reads each column front to back. Term ids
+// refer to the graph the quads were taken from.
+typedef struct {
+    RDFTermId *subject;
+    RDFTermId *predicate;
+    RDFTermId *object;
+    RDFTermId *graph;           // RDF_NO_TERM for the default graph
+    int size;
+    int capacity;
+} RDFColumns;
+
+// Room for size / 8 quads; block must be aligned for RDFTermId
+void RDFColumns_init(RDFColumns *columns, void *block, size_t size);
+
+RDFStatus RDFColumns_add(RDFColumns *columns, RDFTermId subject, RDFTermId predicate, RDFTermId object,
+                         RDFTermId graphName);
+
+// Replace the quads with the graph's, or write them back to it. Loading
+// fails with RDF_ERR_GRAPH_FULL, storing with the status of
+// RDFGraph_reserve(); either leaves the destination unchanged.
+RDFStatus RDFColumns_load(RDFColumns *columns, const RDFGraph *graph);
+RDFStatus RDFColumns_store(const RDFColumns *columns, RDFGraph *graph);
+
+// Position of the first quad at or after from that matches (subject,
+// predicate, object), where RDF_NO_TERM matches anything; -1 if none does.
+// Iterate with i = RDFColumns_next(c, i + 1, ...).
+int RDFColumns_next(const RDFColumns *columns, int from, RDFTermId subject, RDFTermId predicate, RDFTermId object);
+
+// Sort as RDFGraph_sortQuads() does, on rank keys built from the columns.
+// Fails with RDF_ERR_ARENA_FULL, order unchanged, if scratch lacks the
+// 16 bytes per quad plus 4 per term the keys and ranks take.
+RDFStatus RDFColumns_sort(RDFColumns *columns, int termCount, RDFTermCompare compare, const void *ctx,
+                          RDFArena *scratch, int unique);
+
+// Keep the quads keep() returns non-zero for, in their current order.
+// keep() may rewrite the quad it is given.
+void RDFColumns_filter(RDFColumns *columns, RDFQuadFilter keep, void *ctx);
+
+static inline RDFTriple RDFColumns_quad(const RDFColumns *columns, int index)
+{
+    RDFTriple quad = { columns->subject[index], columns->predicate[index],
+                       columns->object[index], columns->graph[index] };
+    return quad;
+}
+
+#endif /* RDF_COLUMNS_H */
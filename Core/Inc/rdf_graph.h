@@ -0,0 +1,243 @@
+#ifndef RDF_GRAPH_H
+#define RDF_GRAPH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rdf_vocab.h"
+
+// Triples RDFIndex and RDFCanonCache have room for. An RDFGraph itself
+// holds as many as its arena has pages for.
+#ifndef MAX_TRIPLES
+#define MAX_TRIPLES 100
+#endif
+
+// Triples per page of an RDFGraph; a page also holds their change bits in
+// one word, so this is fixed
+#define RDF_TRIPLE_PAGE 32
+
+// Distinct terms (subjects, predicates, objects) one graph can hold.
+#ifndef RDF_MAX_TERMS
+#define RDF_MAX_TERMS 128
+#endif
+
+// Open-addressing table used for interning; must be a power of two
+// and larger than RDF_MAX_TERMS.
+#ifndef RDF_TERM_BUCKETS
+#define RDF_TERM_BUCKETS (2 * RDF_MAX_TERMS)
+#endif
+
+// Default size of the arena handed to RDFGraph_init(). It holds the term
+// strings and the triples, 8 bytes each plus 8 per page of
+// RDF_TRIPLE_PAGE, and must leave 16 bytes per triple plus 4 bytes per
+// term free for RDFGraph_canonicalize(), which otherwise falls back to a
+// slower heap sort.
+#ifndef RDF_ARENA_SIZE
+#define RDF_ARENA_SIZE 5120
+#endif
+
+typedef uint16_t RDFTermId;
+#define RDF_NO_TERM ((RDFTermId)0xFFFF)
+
+typedef enum {
+    RDF_OK = 0,
+    RDF_ERR_GRAPH_FULL,
+    RDF_ERR_TERMS_FULL,
+    RDF_ERR_ARENA_FULL,
+    RDF_ERR_INVALID,
+    RDF_ERR_LIMIT,
+    RDF_ERR_OVERFLOW
+} RDFStatus;
+
+// Term text conventions: "_:label" is a blank node, text starting with '"'
+// is a literal in N-Quads form ("lexical", "lexical"@lang or
+// "lexical"^^<datatype>), anything else is an IRI without angle brackets.
+// An IRI that starts with one of RDFVocab_prefixes is stored as the prefix
+// id and the rest, its suffix; every other term is all suffix.
+typedef enum {
+    RDF_TERM_IRI,
+    RDF_TERM_BLANK,
+    RDF_TERM_LITERAL,           // plain string: "lexical"
+    RDF_TERM_TYPED_LITERAL,     // "lexical"^^<datatype>
+    RDF_TERM_LANG_LITERAL       // "lexical"@lang
+} RDFTermKind;
+
+// RDFTerm: an interned term, decoded once when it is interned. 12 bytes
+// on the device.
+typedef struct {
+    const char *text;           // suffix, NUL-terminated unless interned by reference
+    uint16_t length;            // of the suffix
+    uint8_t kind;               // RDFTermKind
+    uint8_t prefix;             // RDFVocab_prefixes index, RDF_VOCAB_NO_PREFIX if none
+    uint16_t lexicalLength;     // literals: the escaped lexical form between the quotes
+    RDFTermId datatype;         // typed literals: term id of the datatype IRI
+} RDFTerm;
+
+// Bump allocator: allocation is a pointer increment, release is O(1)
+typedef struct {
+    uint8_t *base;
+    size_t capacity;
+    size_t used;
+} RDFArena;
+
+// RDFTriple "class": interned term ids, resolved with RDFGraph_termPrefix()
+// and RDFGraph_termSuffix().
+// The graph name makes it a quad; it is RDF_NO_TERM in the default graph.
+typedef struct {
+    RDFTermId subject;
+    RDFTermId predicate;
+    RDFTermId object;
+    RDFTermId graph;
+} RDFTriple;
+
+// A page of RDFGraph's triple storage
+typedef struct {
+    RDFTriple triples[RDF_TRIPLE_PAGE];
+    uint32_t dirty;                          // bit i: triples[i] was added or rewritten
+} RDFTriplePage;
+
+// Orders two term ids; ctx is whatever the caller passed along
+typedef int (*RDFTermCompare)(const void *ctx, RDFTermId a, RDFTermId b);
+
+// Decides whether RDFGraph_filter() keeps a quad
+typedef int (*RDFQuadFilter)(void *ctx, RDFTriple *quad);
+
+// Terms ranked under some order, see RDFGraph_rankTerms(). Rank 0 is
+// RDF_NO_TERM, which names the default graph.
+typedef struct {
+    const RDFTermId *termOf;    // rank -> term
+    const RDFTermId *rankOf;    // term -> rank
+    int bits;                   // bits a rank takes in a quad key
+} RDFTermRanks;
+
+// Receives serialized output chunk by chunk, e.g. to feed a hash context
+typedef void (*RDFSinkFn)(void *ctx, const char *data, size_t len);
+
+// RDFGraph "class"
+typedef struct {
+    RDFArena arena;                          // owns every term string and triple page
+    RDFTerm terms[RDF_MAX_TERMS];
+    RDFTermId buckets[RDF_TERM_BUCKETS];     // interning hash table
+    int termCount;
+    RDFTriplePage **pages;                   // triple i is pages[i / RDF_TRIPLE_PAGE]
+    int pageCount;
+    int pageSlots;                           // room in pages[]
+    int size;
+    // Change tracking for incremental consumers such as RDFCanonCache, reset
+    // by RDFGraph_clearChanges(): a triple's dirty bit is set once it has
+    // been added or rewritten, reordered once triples were sorted or dropped
+    // out of place, which invalidates every position
+    int reordered;
+    uint32_t version;                        // renewed by init and every change to the triples
+} RDFGraph;
+
+void RDFArena_init(RDFArena *arena, void *buffer, size_t capacity);
+void *RDFArena_alloc(RDFArena *arena, size_t size, size_t align);
+void RDFArena_release(RDFArena *arena, size_t mark);
+
+void RDFGraph_init(RDFGraph *graph, void *arena, size_t arenaSize);
+RDFStatus RDFGraph_reserve(RDFGraph *graph, int count);
+RDFTermId RDFGraph_intern(RDFGraph *graph, const char *str, size_t len);
+RDFTermId RDFGraph_internRef(RDFGraph *graph, const char *str, size_t len);
+RDFTermId RDFGraph_find(const RDFGraph *graph, const char *str, size_t len);
+RDFStatus RDFGraph_addTriple(RDFGraph *graph, const char *subject, const char *predicate, const char *object);
+RDFStatus RDFGraph_addQuad(RDFGraph *graph, const char *subject, const char *predicate, const char *object, const char *graphName);
+RDFStatus RDFGraph_addQuadIds(RDFGraph *graph, RDFTermId subject, RDFTermId predicate, RDFTermId object, RDFTermId graphName);
+RDFStatus RDFGraph_setObject(RDFGraph *graph, int index, const char *object);
+void RDFGraph_truncate(RDFGraph *graph, int size);
+void RDFGraph_clearChanges(RDFGraph *graph);
+int RDFGraph_termEquals(const RDFGraph *graph, RDFTermId id, const char *str, size_t len);
+size_t RDFGraph_copyTerm(const RDFGraph *graph, RDFTermId id, char *out, size_t size);
+int RDFGraph_compareTerms(const void *graph, RDFTermId a, RDFTermId b);
+int RDFGraph_sortQuads(RDFTriple *quads, int count, int termCount, RDFTermCompare compare, const void *ctx, RDFArena *scratch, int unique);
+int RDFGraph_rankTerms(RDFTermRanks *ranks, int termCount, RDFTermCompare compare, const void *ctx, RDFArena *scratch);
+uint64_t *RDFGraph_radixSort(uint64_t *keys, uint64_t *buf, int count, int keyBits);
+void RDFGraph_canonicalize(RDFGraph *graph);
+void RDFGraph_filter(RDFGraph *graph, RDFQuadFilter keep, void *ctx);
+void RDFGraph_free(RDFGraph *graph);
+
+static inline RDFTermKind RDFGraph_termKind(const RDFGraph *graph, RDFTermId id)
+{
+    return (RDFTermKind)graph->terms[id].kind;
+}
+
+static inline int RDFGraph_isLiteral(const RDFGraph *graph, RDFTermId id)
+{
+    return graph->terms[id].kind >= RDF_TERM_LITERAL;
+}
+
+// A term's text is its prefix followed by its suffix. Literals and blank
+// nodes never have a prefix, so their suffix is all of their text.
+static inline const char *RDFGraph_termPrefix(const RDFGraph *graph, RDFTermId id)
+{
+    uint8_t prefix = graph->terms[id].prefix;
+    return prefix == RDF_VOCAB_NO_PREFIX ? "" : RDFVocab_prefixes[prefix].iri;
+}
+
+static inline size_t RDFGraph_termPrefixLength(const RDFGraph *graph, RDFTermId id)
+{
+    uint8_t prefix = graph->terms[id].prefix;
+    return prefix == RDF_VOCAB_NO_PREFIX ? 0 : RDFVocab_prefixes[prefix].length;
+}
+
+static inline const char *RDFGraph_termSuffix(const RDFGraph *graph, RDFTermId id)
+{
+    return graph->terms[id].text;
+}
+
+static inline size_t RDFGraph_termSuffixLength(const RDFGraph *graph, RDFTermId id)
+{
+    return graph->terms[id].length;
+}
+
+// Length of the whole text
+static inline size_t RDFGraph_termLength(const RDFGraph *graph, RDFTermId id)
+{
+    return RDFGraph_termPrefixLength(graph, id) + graph->terms[id].length;
+}
+
+// A literal's lexical form as it is escaped in N-Quads
+static inline const char *RDFGraph_literalLexical(const RDFGraph *graph, RDFTermId id, size_t *len)
+{
+    *len = graph->terms[id].lexicalLength;
+    return graph->terms[id].text + 1;
+}
+
+// Datatype IRI of a typed literal, RDF_NO_TERM for other terms
+static inline RDFTermId RDFGraph_literalDatatype(const RDFGraph *graph, RDFTermId id)
+{
+    return graph->terms[id].kind == RDF_TERM_TYPED_LITERAL ? graph->terms[id].datatype : RDF_NO_TERM;
+}
+
+// Language tag of a literal, empty unless it is language-tagged
+static inline const char *RDFGraph_literalLanguage(const RDFGraph *graph, RDFTermId id, size_t *len)
+{
+    const RDFTerm *term = &graph->terms[id];
+    int tagged = term->kind == RDF_TERM_LANG_LITERAL;
+    *len = tagged ? (size_t)term->length - term->lexicalLength - 3 : 0;
+    return tagged ? term->text + term->lexicalLength + 3 : "";
+}
+
+// A quad as one integer that sorts in (subject, predicate, object, graph)
+// order of the ranks
+static inline uint64_t RDFTermRanks_key(const RDFTermRanks *ranks, RDFTermId subject, RDFTermId predicate,
+                                        RDFTermId object, RDFTermId graphName)
+{
+    int bits = ranks->bits;
+    return ((uint64_t)ranks->rankOf[subject] << (3 * bits))
+         | ((uint64_t)ranks->rankOf[predicate] << (2 * bits))
+         | ((uint64_t)ranks->rankOf[object] << bits)
+         | (graphName == RDF_NO_TERM ? 0 : ranks->rankOf[graphName]);
+}
+
+static inline int RDFGraph_isDirty(const RDFGraph *graph, int index)
+{
+    return (graph->pages[index / RDF_TRIPLE_PAGE]->dirty >> (index % RDF_TRIPLE_PAGE)) & 1u;
+}
+
+static inline const RDFTriple *RDFGraph_triple(const RDFGraph *graph, int index)
+{
+    return &graph->pages[index / RDF_TRIPLE_PAGE]->triples[index % RDF_TRIPLE_PAGE];
+}
+
+#endif /* RDF_GRAPH_H */
@@ -0,0 +1,49 @@
+#ifndef RDF_INDEX_H
+#define RDF_INDEX_H
+
+#include "rdf_graph.h"
+
+// Position of a triple in its RDFGraph
+#if MAX_TRIPLES <= 0xFFFF
+typedef uint16_t RDFTriplePos;
+#else
+typedef uint32_t RDFTriplePos;
+#endif
+
+typedef enum {
+    RDF_INDEX_SPO,            // (subject, predicate, object)
+    RDF_INDEX_POS,            // (predicate, object, subject)
+    RDF_INDEX_OSP,            // (object, subject, predicate)
+    RDF_INDEX_COUNT
+} RDFIndexOrder;
+
+// Triples matching a pattern, as positions into the graph's triples
+typedef struct {
+    const RDFTriplePos *pos;
+    int count;
+} RDFTripleRange;
+
+// RDFIndex "class": the graph's triples sorted by term id in each of three
+// component orders, so that any pattern of bound components is one range.
+// An order is built on the first lookup that needs it, in O(n + terms),
+// and again once the graph has changed; adding and serializing triples
+// never pays for it. Ids sort in interning order, not by their text.
+typedef struct {
+    const RDFGraph *graph;
+    RDFTriplePos order[RDF_INDEX_COUNT][MAX_TRIPLES];
+    uint32_t version[RDF_INDEX_COUNT];   // graph version each order reflects
+    uint8_t built;                       // bit n set: order n has been built
+    RDFTriplePos tmp[MAX_TRIPLES];
+    RDFTriplePos counts[RDF_MAX_TERMS + 1];
+} RDFIndex;
+
+void RDFIndex_init(RDFIndex *index, const RDFGraph *graph);
+
+// Triples matching (subject, predicate, object), where RDF_NO_TERM matches
+// anything, so check ids from RDFGraph_find() before passing them. Graph
+// names are ignored. The range is valid until the graph changes.
+// Graphs of more than MAX_TRIPLES triples are not indexed; their range
+// has count -1.
+RDFTripleRange RDFIndex_match(RDFIndex *index, RDFTermId subject, RDFTermId predicate, RDFTermId object);
+
+#endif /* RDF_INDEX_H */
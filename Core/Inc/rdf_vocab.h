@@ -0,0 +1,304 @@
+/* Generated by Tools/gen_vocab.py from Tools/vocab.txt, do not edit. */
+
+#ifndef RDF_VOCAB_H
+#define RDF_VOCAB_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef enum {
+    RDF_VOCAB_RDF_TYPE = 0,
+    RDF_VOCAB_DC_CREATED = 1,
+    RDF_VOCAB_XSD_DATE_TIME = 2,
+    RDF_VOCAB_XSD_INTEGER = 3,
+    RDF_VOCAB_XSD_DOUBLE = 4,
+    RDF_VOCAB_XSD_BOOLEAN = 5,
+    RDF_VOCAB_SEC_ECDSA_KOBLITZ_SIGNATURE2016 = 6,
+    RDF_VOCAB_SEC_ECDSA_SECP256K1_SIGNATURE2019 = 7,
+    RDF_VOCAB_SEC_ECDSA_SECP256K1_VERIFICATION_KEY2019 = 8,
+    RDF_VOCAB_SEC_ED25519_SIGNATURE2018 = 9,
+    RDF_VOCAB_SEC_ED25519_VERIFICATION_KEY2018 = 10,
+    RDF_VOCAB_SEC_ENCRYPTED_MESSAGE = 11,
+    RDF_VOCAB_SEC_GRAPH_SIGNATURE2012 = 12,
+    RDF_VOCAB_SEC_LINKED_DATA_SIGNATURE2015 = 13,
+    RDF_VOCAB_SEC_LINKED_DATA_SIGNATURE2016 = 14,
+    RDF_VOCAB_SEC_RSA_SIGNATURE2018 = 15,
+    RDF_VOCAB_SEC_RSA_VERIFICATION_KEY2018 = 16,
+    RDF_VOCAB_SEC_SCHNORR_SECP256K1_SIGNATURE2019 = 17,
+    RDF_VOCAB_SEC_SCHNORR_SECP256K1_VERIFICATION_KEY2019 = 18,
+    RDF_VOCAB_SEC_CRYPTOGRAPHIC_KEY = 19,
+    RDF_VOCAB_SEC_ALLOWED_ACTION = 20,
+    RDF_VOCAB_SEC_ASSERTION_METHOD = 21,
+    RDF_VOCAB_SEC_AUTHENTICATION = 22,
+    RDF_VOCAB_SEC_AUTHENTICATION_TAG = 23,
+    RDF_VOCAB_SEC_CANONICALIZATION_ALGORITHM = 24,
+    RDF_VOCAB_SEC_CAPABILITY = 25,
+    RDF_VOCAB_SEC_CAPABILITY_ACTION = 26,
+    RDF_VOCAB_SEC_CAPABILITY_CHAIN = 27,
+    RDF_VOCAB_SEC_CAPABILITY_DELEGATION = 28,
+    RDF_VOCAB_SEC_CAPABILITY_INVOCATION = 29,
+    RDF_VOCAB_SEC_CAVEAT = 30,
+    RDF_VOCAB_SEC_CHALLENGE = 31,
+    RDF_VOCAB_SEC_CIPHER_ALGORITHM = 32,
+    RDF_VOCAB_SEC_CIPHER_DATA = 33,
+    RDF_VOCAB_SEC_CIPHER_KEY = 34,
+    RDF_VOCAB_SEC_CIPHERTEXT = 35,
+    RDF_VOCAB_SEC_CONTROLLER = 36,
+    RDF_VOCAB_SEC_CREATOR = 37,
+    RDF_VOCAB_SEC_DELEGATOR = 38,
+    RDF_VOCAB_SEC_DIGEST_ALGORITHM = 39,
+    RDF_VOCAB_SEC_DIGEST_VALUE = 40,
+    RDF_VOCAB_SEC_DOMAIN = 41,
+    RDF_VOCAB_SEC_ENCRYPTION_KEY = 42,
+    RDF_VOCAB_SEC_EXPIRATION = 43,
+    RDF_VOCAB_SEC_EXPIRES = 44,
+    RDF_VOCAB_SEC_INITIALIZATION_VECTOR = 45,
+    RDF_VOCAB_SEC_INVOCATION_TARGET = 46,
+    RDF_VOCAB_SEC_INVOKER = 47,
+    RDF_VOCAB_SEC_ITERATION_COUNT = 48,
+    RDF_VOCAB_SEC_JWS = 49,
+    RDF_VOCAB_SEC_KEY_AGREEMENT = 50,
+    RDF_VOCAB_SEC_NONCE = 51,
+    RDF_VOCAB_SEC_NORMALIZATION_ALGORITHM = 52,
+    RDF_VOCAB_SEC_OWNER = 53,
+    RDF_VOCAB_SEC_PARENT_CAPABILITY = 54,
+    RDF_VOCAB_SEC_PASSWORD = 55,
+    RDF_VOCAB_SEC_PLAINTEXT = 56,
+    RDF_VOCAB_SEC_PRIVATE_KEY = 57,
+    RDF_VOCAB_SEC_PRIVATE_KEY_PEM = 58,
+    RDF_VOCAB_SEC_PROOF = 59,
+    RDF_VOCAB_SEC_PROOF_PURPOSE = 60,
+    RDF_VOCAB_SEC_PROOF_VALUE = 61,
+    RDF_VOCAB_SEC_PUBLIC_KEY = 62,
+    RDF_VOCAB_SEC_PUBLIC_KEY_BASE58 = 63,
+    RDF_VOCAB_SEC_PUBLIC_KEY_PEM = 64,
+    RDF_VOCAB_SEC_PUBLIC_KEY_WIF = 65,
+    RDF_VOCAB_SEC_REVOKED = 66,
+    RDF_VOCAB_SEC_SALT = 67,
+    RDF_VOCAB_SEC_SIGNATURE = 68,
+    RDF_VOCAB_SEC_SIGNATURE_ALGORITHM = 69,
+    RDF_VOCAB_SEC_SIGNATURE_VALUE = 70,
+    RDF_VOCAB_SEC_VERIFICATION_METHOD = 71,
+    RDF_VOCAB_SEC_VERIFY_DATA = 72,
+    RDF_VOCAB_SEC_ECDSA_SIGNATURE2018 = 73,
+    RDF_VOCAB_SEC_ED25519_SIGNATURE2020 = 74,
+    RDF_VOCAB_CRED_VERIFIABLE_CREDENTIAL = 75,
+    RDF_VOCAB_CRED_VERIFIABLE_PRESENTATION = 76,
+    RDF_VOCAB_CRED_CREDENTIAL_SUBJECT = 77,
+    RDF_VOCAB_CRED_CREDENTIAL_STATUS = 78,
+    RDF_VOCAB_CRED_CREDENTIAL_SCHEMA = 79,
+    RDF_VOCAB_CRED_EVIDENCE = 80,
+    RDF_VOCAB_CRED_EXPIRATION_DATE = 81,
+    RDF_VOCAB_CRED_HOLDER = 82,
+    RDF_VOCAB_CRED_ISSUANCE_DATE = 83,
+    RDF_VOCAB_CRED_ISSUER = 84,
+    RDF_VOCAB_CRED_REFRESH_SERVICE = 85,
+    RDF_VOCAB_CRED_TERMS_OF_USE = 86,
+    RDF_VOCAB_CRED_VERIFIABLE_CREDENTIAL_PROPERTY = 87,
+    RDF_VOCAB_SCHEMA_PERSON = 88,
+    RDF_VOCAB_SCHEMA_ORGANIZATION = 89,
+    RDF_VOCAB_SCHEMA_PLACE = 90,
+    RDF_VOCAB_SCHEMA_POSTAL_ADDRESS = 91,
+    RDF_VOCAB_SCHEMA_THING = 92,
+    RDF_VOCAB_SCHEMA_NAME = 93,
+    RDF_VOCAB_SCHEMA_DESCRIPTION = 94,
+    RDF_VOCAB_SCHEMA_IDENTIFIER = 95,
+    RDF_VOCAB_SCHEMA_URL = 96,
+    RDF_VOCAB_SCHEMA_IMAGE = 97,
+    RDF_VOCAB_SCHEMA_EMAIL = 98,
+    RDF_VOCAB_SCHEMA_TELEPHONE = 99,
+    RDF_VOCAB_SCHEMA_GIVEN_NAME = 100,
+    RDF_VOCAB_SCHEMA_FAMILY_NAME = 101,
+    RDF_VOCAB_SCHEMA_ADDITIONAL_NAME = 102,
+    RDF_VOCAB_SCHEMA_BIRTH_DATE = 103,
+    RDF_VOCAB_SCHEMA_GENDER = 104,
+    RDF_VOCAB_SCHEMA_NATIONALITY = 105,
+    RDF_VOCAB_SCHEMA_ADDRESS = 106,
+    RDF_VOCAB_SCHEMA_ADDRESS_COUNTRY = 107,
+    RDF_VOCAB_SCHEMA_ADDRESS_LOCALITY = 108,
+    RDF_VOCAB_SCHEMA_ADDRESS_REGION = 109,
+    RDF_VOCAB_SCHEMA_POSTAL_CODE = 110,
+    RDF_VOCAB_SCHEMA_STREET_ADDRESS = 111,
+    RDF_VOCAB_SCHEMA_ALUMNI_OF = 112,
+    RDF_VOCAB_SCHEMA_AFFILIATION = 113,
+    RDF_VOCAB_SCHEMA_MEMBER_OF = 114,
+    RDF_VOCAB_SCHEMA_JOB_TITLE = 115,
+    RDF_VOCAB_SCHEMA_WORKS_FOR = 116,
+    RDF_VOCAB_SCHEMA_HAS_CREDENTIAL = 117,
+    RDF_VOCAB_SCHEMA_DATE_CREATED = 118,
+    RDF_VOCAB_SCHEMA_DATE_MODIFIED = 119,
+    RDF_VOCAB_SCHEMA_DATE_PUBLISHED = 120,
+    RDF_VOCAB_SCHEMA_VALID_FROM = 121,
+    RDF_VOCAB_SCHEMA_VALID_THROUGH = 122,
+    RDF_VOCAB_COUNT = 123,
+    RDF_VOCAB_NONE = RDF_VOCAB_COUNT
+} RDFVocabTerm;
+
+#define RDF_VOCAB_PREFIX_COUNT 8
+#define RDF_VOCAB_NO_PREFIX 0xFF
+
+#define RDF_IRI_RDF_TYPE "http://www.w3.org/1999/02/22-rdf-syntax-ns#type"
+#define RDF_IRI_DC_CREATED "http://purl.org/dc/terms/created"
+#define RDF_IRI_XSD_DATE_TIME "http://www.w3.org/2001/XMLSchema#dateTime"
+#define RDF_IRI_XSD_INTEGER "http://www.w3.org/2001/XMLSchema#integer"
+#define RDF_IRI_XSD_DOUBLE "http://www.w3.org/2001/XMLSchema#double"
+#define RDF_IRI_XSD_BOOLEAN "http://www.w3.org/2001/XMLSchema#boolean"
+#define RDF_IRI_SEC_ECDSA_KOBLITZ_SIGNATURE2016 "https://w3id.org/security#EcdsaKoblitzSignature2016"
+#define RDF_IRI_SEC_ECDSA_SECP256K1_SIGNATURE2019 "https://w3id.org/security#EcdsaSecp256k1Signature2019"
+#define RDF_IRI_SEC_ECDSA_SECP256K1_VERIFICATION_KEY2019 "https://w3id.org/security#EcdsaSecp256k1VerificationKey2019"
+#define RDF_IRI_SEC_ED25519_SIGNATURE2018 "https://w3id.org/security#Ed25519Signature2018"
+#define RDF_IRI_SEC_ED25519_VERIFICATION_KEY2018 "https://w3id.org/security#Ed25519VerificationKey2018"
+#define RDF_IRI_SEC_ENCRYPTED_MESSAGE "https://w3id.org/security#EncryptedMessage"
+#define RDF_IRI_SEC_GRAPH_SIGNATURE2012 "https://w3id.org/security#GraphSignature2012"
+#define RDF_IRI_SEC_LINKED_DATA_SIGNATURE2015 "https://w3id.org/security#LinkedDataSignature2015"
+#define RDF_IRI_SEC_LINKED_DATA_SIGNATURE2016 "https://w3id.org/security#LinkedDataSignature2016"
+#define RDF_IRI_SEC_RSA_SIGNATURE2018 "https://w3id.org/security#RsaSignature2018"
+#define RDF_IRI_SEC_RSA_VERIFICATION_KEY2018 "https://w3id.org/security#RsaVerificationKey2018"
+#define RDF_IRI_SEC_SCHNORR_SECP256K1_SIGNATURE2019 "https://w3id.org/security#SchnorrSecp256k1Signature2019"
+#define RDF_IRI_SEC_SCHNORR_SECP256K1_VERIFICATION_KEY2019 "https://w3id.org/security#SchnorrSecp256k1VerificationKey2019"
+#define RDF_IRI_SEC_CRYPTOGRAPHIC_KEY "https://w3id.org/security#CryptographicKey"
+#define RDF_IRI_SEC_ALLOWED_ACTION "https://w3id.org/security#allowedAction"
+#define RDF_IRI_SEC_ASSERTION_METHOD "https://w3id.org/security#assertionMethod"
+#define RDF_IRI_SEC_AUTHENTICATION "https://w3id.org/security#authentication"
+#define RDF_IRI_SEC_AUTHENTICATION_TAG "https://w3id.org/security#authenticationTag"
+#define RDF_IRI_SEC_CANONICALIZATION_ALGORITHM "https://w3id.org/security#canonicalizationAlgorithm"
+#define RDF_IRI_SEC_CAPABILITY "https://w3id.org/security#capability"
+#define RDF_IRI_SEC_CAPABILITY_ACTION "https://w3id.org/security#capabilityAction"
+#define RDF_IRI_SEC_CAPABILITY_CHAIN "https://w3id.org/security#capabilityChain"
+#define RDF_IRI_SEC_CAPABILITY_DELEGATION "https://w3id.org/security#capabilityDelegation"
+#define RDF_IRI_SEC_CAPABILITY_INVOCATION "https://w3id.org/security#capabilityInvocation"
+#define RDF_IRI_SEC_CAVEAT "https://w3id.org/security#caveat"
+#define RDF_IRI_SEC_CHALLENGE "https://w3id.org/security#challenge"
+#define RDF_IRI_SEC_CIPHER_ALGORITHM "https://w3id.org/security#cipherAlgorithm"
+#define RDF_IRI_SEC_CIPHER_DATA "https://w3id.org/security#cipherData"
+#define RDF_IRI_SEC_CIPHER_KEY "https://w3id.org/security#cipherKey"
+#define RDF_IRI_SEC_CIPHERTEXT "https://w3id.org/security#ciphertext"
+#define RDF_IRI_SEC_CONTROLLER "https://w3id.org/security#controller"
+#define RDF_IRI_SEC_CREATOR "https://w3id.org/security#creator"
+#define RDF_IRI_SEC_DELEGATOR "https://w3id.org/security#delegator"
+#define RDF_IRI_SEC_DIGEST_ALGORITHM "https://w3id.org/security#digestAlgorithm"
+#define RDF_IRI_SEC_DIGEST_VALUE "https://w3id.org/security#digestValue"
+#define RDF_IRI_SEC_DOMAIN "https://w3id.org/security#domain"
+#define RDF_IRI_SEC_ENCRYPTION_KEY "https://w3id.org/security#encryptionKey"
+#define RDF_IRI_SEC_EXPIRATION "https://w3id.org/security#expiration"
+#define RDF_IRI_SEC_EXPIRES "https://w3id.org/security#expires"
+#define RDF_IRI_SEC_INITIALIZATION_VECTOR "https://w3id.org/security#initializationVector"
+#define RDF_IRI_SEC_INVOCATION_TARGET "https://w3id.org/security#invocationTarget"
+#define RDF_IRI_SEC_INVOKER "https://w3id.org/security#invoker"
+#define RDF_IRI_SEC_ITERATION_COUNT "https://w3id.org/security#iterationCount"
+#define RDF_IRI_SEC_JWS "https://w3id.org/security#jws"
+#define RDF_IRI_SEC_KEY_AGREEMENT "https://w3id.org/security#keyAgreement"
+#define RDF_IRI_SEC_NONCE "https://w3id.org/security#nonce"
+#define RDF_IRI_SEC_NORMALIZATION_ALGORITHM "https://w3id.org/security#normalizationAlgorithm"
+#define RDF_IRI_SEC_OWNER "https://w3id.org/security#owner"
+#define RDF_IRI_SEC_PARENT_CAPABILITY "https://w3id.org/security#parentCapability"
+#define RDF_IRI_SEC_PASSWORD "https://w3id.org/security#password"
+#define RDF_IRI_SEC_PLAINTEXT "https://w3id.org/security#plaintext"
+#define RDF_IRI_SEC_PRIVATE_KEY "https://w3id.org/security#privateKey"
+#define RDF_IRI_SEC_PRIVATE_KEY_PEM "https://w3id.org/security#privateKeyPem"
+#define RDF_IRI_SEC_PROOF "https://w3id.org/security#proof"
+#define RDF_IRI_SEC_PROOF_PURPOSE "https://w3id.org/security#proofPurpose"
+#define RDF_IRI_SEC_PROOF_VALUE "https://w3id.org/security#proofValue"
+#define RDF_IRI_SEC_PUBLIC_KEY "https://w3id.org/security#publicKey"
+#define RDF_IRI_SEC_PUBLIC_KEY_BASE58 "https://w3id.org/security#publicKeyBase58"
+#define RDF_IRI_SEC_PUBLIC_KEY_PEM "https://w3id.org/security#publicKeyPem"
+#define RDF_IRI_SEC_PUBLIC_KEY_WIF "https://w3id.org/security#publicKeyWif"
+#define RDF_IRI_SEC_REVOKED "https://w3id.org/security#revoked"
+#define RDF_IRI_SEC_SALT "https://w3id.org/security#salt"
+#define RDF_IRI_SEC_SIGNATURE "https://w3id.org/security#signature"
+#define RDF_IRI_SEC_SIGNATURE_ALGORITHM "https://w3id.org/security#signatureAlgorithm"
+#define RDF_IRI_SEC_SIGNATURE_VALUE "https://w3id.org/security#signatureValue"
+#define RDF_IRI_SEC_VERIFICATION_METHOD "https://w3id.org/security#verificationMethod"
+#define RDF_IRI_SEC_VERIFY_DATA "https://w3id.org/security#verifyData"
+#define RDF_IRI_SEC_ECDSA_SIGNATURE2018 "https://w3id.org/security#EcdsaSignature2018"
+#define RDF_IRI_SEC_ED25519_SIGNATURE2020 "https://w3id.org/security#Ed25519Signature2020"
+#define RDF_IRI_CRED_VERIFIABLE_CREDENTIAL "https://www.w3.org/2018/credentials#VerifiableCredential"
+#define RDF_IRI_CRED_VERIFIABLE_PRESENTATION "https://www.w3.org/2018/credentials#VerifiablePresentation"
+#define RDF_IRI_CRED_CREDENTIAL_SUBJECT "https://www.w3.org/2018/credentials#credentialSubject"
+#define RDF_IRI_CRED_CREDENTIAL_STATUS "https://www.w3.org/2018/credentials#credentialStatus"
+#define RDF_IRI_CRED_CREDENTIAL_SCHEMA "https://www.w3.org/2018/credentials#credentialSchema"
+#define RDF_IRI_CRED_EVIDENCE "https://www.w3.org/2018/credentials#evidence"
+#define RDF_IRI_CRED_EXPIRATION_DATE "https://www.w3.org/2018/credentials#expirationDate"
+#define RDF_IRI_CRED_HOLDER "https://www.w3.org/2018/credentials#holder"
+#define RDF_IRI_CRED_ISSUANCE_DATE "https://www.w3.org/2018/credentials#issuanceDate"
+#define RDF_IRI_CRED_ISSUER "https://www.w3.org/2018/credentials#issuer"
+#define RDF_IRI_CRED_REFRESH_SERVICE "https://www.w3.org/2018/credentials#refreshService"
+#define RDF_IRI_CRED_TERMS_OF_USE "https://www.w3.org/2018/credentials#termsOfUse"
+#define RDF_IRI_CRED_VERIFIABLE_CREDENTIAL_PROPERTY "https://www.w3.org/2018/credentials#verifiableCredential"
+#define RDF_IRI_SCHEMA_PERSON "http://schema.org/Person"
+#define RDF_IRI_SCHEMA_ORGANIZATION "http://schema.org/Organization"
+#define RDF_IRI_SCHEMA_PLACE "http://schema.org/Place"
+#define RDF_IRI_SCHEMA_POSTAL_ADDRESS "http://schema.org/PostalAddress"
+#define RDF_IRI_SCHEMA_THING "http://schema.org/Thing"
+#define RDF_IRI_SCHEMA_NAME "http://schema.org/name"
+#define RDF_IRI_SCHEMA_DESCRIPTION "http://schema.org/description"
+#define RDF_IRI_SCHEMA_IDENTIFIER "http://schema.org/identifier"
+#define RDF_IRI_SCHEMA_URL "http://schema.org/url"
+#define RDF_IRI_SCHEMA_IMAGE "http://schema.org/image"
+#define RDF_IRI_SCHEMA_EMAIL "http://schema.org/email"
+#define RDF_IRI_SCHEMA_TELEPHONE "http://schema.org/telephone"
+#define RDF_IRI_SCHEMA_GIVEN_NAME "http://schema.org/givenName"
+#define RDF_IRI_SCHEMA_FAMILY_NAME "http://schema.org/familyName"
+#define RDF_IRI_SCHEMA_ADDITIONAL_NAME "http://schema.org/additionalName"
+#define RDF_IRI_SCHEMA_BIRTH_DATE "http://schema.org/birthDate"
+#define RDF_IRI_SCHEMA_GENDER "http://schema.org/gender"
+#define RDF_IRI_SCHEMA_NATIONALITY "http://schema.org/nationality"
+#define RDF_IRI_SCHEMA_ADDRESS "http://schema.org/address"
+#define RDF_IRI_SCHEMA_ADDRESS_COUNTRY "http://schema.org/addressCountry"
+#define RDF_IRI_SCHEMA_ADDRESS_LOCALITY "http://schema.org/addressLocality"
+#define RDF_IRI_SCHEMA_ADDRESS_REGION "http://schema.org/addressRegion"
+#define RDF_IRI_SCHEMA_POSTAL_CODE "http://schema.org/postalCode"
+#define RDF_IRI_SCHEMA_STREET_ADDRESS "http://schema.org/streetAddress"
+#define RDF_IRI_SCHEMA_ALUMNI_OF "http://schema.org/alumniOf"
+#define RDF_IRI_SCHEMA_AFFILIATION "http://schema.org/affiliation"
+#define RDF_IRI_SCHEMA_MEMBER_OF "http://schema.org/memberOf"
+#define RDF_IRI_SCHEMA_JOB_TITLE "http://schema.org/jobTitle"
+#define RDF_IRI_SCHEMA_WORKS_FOR "http://schema.org/worksFor"
+#define RDF_IRI_SCHEMA_HAS_CREDENTIAL "http://schema.org/hasCredential"
+#define RDF_IRI_SCHEMA_DATE_CREATED "http://schema.org/dateCreated"
+#define RDF_IRI_SCHEMA_DATE_MODIFIED "http://schema.org/dateModified"
+#define RDF_IRI_SCHEMA_DATE_PUBLISHED "http://schema.org/datePublished"
+#define RDF_IRI_SCHEMA_VALID_FROM "http://schema.org/validFrom"
+#define RDF_IRI_SCHEMA_VALID_THROUGH "http://schema.org/validThrough"
+
+typedef struct {
+    const char *iri;
+    uint8_t length;
+} RDFVocabPrefix;
+
+// The expanded IRI is the prefix's namespace followed by the term's local
+// name, which is also its compact form
+typedef struct {
+    const char *iri;
+    uint8_t length;
+    uint8_t nameLength;
+    uint8_t prefix;
+} RDFVocabEntry;
+
+extern const RDFVocabPrefix RDFVocab_prefixes[RDF_VOCAB_PREFIX_COUNT];
+extern const RDFVocabEntry RDFVocab_terms[RDF_VOCAB_COUNT];
+
+// How IRIs starting with prefixes a != b compare: -1 or 1 when the
+// prefixes alone decide, 0 when one prefix starts with the other
+extern const int8_t RDFVocab_prefixOrder[RDF_VOCAB_PREFIX_COUNT][RDF_VOCAB_PREFIX_COUNT];
+
+// Return the term with this expanded IRI or compact name, RDF_VOCAB_NONE
+// if there is none
+RDFVocabTerm RDFVocab_lookupIRI(const char *iri, size_t len);
+RDFVocabTerm RDFVocab_lookupCompact(const char *name, size_t len);
+
+// Index of the longest prefix iri[0..len) starts with, RDF_VOCAB_NO_PREFIX
+// if it starts with none
+uint8_t RDFVocab_matchPrefix(const char *iri, size_t len);
+
+static inline const char *RDFVocab_iri(RDFVocabTerm term)
+{
+    return RDFVocab_terms[term].iri;
+}
+
+static inline const char *RDFVocab_compact(RDFVocabTerm term)
+{
+    return RDFVocab_terms[term].iri + RDFVocab_terms[term].length - RDFVocab_terms[term].nameLength;
+}
+
+#endif /* RDF_VOCAB_H */
@@ -0,0 +1,43 @@
+#ifndef SHA256_H
+#define SHA256_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define SHA256_DIGEST_SIZE 32
+#define SHA224_DIGEST_SIZE 28
+#define SHA256_BLOCK_SIZE  64
+
+// Incremental SHA-256 / SHA-224 context; plain data, safe to copy
+typedef struct {
+    uint32_t state[8];
+    uint64_t length;                   // bytes absorbed so far
+    uint8_t block[SHA256_BLOCK_SIZE];  // pending partial block
+    uint8_t digestSize;                // 32 for SHA-256, 28 for SHA-224
+} SHA256Context;
+
+// Compression state after a whole number of blocks, such as those of a
+// constant prefix; resuming from it skips hashing them again. Plain data,
+// a third the size of a context, fit to keep in RAM or flash.
+typedef struct {
+    uint32_t state[8];
+    uint32_t length;                   // bytes absorbed, whole blocks only
+    uint8_t digestSize;
+} SHA256Midstate;
+
+void SHA256_init(SHA256Context *ctx);
+void SHA224_init(SHA256Context *ctx);
+void SHA256_update(SHA256Context *ctx, const void *data, size_t len);
+void SHA256_final(SHA256Context *ctx, uint8_t *digest);
+
+// Snapshot ctx as of its last whole block. The ctx->length % 64 bytes of
+// the pending block are not kept: they are fed again after resuming.
+void SHA256_saveMidstate(const SHA256Context *ctx, SHA256Midstate *mid);
+
+// Start ctx from mid, as if its mid->length bytes had just been absorbed
+void SHA256_resume(SHA256Context *ctx, const SHA256Midstate *mid);
+
+// One-shot SHA-256
+void SHA256_compute(const void *data, size_t len, uint8_t digest[SHA256_DIGEST_SIZE]);
+
+#endif /* SHA256_H */
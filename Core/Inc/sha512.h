@@ -0,0 +1,27 @@
+#ifndef SHA512_H
+#define SHA512_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define SHA512_DIGEST_SIZE 64
+#define SHA512_BLOCK_SIZE  128
+
+// Incremental SHA-512 context; plain data, safe to copy. The state is
+// kept as 32-bit halves, high word first, which is how the M4 computes
+// it: the Cortex-M4 has no 64-bit registers, and its rotations and
+// additions are done half by half anyway.
+typedef struct {
+    uint32_t state[16];
+    uint64_t length;                   // bytes absorbed so far
+    uint8_t block[SHA512_BLOCK_SIZE];  // pending partial block
+} SHA512Context;
+
+void SHA512_init(SHA512Context *ctx);
+void SHA512_update(SHA512Context *ctx, const void *data, size_t len);
+void SHA512_final(SHA512Context *ctx, uint8_t digest[SHA512_DIGEST_SIZE]);
+
+// One-shot SHA-512
+void SHA512_compute(const void *data, size_t len, uint8_t digest[SHA512_DIGEST_SIZE]);
+
+#endif /* SHA512_H */
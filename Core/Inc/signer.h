@@ -0,0 +1,86 @@
+#ifndef SIGNER_H
+#define SIGNER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "cmox_crypto.h"
+#include "p256.h"
+
+// Working memory of the cmox ECC context
+#ifndef SIGNER_WORKING_SIZE
+#define SIGNER_WORKING_SIZE 2000
+#endif
+
+// Curve parameters of every operation. CMOX_ECC_SECP256R1_HIGHMEM is
+// faster with a larger SIGNER_WORKING_SIZE.
+#ifndef SIGNER_CURVE
+#define SIGNER_CURVE CMOX_ECC_CURVE_SECP256R1
+#endif
+
+// Pre-signatures kept ready, 96 bytes each
+#ifndef SIGNER_PRESIGN_POOL
+#define SIGNER_PRESIGN_POOL 8
+#endif
+
+// The message-independent half of an ECDSA signature with nonce k:
+// r = x(k·G) mod n, k^-1 and k^-1·r·d. Signing a digest e is then
+// s = k^-1·e + k^-1·r·d, two modular multiplications.
+typedef struct {
+    P256Int r;
+    P256Int kInverse;
+    P256Int kInverseRD;
+} SignerPresign;
+
+// Signer "class": an ECDSA P-256 key pair with the cmox context and
+// working buffer that sign and verify with it. Everything is set up once
+// at boot; each call then only runs the curve arithmetic. The context
+// uses one set of math functions and curve parameters for key generation,
+// signing and verification alike.
+//
+// Nonces come from an HMAC-SHA256 DRBG (SP 800-90A) keyed with the private
+// key and whatever entropy the caller mixes in; the F401 has no RNG. While
+// idle, Signer_presign() spends them on the pool, which Signer_sign() then
+// takes from. Each pre-signature is used once and wiped.
+typedef struct {
+    cmox_ecc_handle_t ecc;
+    uint8_t working[SIGNER_WORKING_SIZE];
+    uint8_t privateKey[CMOX_ECC_SECP256R1_PRIVKEY_LEN];
+    uint8_t publicKey[CMOX_ECC_SECP256R1_PUBKEY_LEN];
+    uint8_t drbgKey[32];
+    uint8_t drbgValue[32];
+    SignerPresign presign[SIGNER_PRESIGN_POOL];
+    int presignCount;
+    uint32_t cycles;            // DWT cycles the last call took
+} Signer;
+
+// Construct the context and derive the key pair from seed, at least 32
+// random bytes, and seed the nonce DRBG. Also starts the DWT cycle counter.
+cmox_ecc_retval_t Signer_init(Signer *signer, const uint8_t *seed, size_t seedLength);
+
+// Mix data into the nonce DRBG: clock jitter, input timing, the RTC. It
+// need not be secret, only different from one boot to the next.
+void Signer_addEntropy(Signer *signer, const void *data, size_t length);
+
+// Compute one pre-signature if the pool has room; 1 when one was added.
+// About as costly as a signature, meant for idle time.
+int Signer_presign(Signer *signer);
+
+// Pre-signatures ready for use
+int Signer_presignCount(const Signer *signer);
+
+// Sign digest with the signer's private key, from the pool when it holds
+// a pre-signature and with cmox and a fresh DRBG nonce otherwise
+cmox_ecc_retval_t Signer_sign(Signer *signer, const uint8_t *digest, size_t digestLength,
+                              uint8_t signature[CMOX_ECC_SECP256R1_SIG_LEN]);
+
+// Check signature over digest against publicKey, or the signer's own key
+// when it is NULL. CMOX_ECC_AUTH_SUCCESS only when cmox's fault check
+// agrees, CMOX_ECC_AUTH_FAIL otherwise.
+cmox_ecc_retval_t Signer_verify(Signer *signer, const uint8_t *publicKey, const uint8_t *digest, size_t digestLength,
+                                const uint8_t signature[CMOX_ECC_SECP256R1_SIG_LEN]);
+
+// Release the context and wipe the private key, DRBG and pool
+void Signer_free(Signer *signer);
+
+#endif /* SIGNER_H */
@@ -0,0 +1,1728 @@
+/*
+ * Micro-benchmarks for the credential pipeline.
+ *
+ * On the board, build with -DCREDSIGN_BENCH and press 3 at the prompt;
+ * ticks are DWT cycle counts. On a host, build with -DBENCH_HOST, e.g.
+ *
+ *   gcc -O2 -DBENCH_HOST -DMAX_TRIPLES=100000 -DRDF_MAX_TERMS=32768 \
+ *       -DRDF_ARENA_SIZE=8388608 -ICore/Inc \
+ *       Core/Src/bench.c Core/Src/rdf_graph.c Core/Src/rdf_canon.c \
+ *       Core/Src/sha256.c Core/Src/jsonld_writer.c Core/Src/rdf_vocab.c \
+ *       Core/Src/json_parser.c Core/Src/jsonld_reader.c Core/Src/rdf_index.c \
+ *       Core/Src/rdf_columns.c Core/Src/jsonld_context.c \
+ *       Core/Src/jsonld_context_tables.c Core/Src/nquads_reader.c \
+ *       Core/Src/json_canon.c Core/Src/credential_template.c \
+ *       Core/Src/credential_template_tables.c Core/Src/p256.c \
+ *       Core/Src/monocypher.c Core/Src/sha512.c Core/Src/ed25519.c \
+ *       Core/Src/multibase.c -lm -o bench
+ *
+ * and ticks are nanoseconds. The host build also runs RDFC-1.0 test
+ * vectors (the *-in.nq / *-rdfc10.nq pairs of w3c/rdf-canon):
+ *
+ *   ./bench rdfc test001-in.nq test001-rdfc10.nq ...
+ */
+
+#if defined(CREDSIGN_BENCH) || defined(BENCH_HOST)
+
+#include "bench.h"
+#include "credential_template.h"
+#include "ed25519.h"
+#include "json_canon.h"
+#include "json_parser.h"
+#include "jsonld_reader.h"
+#include "jsonld_writer.h"
+#include "monocypher.h"
+#include "nquads_reader.h"
+#include "p256.h"
+#include "rdf_canon.h"
+#include "rdf_columns.h"
+#include "rdf_graph.h"
+#include "rdf_index.h"
+#include "rdf_vocab.h"
+#include "sha256.h"
+#include "sha512.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef BENCH_HOST
+#include <time.h>
+#else
+#include "main.h"
+#include "signer.h"
+#endif
+
+#define BENCH_REPEAT 5
+
+void Bench_init(void)
+{
+#ifndef BENCH_HOST
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+}
+
+uint64_t Bench_ticks(void)
+{
+#ifdef BENCH_HOST
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+#else
+    return DWT->CYCCNT;
+#endif
+}
+
+const char *Bench_tickUnit(void)
+{
+#ifdef BENCH_HOST
+    return "ns";
+#else
+    return "cycles";
+#endif
+}
+
+static uint32_t benchRandom(uint32_t *state)
+{
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *state = x;
+}
+
+#ifdef BENCH_HOST
+#define BENCH_SCRATCH_SIZE RDF_ARENA_SIZE
+#else
+#define BENCH_SCRATCH_SIZE RDFC_SCRATCH_SIZE
+#endif
+
+static uint8_t benchScratch[BENCH_SCRATCH_SIZE];
+
+/* Canonical sort ------------------------------------------------------------*/
+
+// The string-comparing sort RDFGraph_canonicalize() used to run
+typedef struct {
+    const char *subject;
+    const char *predicate;
+    const char *object;
+} LegacyTriple;
+
+static int compareLegacyTriples(const void *a, const void *b)
+{
+    const LegacyTriple *tripleA = (const LegacyTriple *)a;
+    const LegacyTriple *tripleB = (const LegacyTriple *)b;
+    int subjectCmp = strcmp(tripleA->subject, tripleB->subject);
+    if (subjectCmp != 0) return subjectCmp;
+    int predicateCmp = strcmp(tripleA->predicate, tripleB->predicate);
+    if (predicateCmp != 0) return predicateCmp;
+    return strcmp(tripleA->object, tripleB->object);
+}
+
+static RDFGraph benchGraph;
+static uint8_t benchArena[RDF_ARENA_SIZE];
+static RDFTriple unsortedTriples[MAX_TRIPLES];
+static LegacyTriple legacyUnsorted[MAX_TRIPLES];
+static LegacyTriple legacyTriples[MAX_TRIPLES];
+static const char *legacyTerms[RDF_MAX_TERMS];
+
+static size_t legacyTextSize(void)
+{
+    size_t size = 0;
+    for (int id = 0; id < benchGraph.termCount; id++) size += RDFGraph_termLength(&benchGraph, (RDFTermId)id) + 1;
+    return size;
+}
+
+// Term text the graph stores, which shares its arena with the triples
+static size_t storedTextSize(void)
+{
+    size_t size = 0;
+    for (int id = 0; id < benchGraph.termCount; id++) size += RDFGraph_termSuffixLength(&benchGraph, (RDFTermId)id) + 1;
+    return size;
+}
+
+// Every term as N-Quads writes it, which the graph keeps split into
+// prefix and suffix, copied to benchScratch for the strcmp() sort
+static int copyLegacyTerms(void)
+{
+    RDFArena scratch;
+    RDFArena_init(&scratch, benchScratch, sizeof(benchScratch));
+    for (int id = 0; id < benchGraph.termCount; id++) {
+        int iri = RDFGraph_termKind(&benchGraph, (RDFTermId)id) == RDF_TERM_IRI;
+        size_t len = RDFGraph_termLength(&benchGraph, (RDFTermId)id);
+        char *text = (char *)RDFArena_alloc(&scratch, len + 3, 1);
+        if (!text) return 0;
+        RDFGraph_copyTerm(&benchGraph, (RDFTermId)id, text + iri, len + 1);
+        if (iri) {
+            text[0] = '<';
+            text[len + 1] = '>';
+            text[len + 2] = '\0';
+        }
+        legacyTerms[id] = text;
+    }
+    return 1;
+}
+
+// Fill benchGraph with tripleCount shuffled triples over a vocabulary that
+// repeats subjects and predicates the way credential claims do
+static int buildSortGraph(int tripleCount)
+{
+    char subject[40], predicate[40], object[40];
+    uint32_t seed = 0x2545F491u;
+
+    RDFGraph_init(&benchGraph, benchArena, sizeof(benchArena));
+    for (int i = 0; i < tripleCount; i++) {
+        uint32_t r = benchRandom(&seed);
+        snprintf(subject, sizeof(subject), "did:example:subject%lu", (unsigned long)(r % (uint32_t)(tripleCount / 10 + 1)));
+        snprintf(predicate, sizeof(predicate), "https://schema.org/p%lu", (unsigned long)(benchRandom(&seed) % 50u));
+        snprintf(object, sizeof(object), "\"value %lu\"", (unsigned long)(benchRandom(&seed) % (uint32_t)(tripleCount / 5 + 1)));
+        if (RDFGraph_addTriple(&benchGraph, subject, predicate, object) != RDF_OK) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+void Bench_canonicalSort(BenchPrintFn print, int tripleCount)
+{
+    char line[160];
+
+    if (tripleCount > MAX_TRIPLES || !buildSortGraph(tripleCount) || !copyLegacyTerms()) {
+        snprintf(line, sizeof(line), "sort %d triples: does not fit this build", tripleCount);
+        print(line);
+        return;
+    }
+
+    for (int i = 0; i < tripleCount; i++) {
+        unsortedTriples[i] = *RDFGraph_triple(&benchGraph, i);
+        legacyUnsorted[i].subject = legacyTerms[unsortedTriples[i].subject];
+        legacyUnsorted[i].predicate = legacyTerms[unsortedTriples[i].predicate];
+        legacyUnsorted[i].object = legacyTerms[unsortedTriples[i].object];
+    }
+
+    uint64_t bestLegacy = UINT64_MAX, bestRank = UINT64_MAX;
+    for (int rep = 0; rep < BENCH_REPEAT; rep++) {
+        memcpy(legacyTriples, legacyUnsorted, (size_t)tripleCount * sizeof(LegacyTriple));
+        uint64_t start = Bench_ticks();
+        qsort(legacyTriples, (size_t)tripleCount, sizeof(LegacyTriple), compareLegacyTriples);
+        uint64_t elapsed = Bench_ticks() - start;
+        if (elapsed < bestLegacy) bestLegacy = elapsed;
+
+        RDFGraph_truncate(&benchGraph, 0);
+        for (int i = 0; i < tripleCount; i++) {
+            const RDFTriple *t = &unsortedTriples[i];
+            RDFGraph_addQuadIds(&benchGraph, t->subject, t->predicate, t->object, t->graph);
+        }
+        start = Bench_ticks();
+        RDFGraph_canonicalize(&benchGraph);
+        elapsed = Bench_ticks() - start;
+        if (elapsed < bestRank) bestRank = elapsed;
+    }
+
+    int identical = 1;
+    for (int i = 0; i < tripleCount && identical; i++) {
+        const RDFTriple *t = RDFGraph_triple(&benchGraph, i);
+        identical = legacyTriples[i].subject == legacyTerms[t->subject]
+                 && legacyTriples[i].predicate == legacyTerms[t->predicate]
+                 && legacyTriples[i].object == legacyTerms[t->object];
+    }
+
+    // Term text the graph stores, against what the strings take in full
+    snprintf(line, sizeof(line), "sort %d triples (%d terms, text %lu B, %lu B unsplit): qsort/strcmp %lu %s, rank keys %lu %s, order %s",
+             tripleCount, benchGraph.termCount,
+             (unsigned long)storedTextSize(), (unsigned long)legacyTextSize(),
+             (unsigned long)bestLegacy, Bench_tickUnit(),
+             (unsigned long)bestRank, Bench_tickUnit(),
+             identical ? "identical" : "DIFFERS");
+    print(line);
+}
+
+/* RDF dataset canonicalization ----------------------------------------------*/
+
+static uint32_t benchClock(void)
+{
+    return (uint32_t)Bench_ticks();
+}
+
+static void reportCanon(BenchPrintFn print, const char *name, const RDFCanonStats *stats, int quads)
+{
+    static const char *const phaseNames[RDFC_PHASE_COUNT] = {
+        "map", "first-degree", "unique", "n-degree", "output"
+    };
+    char line[160];
+    int n = snprintf(line, sizeof(line), "rdfc %s: %d quads, %lu blank nodes, %lu n-degree calls, scratch %lu B",
+                     name, quads, (unsigned long)stats->blankNodes,
+                     (unsigned long)stats->nDegreeCalls, (unsigned long)stats->scratchPeak);
+    print(line);
+    n = 0;
+    for (int i = 0; i < RDFC_PHASE_COUNT && n < (int)sizeof(line); i++) {
+        n += snprintf(line + n, sizeof(line) - (size_t)n, "%s%s %lu", i ? ", " : "  ",
+                      phaseNames[i], (unsigned long)stats->phaseTicks[i]);
+    }
+    if (n < (int)sizeof(line)) snprintf(line + n, sizeof(line) - (size_t)n, " %s", Bench_tickUnit());
+    print(line);
+}
+
+// Credentials with blank node subjects, five triples each. Credentials
+// are grouped in rings of ringSize that share an identifier and point at
+// the next member, so members of a ring only differ by position and force
+// Hash N-Degree Quads; with ringSize 1 every blank node is unique.
+static int buildCanonGraph(int credentials, int ringSize)
+{
+    char subject[24], claim[24], next[24], ring[24];
+
+    RDFGraph_init(&benchGraph, benchArena, sizeof(benchArena));
+    for (int i = 0; i < credentials; i++) {
+        int first = i - i % ringSize;
+        int members = credentials - first < ringSize ? credentials - first : ringSize;
+        snprintf(subject, sizeof(subject), "_:cred%d", i);
+        snprintf(claim, sizeof(claim), "_:claim%d", i);
+        snprintf(next, sizeof(next), "_:cred%d", first + (i + 1 - first) % members);
+        snprintf(ring, sizeof(ring), "\"%d\"", first);
+        if (RDFGraph_addTriple(&benchGraph, subject, "http://www.w3.org/1999/02/22-rdf-syntax-ns#type",
+                               "https://www.w3.org/2018/credentials#VerifiableCredential") != RDF_OK
+            || RDFGraph_addTriple(&benchGraph, subject, "https://www.w3.org/2018/credentials#credentialSubject", claim) != RDF_OK
+            || RDFGraph_addTriple(&benchGraph, subject, "https://schema.org/identifier", ring) != RDF_OK
+            || RDFGraph_addTriple(&benchGraph, subject, "https://schema.org/knows", next) != RDF_OK
+            || RDFGraph_addTriple(&benchGraph, claim, "https://schema.org/value", "\"claim\"") != RDF_OK) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+void Bench_canonicalize(BenchPrintFn print, int credentials, int ringSize)
+{
+    char name[32], line[80];
+    RDFArena scratch;
+    RDFCanonOptions options = { benchClock, 0 };
+    RDFCanonStats stats;
+    RDFCanonDataset canonical;
+
+    snprintf(name, sizeof(name), "%d credentials, ring %d", credentials, ringSize);
+    if (5 * credentials > MAX_TRIPLES || !buildCanonGraph(credentials, ringSize)) {
+        snprintf(line, sizeof(line), "rdfc %s: does not fit this build", name);
+        print(line);
+        return;
+    }
+
+    RDFArena_init(&scratch, benchScratch, sizeof(benchScratch));
+    RDFStatus status = RDFCanon_run(&benchGraph, &scratch, &options, &canonical, &stats);
+    if (status != RDF_OK) {
+        snprintf(line, sizeof(line), "rdfc %s: failed with status %d", name, (int)status);
+        print(line);
+        return;
+    }
+    reportCanon(print, name, &stats, canonical.count);
+}
+
+/* Incremental re-canonicalization -------------------------------------------*/
+
+#define PROOF_CREATED 1
+#define PROOF_TRIPLES 4
+
+static RDFCanonCache benchCache;
+
+static void hashSink(void *ctx, const char *data, size_t len)
+{
+    SHA256_update((SHA256Context *)ctx, data, len);
+}
+
+// What signing cost before RDFCanonCache: RDFC and the whole document
+static RDFStatus fullDigest(uint8_t digest[SHA224_DIGEST_SIZE])
+{
+    RDFArena scratch;
+    SHA256Context md;
+
+    RDFArena_init(&scratch, benchScratch, sizeof(benchScratch));
+    SHA224_init(&md);
+    RDFStatus status = RDFCanon_serialize(&benchGraph, &scratch, NULL, hashSink, &md);
+    SHA256_final(&md, digest);
+    return status;
+}
+
+// The blank node proof main.c signs, next to claims about an IRI subject.
+// Blank node lines sort last, so created is near the end of the canonical
+// document and the first claim at its start.
+static int buildClaimGraph(int claims)
+{
+    char predicate[40], value[24];
+
+    RDFGraph_init(&benchGraph, benchArena, sizeof(benchArena));
+    if (RDFGraph_addTriple(&benchGraph, "_:proof", RDF_IRI_RDF_TYPE, RDF_IRI_SEC_ECDSA_SIGNATURE2018) != RDF_OK
+        || RDFGraph_addTriple(&benchGraph, "_:proof", RDF_IRI_DC_CREATED, "\"0\"") != RDF_OK
+        || RDFGraph_addTriple(&benchGraph, "_:proof", RDF_IRI_SEC_VERIFICATION_METHOD, "did:example:issuer#key1") != RDF_OK
+        || RDFGraph_addTriple(&benchGraph, "_:proof", RDF_IRI_SEC_PROOF_PURPOSE, RDF_IRI_SEC_ASSERTION_METHOD) != RDF_OK) {
+        return 0;
+    }
+    for (int i = 0; i < claims; i++) {
+        snprintf(predicate, sizeof(predicate), "https://schema.org/claim%d", i % 16);
+        snprintf(value, sizeof(value), "\"%d\"", i);
+        if (RDFGraph_addTriple(&benchGraph, "did:example:subject", predicate, value) != RDF_OK) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+void Bench_recanonicalize(BenchPrintFn print, int claims)
+{
+    // Changed triple per measurement: created for the full run and for the
+    // cache, then the claim that sorts first
+    static const int changed[3] = { PROOF_CREATED, PROOF_CREATED, PROOF_TRIPLES };
+    uint64_t best[3] = { UINT64_MAX, UINT64_MAX, UINT64_MAX };
+    uint32_t lines[3] = { 0, 0, 0 };
+    uint8_t digest[SHA224_DIGEST_SIZE], expected[SHA224_DIGEST_SIZE];
+    char line[160], value[24];
+    int agree = 1;
+    RDFArena scratch;
+    RDFStatus status = RDF_ERR_GRAPH_FULL;
+
+    RDFCanonCache_init(&benchCache, SHA224_DIGEST_SIZE);
+    if (claims + PROOF_TRIPLES <= MAX_TRIPLES && buildClaimGraph(claims)) {
+        RDFArena_init(&scratch, benchScratch, sizeof(benchScratch));
+        status = RDFCanonCache_digest(&benchCache, &benchGraph, &scratch, NULL, digest);
+    }
+    for (int r = 0; r < BENCH_REPEAT && status == RDF_OK; r++) {
+        for (int k = 0; k < 3 && status == RDF_OK; k++) {
+            snprintf(value, sizeof(value), "\"%d\"", -(3 * r + k + 1));
+            status = RDFGraph_setObject(&benchGraph, changed[k], value);
+            if (status != RDF_OK) break;
+
+            uint64_t t0 = Bench_ticks();
+            if (k == 0) {
+                status = fullDigest(digest);
+            } else {
+                RDFArena_init(&scratch, benchScratch, sizeof(benchScratch));
+                status = RDFCanonCache_digest(&benchCache, &benchGraph, &scratch, NULL, digest);
+                lines[k] = benchCache.linesHashed;
+            }
+            uint64_t t = Bench_ticks() - t0;
+            if (t < best[k]) best[k] = t;
+
+            if (status == RDF_OK && k > 0) {
+                status = fullDigest(expected);
+                agree &= memcmp(digest, expected, sizeof(digest)) == 0;
+            }
+        }
+    }
+
+    if (status != RDF_OK) {
+        snprintf(line, sizeof(line), "recanon %d claims: failed with status %d", claims, (int)status);
+        print(line);
+        return;
+    }
+    snprintf(line, sizeof(line), "recanon %d quads: full %lu %s, cached: created %lu %s (%lu lines), first claim %lu %s (%lu lines), %s",
+             benchGraph.size, (unsigned long)best[0], Bench_tickUnit(),
+             (unsigned long)best[1], Bench_tickUnit(), (unsigned long)lines[1],
+             (unsigned long)best[2], Bench_tickUnit(), (unsigned long)lines[2],
+             agree ? "digests agree" : "digests DIFFER");
+    print(line);
+}
+
+/* Triple indexes ------------------------------------------------------------*/
+
+#define INDEX_LOOKUPS 64
+
+static RDFIndex benchIndex;
+
+// Claims of subjects with eight statements each over sixteen predicates
+// and 4096 values
+static int buildClaimsBySubject(int tripleCount)
+{
+    char subject[32], predicate[40], value[24];
+
+    RDFGraph_init(&benchGraph, benchArena, sizeof(benchArena));
+    for (int i = 0; i < tripleCount; i++) {
+        snprintf(subject, sizeof(subject), "did:example:%d", i / 8);
+        snprintf(predicate, sizeof(predicate), "https://schema.org/claim%d", (i * 7) % 16);
+        snprintf(value, sizeof(value), "\"%d\"", i % 4096);
+        if (RDFGraph_addTriple(&benchGraph, subject, predicate, value) != RDF_OK) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// "All objects for (subject, predicate)" by scanning, then through the
+// index including the time to build it
+void Bench_index(BenchPrintFn print, int tripleCount)
+{
+    uint64_t bestScan = UINT64_MAX, bestBuild = UINT64_MAX, bestLookup = UINT64_MAX;
+    RDFTriple queries[INDEX_LOOKUPS];
+    uint32_t seed = 2463534242u;
+    long scanned = 0, indexed = 0;
+    char line[160];
+
+    if (tripleCount > MAX_TRIPLES || !buildClaimsBySubject(tripleCount)) {
+        snprintf(line, sizeof(line), "index %d triples: does not fit this build", tripleCount);
+        print(line);
+        return;
+    }
+    for (int q = 0; q < INDEX_LOOKUPS; q++) {
+        queries[q] = *RDFGraph_triple(&benchGraph, (int)(benchRandom(&seed) % (uint32_t)tripleCount));
+    }
+
+    for (int r = 0; r < BENCH_REPEAT; r++) {
+        uint64_t t0 = Bench_ticks();
+        scanned = 0;
+        for (int q = 0; q < INDEX_LOOKUPS; q++) {
+            for (int i = 0; i < benchGraph.size; i++) {
+                const RDFTriple *t = RDFGraph_triple(&benchGraph, i);
+                if (t->subject == queries[q].subject && t->predicate == queries[q].predicate) {
+                    scanned += t->object;
+                }
+            }
+        }
+        uint64_t t1 = Bench_ticks();
+
+        // Changing the graph makes the next lookup rebuild the index
+        RDFGraph_setObject(&benchGraph, 0, r & 1 ? "\"0\"" : "\"-\"");
+        RDFIndex_init(&benchIndex, &benchGraph);
+        uint64_t t2 = Bench_ticks();
+        RDFIndex_match(&benchIndex, queries[0].subject, queries[0].predicate, RDF_NO_TERM);
+        uint64_t t3 = Bench_ticks();
+        indexed = 0;
+        for (int q = 0; q < INDEX_LOOKUPS; q++) {
+            RDFTripleRange range = RDFIndex_match(&benchIndex, queries[q].subject, queries[q].predicate, RDF_NO_TERM);
+            for (int i = 0; i < range.count; i++) {
+                indexed += RDFGraph_triple(&benchGraph, range.pos[i])->object;
+            }
+        }
+        uint64_t t4 = Bench_ticks();
+
+        if (t1 - t0 < bestScan) bestScan = t1 - t0;
+        if (t3 - t2 < bestBuild) bestBuild = t3 - t2;
+        if (t4 - t3 < bestLookup) bestLookup = t4 - t3;
+    }
+
+    snprintf(line, sizeof(line), "index %d triples: (s, p) lookup by scan %lu %s, by index %lu %s after a %lu %s build, %s",
+             tripleCount, (unsigned long)(bestScan / INDEX_LOOKUPS), Bench_tickUnit(),
+             (unsigned long)(bestLookup / INDEX_LOOKUPS), Bench_tickUnit(),
+             (unsigned long)bestBuild, Bench_tickUnit(), scanned == indexed ? "results agree" : "results DIFFER");
+    print(line);
+}
+
+/* Column storage ------------------------------------------------------------*/
+
+#define COLUMN_PREDICATES 50
+#define COLUMN_SCANS 8
+
+// Quads as RDFTriple rows and as RDFColumns, each twice so every repeat
+// sorts the same input, then the sort scratch: 48 bytes per quad plus
+// the term ranks. The board has room for a few hundred in benchScratch.
+#ifdef BENCH_HOST
+static uint8_t columnPool[48 * 1000000 + 8 * (RDF_MAX_TERMS + 1) + 64];
+#else
+#define columnPool benchScratch
+#endif
+
+// Fill rows[] with random quads over terms interned into benchGraph: as
+// many subjects and values as the sort graph would use, within
+// RDF_MAX_TERMS, and fifty predicates
+static int buildColumnQuads(RDFTriple *rows, int tripleCount)
+{
+    char text[40];
+    int room = RDF_MAX_TERMS - COLUMN_PREDICATES;
+    int subjects = tripleCount / 10 + 1 < room / 3 ? tripleCount / 10 + 1 : room / 3;
+    int values = tripleCount / 5 + 1 < room - subjects ? tripleCount / 5 + 1 : room - subjects;
+    uint32_t seed = 0x2545F491u;
+
+    RDFGraph_init(&benchGraph, benchArena, sizeof(benchArena));
+    for (int i = 0; i < subjects + COLUMN_PREDICATES + values; i++) {
+        if (i < subjects) {
+            snprintf(text, sizeof(text), "did:example:subject%d", i);
+        } else if (i < subjects + COLUMN_PREDICATES) {
+            snprintf(text, sizeof(text), "https://schema.org/p%d", i - subjects);
+        } else {
+            snprintf(text, sizeof(text), "\"value %d\"", i - subjects - COLUMN_PREDICATES);
+        }
+        if (RDFGraph_intern(&benchGraph, text, strlen(text)) != (RDFTermId)i) return 0;
+    }
+    for (int i = 0; i < tripleCount; i++) {
+        rows[i].subject = (RDFTermId)(benchRandom(&seed) % (uint32_t)subjects);
+        rows[i].predicate = (RDFTermId)(subjects + benchRandom(&seed) % COLUMN_PREDICATES);
+        rows[i].object = (RDFTermId)(subjects + COLUMN_PREDICATES + benchRandom(&seed) % (uint32_t)values);
+        rows[i].graph = RDF_NO_TERM;
+    }
+    return subjects;
+}
+
+// "All objects of predicate p" and the canonical sort, over RDFTriple rows
+// and over RDFColumns
+void Bench_tripleColumns(BenchPrintFn print, int tripleCount)
+{
+    RDFArena pool, scratch;
+    RDFColumns columns, unsortedColumns;
+    char line[200];
+
+    RDFArena_init(&pool, columnPool, sizeof(columnPool));
+    size_t rowSize = (size_t)tripleCount * sizeof(RDFTriple);
+    RDFTriple *rows = (RDFTriple *)RDFArena_alloc(&pool, rowSize, sizeof(RDFTermId));
+    RDFTriple *unsortedRows = (RDFTriple *)RDFArena_alloc(&pool, rowSize, sizeof(RDFTermId));
+    void *block = RDFArena_alloc(&pool, rowSize, sizeof(RDFTermId));
+    void *unsortedBlock = RDFArena_alloc(&pool, rowSize, sizeof(RDFTermId));
+    int subjects = rows && unsortedRows && block && unsortedBlock ? buildColumnQuads(unsortedRows, tripleCount) : 0;
+    if (subjects == 0) {
+        snprintf(line, sizeof(line), "columns %d triples: does not fit this build", tripleCount);
+        print(line);
+        return;
+    }
+    RDFArena_init(&scratch, columnPool + pool.used, sizeof(columnPool) - pool.used);
+
+    RDFColumns_init(&unsortedColumns, unsortedBlock, rowSize);
+    for (int i = 0; i < tripleCount; i++) {
+        const RDFTriple *q = &unsortedRows[i];
+        RDFColumns_add(&unsortedColumns, q->subject, q->predicate, q->object, q->graph);
+    }
+    RDFColumns_init(&columns, block, rowSize);
+    memcpy(rows, unsortedRows, rowSize);
+
+    uint64_t bestRowScan = UINT64_MAX, bestColumnScan = UINT64_MAX;
+    uint64_t bestRowSort = UINT64_MAX, bestColumnSort = UINT64_MAX;
+    unsigned long rowSum = 0, columnSum = 0;
+    int sorted = 1;
+    for (int rep = 0; rep < BENCH_REPEAT; rep++) {
+        uint64_t t0 = Bench_ticks();
+        rowSum = 0;
+        for (int q = 0; q < COLUMN_SCANS; q++) {
+            RDFTermId predicate = (RDFTermId)(subjects + q);
+            for (int i = 0; i < tripleCount; i++) {
+                if (rows[i].predicate == predicate) rowSum += rows[i].object;
+            }
+        }
+        uint64_t t1 = Bench_ticks();
+        columnSum = 0;
+        for (int q = 0; q < COLUMN_SCANS; q++) {
+            RDFTermId predicate = (RDFTermId)(subjects + q);
+            for (int i = RDFColumns_next(&unsortedColumns, 0, RDF_NO_TERM, predicate, RDF_NO_TERM); i >= 0;
+                 i = RDFColumns_next(&unsortedColumns, i + 1, RDF_NO_TERM, predicate, RDF_NO_TERM)) {
+                columnSum += unsortedColumns.object[i];
+            }
+        }
+        uint64_t t2 = Bench_ticks();
+
+        memcpy(rows, unsortedRows, rowSize);
+        uint64_t t3 = Bench_ticks();
+        RDFGraph_sortQuads(rows, tripleCount, benchGraph.termCount, RDFGraph_compareTerms, &benchGraph, &scratch, 0);
+        uint64_t t4 = Bench_ticks();
+
+        memcpy(block, unsortedBlock, rowSize);
+        columns.size = tripleCount;
+        uint64_t t5 = Bench_ticks();
+        sorted &= RDFColumns_sort(&columns, benchGraph.termCount, RDFGraph_compareTerms, &benchGraph, &scratch, 0) == RDF_OK;
+        uint64_t t6 = Bench_ticks();
+
+        if (t1 - t0 < bestRowScan) bestRowScan = t1 - t0;
+        if (t2 - t1 < bestColumnScan) bestColumnScan = t2 - t1;
+        if (t4 - t3 < bestRowSort) bestRowSort = t4 - t3;
+        if (t6 - t5 < bestColumnSort) bestColumnSort = t6 - t5;
+    }
+
+    int identical = sorted && rowSum == columnSum;
+    for (int i = 0; i < tripleCount && identical; i++) {
+        RDFTriple quad = RDFColumns_quad(&columns, i);
+        identical = memcmp(&quad, &rows[i], sizeof(RDFTriple)) == 0;
+    }
+
+    snprintf(line, sizeof(line), "columns %d triples: predicate scan rows %lu %s, columns %lu %s; sort rows %lu %s, columns %lu %s; %s",
+             tripleCount, (unsigned long)(bestRowScan / COLUMN_SCANS), Bench_tickUnit(),
+             (unsigned long)(bestColumnScan / COLUMN_SCANS), Bench_tickUnit(),
+             (unsigned long)bestRowSort, Bench_tickUnit(), (unsigned long)bestColumnSort, Bench_tickUnit(),
+             identical ? "results agree" : "results DIFFER");
+    print(line);
+}
+
+/* JSON-LD serialization ----------------------------------------------------*/
+
+static const char benchCreated[] = "2025-10-23T05:50:16Z";
+static const char benchSignature[] =
+    "4A19274429E40522234B8785DC25FC524F179DCC95FF09B3C9770FC71F54CA0D"
+    "F807B5A408D092F725CC8C650B241AB2B3EAF436C9E1D064A069B1F51B9A6052";
+
+static const JSONLDActiveContext benchContext = {
+    { JSONLD_CONTEXT_SCHEMA_ORG, JSONLD_CONTEXT_SECURITY_V2 }, 2
+};
+static const char benchDescription[] = "Hello World!";
+
+enum { BENCH_CLAIM_PREDICATES = 16 };
+
+// The credential processRDF() serializes, whose subject makes claims
+// over sixteen predicates outside the vocabulary, so most of them have
+// several values; every fourth, from the second on, is language-tagged.
+// Returns the number of triples, 0 if they do not fit.
+static int buildCredential(int claims)
+{
+    char created[sizeof(benchCreated) + sizeof("\"\"^^<" RDF_IRI_XSD_DATE_TIME ">")];
+    char jws[sizeof(benchSignature) + 2];
+    char description[sizeof(benchDescription) + 2];
+    char predicate[48], value[24];
+    snprintf(created, sizeof(created), "\"%s\"^^<" RDF_IRI_XSD_DATE_TIME ">", benchCreated);
+    snprintf(jws, sizeof(jws), "\"%s\"", benchSignature);
+    snprintf(description, sizeof(description), "\"%s\"", benchDescription);
+
+    RDFGraph_init(&benchGraph, benchArena, sizeof(benchArena));
+    RDFStatus status = RDFGraph_addTriple(&benchGraph, "_:proof", RDF_IRI_RDF_TYPE, RDF_IRI_SEC_ECDSA_SIGNATURE2018);
+    if (status == RDF_OK) status = RDFGraph_addTriple(&benchGraph, "_:proof", RDF_IRI_DC_CREATED, created);
+    if (status == RDF_OK) status = RDFGraph_addTriple(&benchGraph, "_:proof", RDF_IRI_SEC_VERIFICATION_METHOD, "did:example:123456789abcdefghi#key1");
+    if (status == RDF_OK) status = RDFGraph_addTriple(&benchGraph, "_:proof", RDF_IRI_SEC_PROOF_PURPOSE, RDF_IRI_SEC_ASSERTION_METHOD);
+    if (status == RDF_OK) status = RDFGraph_addTriple(&benchGraph, "_:proof", RDF_IRI_SEC_JWS, jws);
+    if (status == RDF_OK) status = RDFGraph_addTriple(&benchGraph, "_:credential", RDF_IRI_SCHEMA_DESCRIPTION, description);
+    if (status == RDF_OK) status = RDFGraph_addTriple(&benchGraph, "_:credential", RDF_IRI_SEC_PROOF, "_:proof");
+    if (status == RDF_OK && claims > 0) {
+        status = RDFGraph_addTriple(&benchGraph, "_:credential", RDF_IRI_CRED_CREDENTIAL_SUBJECT, "_:subject");
+    }
+
+    // Values of a predicate are added together, as the writer needs them
+    for (int p = 0; p < BENCH_CLAIM_PREDICATES && status == RDF_OK; p++) {
+        snprintf(predicate, sizeof(predicate), "http://example.org/claims#p%d", p);
+        for (int i = p; i < claims && status == RDF_OK; i += BENCH_CLAIM_PREDICATES) {
+            snprintf(value, sizeof(value), i % 4 == 1 ? "\"value %d\"@en" : "\"value %d\"", i);
+            status = RDFGraph_addTriple(&benchGraph, "_:subject", predicate, value);
+        }
+    }
+    return status == RDF_OK ? benchGraph.size : 0;
+}
+
+// What the writer costs for a credential with claims, absolute and per
+// triple, and what measuring the document alone costs. There is no
+// baseline: the strcat() serializer it replaced wrote a fixed proof, not
+// this document, so timing it here would not compare like with like.
+void Bench_jsonld(BenchPrintFn print, int claims)
+{
+    static JSONLDReader reader;
+    char line[200];
+    size_t half = sizeof(benchScratch) / 2;
+    char *writerOut = (char *)benchScratch;
+    RDFArena scratch;
+    RDFArena_init(&scratch, benchScratch + half, half);
+
+    int triples = claims + 8 > MAX_TRIPLES ? 0 : buildCredential(claims);
+    size_t size = triples ? JSONLD_documentSize(&benchGraph, &benchContext, &scratch) : 0;
+    if (size == 0 || size >= half) {
+        snprintf(line, sizeof(line), "jsonld %d claims: does not fit this build", claims);
+        print(line);
+        return;
+    }
+
+    // Small documents are timed over several runs to stay above timer noise
+    int runs = 500 / (claims + 5) + 1;
+    uint64_t bestWriter = UINT64_MAX, bestMeasure = UINT64_MAX;
+    RDFStatus status = RDF_OK;
+    volatile size_t measured = 0;
+    for (int rep = 0; rep < BENCH_REPEAT; rep++) {
+        uint64_t start = Bench_ticks();
+        for (int run = 0; run < runs; run++) {
+            JSONWriter writer;
+            JSONWriter_init(&writer, writerOut, half, NULL, NULL);
+            status = JSONLD_writeDocument(&benchGraph, &benchContext, &scratch, &writer);
+        }
+        uint64_t elapsed = (Bench_ticks() - start) / (uint64_t)runs;
+        if (elapsed < bestWriter) bestWriter = elapsed;
+
+        start = Bench_ticks();
+        for (int run = 0; run < runs; run++) {
+            measured = JSONLD_documentSize(&benchGraph, &benchContext, &scratch);
+        }
+        elapsed = (Bench_ticks() - start) / (uint64_t)runs;
+        if (elapsed < bestMeasure) bestMeasure = elapsed;
+    }
+
+    // Reading the output back must give every triple again
+    RDFGraph_init(&benchGraph, benchArena, sizeof(benchArena));
+    JSONLDReader_init(&reader, &benchGraph, writerOut);
+    if (status == RDF_OK) status = JSONLDReader_feed(&reader, size);
+    int roundTrip = status == RDF_OK && measured == size && JSONLDReader_done(&reader) && benchGraph.size == triples;
+    if (claims > 1) {
+        static const char tagged[] = "\"value 1\"@en";
+        roundTrip &= RDFGraph_find(&benchGraph, tagged, sizeof(tagged) - 1) != RDF_NO_TERM;
+    }
+
+    snprintf(line, sizeof(line), "jsonld %d claims (%d triples, %lu B): writer %lu %s (%lu per triple), size only %lu %s, output %s",
+             claims, triples, (unsigned long)size,
+             (unsigned long)bestWriter, Bench_tickUnit(), (unsigned long)(bestWriter / (uint64_t)triples),
+             (unsigned long)bestMeasure, Bench_tickUnit(),
+             roundTrip ? "reads back" : "DOES NOT READ BACK");
+    print(line);
+    RDFGraph_free(&benchGraph);
+}
+
+// The default credential three ways: walked from its graph by the writer,
+// copied from the compiled template with both holes patched, and with only
+// the jws patched into a copy made before signing
+void Bench_credentialTemplate(BenchPrintFn print)
+{
+    enum { RUNS = 100 };
+    char line[200];
+    size_t third = sizeof(benchScratch) / 3;
+    char *writerOut = (char *)benchScratch;
+    char *templateOut = (char *)benchScratch + third;
+    const char *values[CREDENTIAL_HOLE_COUNT] = {
+        [CREDENTIAL_HOLE_CREATED] = benchCreated,
+        [CREDENTIAL_HOLE_JWS] = benchSignature,
+    };
+    RDFArena scratch;
+    RDFArena_init(&scratch, benchScratch + 2 * third, third);
+
+    if (buildCredential(0) == 0 || third <= CREDENTIAL_TEMPLATE_SIZE) {
+        print("template: does not fit this build");
+        return;
+    }
+
+    uint64_t bestWriter = UINT64_MAX, bestWrite = UINT64_MAX, bestPatch = UINT64_MAX;
+    RDFStatus status = RDF_OK, templateStatus = RDF_OK;
+    for (int rep = 0; rep < BENCH_REPEAT; rep++) {
+        uint64_t start = Bench_ticks();
+        for (int run = 0; run < RUNS; run++) {
+            JSONWriter writer;
+            JSONWriter_init(&writer, writerOut, third, NULL, NULL);
+            status = JSONLD_writeDocument(&benchGraph, &benchContext, &scratch, &writer);
+        }
+        uint64_t elapsed = (Bench_ticks() - start) / RUNS;
+        if (elapsed < bestWriter) bestWriter = elapsed;
+
+        start = Bench_ticks();
+        for (int run = 0; run < RUNS; run++) {
+            templateStatus = CredentialTemplate_write(templateOut, third, values);
+        }
+        elapsed = (Bench_ticks() - start) / RUNS;
+        if (elapsed < bestWrite) bestWrite = elapsed;
+
+        start = Bench_ticks();
+        for (int run = 0; run < RUNS; run++) {
+            templateStatus |= CredentialTemplate_patch(templateOut, CREDENTIAL_HOLE_JWS, benchSignature);
+        }
+        elapsed = (Bench_ticks() - start) / RUNS;
+        if (elapsed < bestPatch) bestPatch = elapsed;
+    }
+
+    // The template is only right while it is what the writer prints
+    int identical = status == RDF_OK && templateStatus == RDF_OK && strcmp(writerOut, templateOut) == 0;
+    snprintf(line, sizeof(line), "template (%d B, %d holes): writer %lu %s, copy + patch %lu %s, patch jws %lu %s, output %s",
+             CREDENTIAL_TEMPLATE_SIZE, CREDENTIAL_HOLE_COUNT,
+             (unsigned long)bestWriter, Bench_tickUnit(),
+             (unsigned long)bestWrite, Bench_tickUnit(),
+             (unsigned long)bestPatch, Bench_tickUnit(),
+             identical ? "agrees" : "DIFFERS");
+    print(line);
+    RDFGraph_free(&benchGraph);
+}
+
+/* JSON-LD reading ----------------------------------------------------------*/
+
+static RDFStatus countEvent(void *ctx, JSONEvent event, const JSONToken *token)
+{
+    (void)event;
+    (void)token;
+    (*(unsigned long *)ctx)++;
+    return RDF_OK;
+}
+
+// A credential whose proof is an array of proofCount proofs
+static size_t buildProofDocument(char *out, size_t size, int proofCount)
+{
+    size_t n = (size_t)snprintf(out, size,
+        "{\r\n  \"@context\": [\"%s\", \"%s\"],\r\n  \"description\": \"%s\",\r\n  \"proof\": [",
+        JSONLD_URL_SCHEMA_ORG, JSONLD_URL_SECURITY_V2, benchDescription);
+    for (int i = 0; i < proofCount && n < size; i++) {
+        n += (size_t)snprintf(out + n, size - n,
+            "%s{\r\n    \"type\": \"EcdsaSignature2018\",\r\n"
+            "    \"created\": \"2025-10-23T05:%02d:%02dZ\",\r\n"
+            "    \"verificationMethod\": \"did:example:123456789abcdefghi#key1\",\r\n"
+            "    \"proofPurpose\": \"assertionMethod\",\r\n"
+            "    \"jws\": \"%s\"\r\n  }",
+            i > 0 ? ", " : "", (i / 60) % 60, i % 60, benchSignature);
+    }
+    if (n < size) n += (size_t)snprintf(out + n, size - n, "]\r\n}\r\n");
+    return n < size ? n : 0;
+}
+
+void Bench_jsonldRead(BenchPrintFn print, int proofCount)
+{
+    static JSONLDReader reader;
+    char line[160];
+    const char *document = (const char *)benchScratch;
+    size_t length = buildProofDocument((char *)benchScratch, sizeof(benchScratch), proofCount);
+
+    if (length == 0 || 6 * proofCount + 1 > MAX_TRIPLES) {
+        snprintf(line, sizeof(line), "jsonld read %d proofs: does not fit this build", proofCount);
+        print(line);
+        return;
+    }
+
+    uint64_t bestTokenize = UINT64_MAX, bestRead = UINT64_MAX;
+    unsigned long events = 0;
+    RDFStatus status = RDF_OK;
+    for (int rep = 0; rep < BENCH_REPEAT && status == RDF_OK; rep++) {
+        JSONParser parser;
+        events = 0;
+        uint64_t start = Bench_ticks();
+        JSONParser_init(&parser, document, countEvent, &events);
+        status = JSONParser_feed(&parser, length);
+        uint64_t elapsed = Bench_ticks() - start;
+        if (elapsed < bestTokenize) bestTokenize = elapsed;
+
+        start = Bench_ticks();
+        RDFGraph_init(&benchGraph, benchArena, sizeof(benchArena));
+        JSONLDReader_init(&reader, &benchGraph, document);
+        if (status == RDF_OK) status = JSONLDReader_feed(&reader, length);
+        elapsed = Bench_ticks() - start;
+        if (elapsed < bestRead) bestRead = elapsed;
+    }
+    if (status != RDF_OK || !JSONLDReader_done(&reader)) {
+        snprintf(line, sizeof(line), "jsonld read %d proofs: failed with status %d", proofCount, (int)status);
+        print(line);
+        return;
+    }
+
+#ifdef BENCH_HOST
+    // bytes * 1000 / ns is MB/s
+    snprintf(line, sizeof(line), "jsonld read %d proofs (%lu B, %lu events): tokenize %lu ns (%lu MB/s), graph %lu ns (%lu MB/s, %d triples)",
+             proofCount, (unsigned long)length, events,
+             (unsigned long)bestTokenize, (unsigned long)(length * 1000 / (bestTokenize ? bestTokenize : 1)),
+             (unsigned long)bestRead, (unsigned long)(length * 1000 / (bestRead ? bestRead : 1)), benchGraph.size);
+#else
+    snprintf(line, sizeof(line), "jsonld read %d proofs (%lu B, %lu events): tokenize %lu cycles (%lu/byte), graph %lu cycles (%lu/byte, %d triples)",
+             proofCount, (unsigned long)length, events,
+             (unsigned long)bestTokenize, (unsigned long)(bestTokenize / length),
+             (unsigned long)bestRead, (unsigned long)(bestRead / length), benchGraph.size);
+#endif
+    print(line);
+    RDFGraph_free(&benchGraph);
+}
+
+/* JCS ----------------------------------------------------------------------*/
+
+// RFC 8785 appendix B: IEEE 754 bits and how JCS must print them, plus a
+// power of two, whose shortest form is not the nearest %e candidate
+static const struct {
+    uint64_t bits;
+    const char *text;
+} rfc8785Numbers[] = {
+    { 0x0000000000000000u, "0" },
+    { 0x8000000000000000u, "0" },
+    { 0x0000000000000001u, "5e-324" },
+    { 0x8000000000000001u, "-5e-324" },
+    { 0x7fefffffffffffffu, "1.7976931348623157e+308" },
+    { 0xffefffffffffffffu, "-1.7976931348623157e+308" },
+    { 0x4340000000000000u, "9007199254740992" },
+    { 0xc340000000000000u, "-9007199254740992" },
+    { 0x4430000000000000u, "295147905179352830000" },
+    { 0x44b52d02c7e14af5u, "9.999999999999997e+22" },
+    { 0x44b52d02c7e14af6u, "1e+23" },
+    { 0x44b52d02c7e14af7u, "1.0000000000000001e+23" },
+    { 0x444b1ae4d6e2ef4eu, "999999999999999700000" },
+    { 0x444b1ae4d6e2ef4fu, "999999999999999900000" },
+    { 0x444b1ae4d6e2ef50u, "1e+21" },
+    { 0x3eb0c6f7a0b5ed8cu, "9.999999999999997e-7" },
+    { 0x3eb0c6f7a0b5ed8du, "0.000001" },
+    { 0x41b3de4355555553u, "333333333.3333332" },
+    { 0x41b3de4355555554u, "333333333.33333325" },
+    { 0x41b3de4355555555u, "333333333.3333333" },
+    { 0x41b3de4355555556u, "333333333.3333334" },
+    { 0x41b3de4355555557u, "333333333.33333343" },
+    { 0xbecbf647612f3696u, "-0.0000033333333333333333" },
+    { 0x43143ff3c1cb0959u, "1424953923781206.2" },
+    { 0x1690000000000000u, "5.225680706521042e-200" },
+};
+
+// Number of rfc8785Numbers JSONCanon_write() prints right, each read from
+// its 17-digit %g form inside an array
+static int checkJcsNumbers(void)
+{
+    enum { VECTORS = sizeof(rfc8785Numbers) / sizeof(rfc8785Numbers[0]) };
+    static uint8_t members[64];
+    char json[48], expected[48], out[48];
+    int passed = 0;
+
+    for (int v = 0; v < VECTORS; v++) {
+        double value;
+        memcpy(&value, &rfc8785Numbers[v].bits, sizeof(value));
+        int length = snprintf(json, sizeof(json), "[%.17g]", value);
+        snprintf(expected, sizeof(expected), "[%s]", rfc8785Numbers[v].text);
+
+        RDFArena scratch;
+        JSONWriter writer;
+        RDFArena_init(&scratch, members, sizeof(members));
+        JSONWriter_init(&writer, out, sizeof(out), NULL, NULL);
+        passed += JSONCanon_write(json, (size_t)length, NULL, &scratch, &writer) == RDF_OK
+                  && writer.total == strlen(expected) && memcmp(out, expected, writer.total) == 0;
+    }
+    return passed;
+}
+
+// Canonicalize a credential with proofCount proofs into SHA-224, as
+// hashJCS() in main.c does, and tokenize it alone for comparison. Checks
+// the RFC 8785 number vectors first.
+void Bench_jcs(BenchPrintFn print, int proofCount)
+{
+    static uint8_t members[1024];
+    char line[200], chunk[64];
+    const char *document = (const char *)benchScratch;
+    int numbers = checkJcsNumbers();
+    size_t length = buildProofDocument((char *)benchScratch, sizeof(benchScratch), proofCount);
+
+    if (length == 0) {
+        snprintf(line, sizeof(line), "jcs %d proofs: does not fit this build", proofCount);
+        print(line);
+        return;
+    }
+
+    uint64_t bestTokenize = UINT64_MAX, bestCanon = UINT64_MAX;
+    RDFStatus status = RDF_OK;
+    size_t canonical = 0;
+    for (int rep = 0; rep < BENCH_REPEAT && status == RDF_OK; rep++) {
+        JSONParser parser;
+        unsigned long events = 0;
+        uint64_t start = Bench_ticks();
+        JSONParser_init(&parser, document, countEvent, &events);
+        status = JSONParser_feed(&parser, length);
+        uint64_t elapsed = Bench_ticks() - start;
+        if (elapsed < bestTokenize) bestTokenize = elapsed;
+
+        SHA256Context md;
+        RDFArena scratch;
+        JSONWriter writer;
+        uint8_t digest[SHA224_DIGEST_SIZE];
+        start = Bench_ticks();
+        SHA224_init(&md);
+        RDFArena_init(&scratch, members, sizeof(members));
+        JSONWriter_init(&writer, chunk, sizeof(chunk), hashSink, &md);
+        if (status == RDF_OK) status = JSONCanon_write(document, length, NULL, &scratch, &writer);
+        SHA256_final(&md, digest);
+        elapsed = Bench_ticks() - start;
+        if (elapsed < bestCanon) bestCanon = elapsed;
+        canonical = writer.total;
+    }
+    if (status != RDF_OK) {
+        snprintf(line, sizeof(line), "jcs %d proofs: failed with status %d", proofCount, (int)status);
+        print(line);
+        return;
+    }
+
+    enum { VECTORS = sizeof(rfc8785Numbers) / sizeof(rfc8785Numbers[0]) };
+#ifdef BENCH_HOST
+    snprintf(line, sizeof(line), "jcs %d proofs (%lu B -> %lu B): tokenize %lu ns, canonicalize + SHA-224 %lu ns (%lu MB/s); rfc 8785 numbers %d/%d%s",
+             proofCount, (unsigned long)length, (unsigned long)canonical, (unsigned long)bestTokenize,
+             (unsigned long)bestCanon, (unsigned long)(length * 1000 / (bestCanon ? bestCanon : 1)),
+             numbers, VECTORS, numbers == VECTORS ? "" : ", CHECK FAILED");
+#else
+    snprintf(line, sizeof(line), "jcs %d proofs (%lu B -> %lu B): tokenize %lu cycles, canonicalize + SHA-224 %lu cycles (%lu/byte); rfc 8785 numbers %d/%d%s",
+             proofCount, (unsigned long)length, (unsigned long)canonical, (unsigned long)bestTokenize,
+             (unsigned long)bestCanon, (unsigned long)(bestCanon / length),
+             numbers, VECTORS, numbers == VECTORS ? "" : ", CHECK FAILED");
+#endif
+    print(line);
+}
+
+/* Signing input midstate --------------------------------------------------*/
+
+// The default credential's JCS signing input hashed from byte 0 and from
+// the midstate after its constant prefix, against JSONCanon_write() of the
+// template's document without jws, which must give the same digest
+void Bench_signingMidstate(BenchPrintFn print)
+{
+    enum { RUNS = 100 };
+    static uint8_t members[256];
+    char line[200], chunk[64];
+    const char *values[CREDENTIAL_HOLE_COUNT] = {
+        [CREDENTIAL_HOLE_CREATED] = benchCreated,
+        [CREDENTIAL_HOLE_JWS] = benchSignature,
+    };
+    uint8_t full[SHA224_DIGEST_SIZE], resumed[SHA224_DIGEST_SIZE], canonical[SHA224_DIGEST_SIZE];
+    SHA256Midstate start, prefix;
+    SHA256Context md;
+    SHA224_init(&md);
+    SHA256_saveMidstate(&md, &start);
+
+    uint64_t bestPrefix = UINT64_MAX, bestFull = UINT64_MAX, bestResumed = UINT64_MAX;
+    RDFStatus status = RDF_OK;
+    for (int rep = 0; rep < BENCH_REPEAT; rep++) {
+        uint64_t begin = Bench_ticks();
+        CredentialTemplate_signingPrefix(&prefix);
+        uint64_t elapsed = Bench_ticks() - begin;
+        if (elapsed < bestPrefix) bestPrefix = elapsed;
+
+        begin = Bench_ticks();
+        for (int run = 0; run < RUNS; run++) {
+            status |= CredentialTemplate_signingDigest(&start, values, full);
+        }
+        elapsed = (Bench_ticks() - begin) / RUNS;
+        if (elapsed < bestFull) bestFull = elapsed;
+
+        begin = Bench_ticks();
+        for (int run = 0; run < RUNS; run++) {
+            status |= CredentialTemplate_signingDigest(&prefix, values, resumed);
+        }
+        elapsed = (Bench_ticks() - begin) / RUNS;
+        if (elapsed < bestResumed) bestResumed = elapsed;
+    }
+
+    // What hashCredential() signs without the template
+    RDFArena scratch;
+    JSONWriter writer;
+    char *document = (char *)benchScratch;
+    RDFArena_init(&scratch, members, sizeof(members));
+    SHA224_init(&md);
+    JSONWriter_init(&writer, chunk, sizeof(chunk), hashSink, &md);
+    if (status == RDF_OK) status = CredentialTemplate_write(document, sizeof(benchScratch), values);
+    if (status == RDF_OK) status = JSONCanon_write(document, CREDENTIAL_TEMPLATE_SIZE, "jws", &scratch, &writer);
+    SHA256_final(&md, canonical);
+
+    int agree = status == RDF_OK && memcmp(full, resumed, sizeof(full)) == 0
+                && memcmp(full, canonical, sizeof(full)) == 0;
+    snprintf(line, sizeof(line), "signing midstate (%d B, %lu B prefix): prefix once %lu %s, digest from byte 0 %lu %s, resumed %lu %s, digests %s",
+             CREDENTIAL_SIGNING_SIZE, (unsigned long)prefix.length, (unsigned long)bestPrefix, Bench_tickUnit(),
+             (unsigned long)bestFull, Bench_tickUnit(), (unsigned long)bestResumed, Bench_tickUnit(),
+             agree ? "agree" : "DIFFER");
+    print(line);
+}
+
+/* ECDSA pre-signatures ----------------------------------------------------*/
+
+// x(k·G) for k = 1, 2, 3, n - 1 and an arbitrary k, from a reference
+// implementation: s·k = e + r·d holds whatever r is, so these are what
+// pin down P256_baseMultiplyX()
+static const struct {
+    uint8_t k[P256_BYTES], x[P256_BYTES];
+} baseMultiplyVectors[] = {
+    { { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01 },
+      { 0x6b, 0x17, 0xd1, 0xf2, 0xe1, 0x2c, 0x42, 0x47, 0xf8, 0xbc, 0xe6, 0xe5, 0x63, 0xa4, 0x40, 0xf2,
+        0x77, 0x03, 0x7d, 0x81, 0x2d, 0xeb, 0x33, 0xa0, 0xf4, 0xa1, 0x39, 0x45, 0xd8, 0x98, 0xc2, 0x96 } },
+    { { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02 },
+      { 0x7c, 0xf2, 0x7b, 0x18, 0x8d, 0x03, 0x4f, 0x7e, 0x8a, 0x52, 0x38, 0x03, 0x04, 0xb5, 0x1a, 0xc3,
+        0xc0, 0x89, 0x69, 0xe2, 0x77, 0xf2, 0x1b, 0x35, 0xa6, 0x0b, 0x48, 0xfc, 0x47, 0x66, 0x99, 0x78 } },
+    { { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03 },
+      { 0x5e, 0xcb, 0xe4, 0xd1, 0xa6, 0x33, 0x0a, 0x44, 0xc8, 0xf7, 0xef, 0x95, 0x1d, 0x4b, 0xf1, 0x65,
+        0xe6, 0xc6, 0xb7, 0x21, 0xef, 0xad, 0xa9, 0x85, 0xfb, 0x41, 0x66, 0x1b, 0xc6, 0xe7, 0xfd, 0x6c } },
+    { { 0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+        0xbc, 0xe6, 0xfa, 0xad, 0xa7, 0x17, 0x9e, 0x84, 0xf3, 0xb9, 0xca, 0xc2, 0xfc, 0x63, 0x25, 0x50 },
+      { 0x6b, 0x17, 0xd1, 0xf2, 0xe1, 0x2c, 0x42, 0x47, 0xf8, 0xbc, 0xe6, 0xe5, 0x63, 0xa4, 0x40, 0xf2,
+        0x77, 0x03, 0x7d, 0x81, 0x2d, 0xeb, 0x33, 0xa0, 0xf4, 0xa1, 0x39, 0x45, 0xd8, 0x98, 0xc2, 0x96 } },
+    { { 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff, 0x00,
+        0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff, 0x00 },
+      { 0x54, 0x41, 0xbf, 0xa7, 0xf8, 0xb5, 0xf8, 0x5c, 0xfd, 0xb2, 0x73, 0x7a, 0x44, 0x14, 0x2f, 0x77,
+        0x2a, 0x83, 0x70, 0x77, 0x74, 0x6e, 0x90, 0x94, 0x99, 0xb7, 0x82, 0xf6, 0x5d, 0x8d, 0xe2, 0x1d } },
+};
+
+// The two halves of a P-256 signature as Signer splits them: offline,
+// r = x(k·G), k^-1 and k^-1·r·d; online, s = k^-1·e + k^-1·r·d. Checks
+// s·k = e + r·d for each, and k·G against known answers.
+void Bench_presign(BenchPrintFn print, int signatures)
+{
+    enum { VECTORS = sizeof(baseMultiplyVectors) / sizeof(baseMultiplyVectors[0]) };
+    char line[160];
+    uint8_t bytes[P256_BYTES];
+    P256Int d, k, r, kInverse, kInverseRD, e, s, lhs, rhs;
+    uint64_t bestOffline = UINT64_MAX, bestOnline = UINT64_MAX;
+    int consistent = 1, vectors = 0;
+
+    for (int v = 0; v < VECTORS; v++) {
+        P256Int_fromBytes(&k, baseMultiplyVectors[v].k);
+        P256_baseMultiplyX(&r, &k);
+        P256Int_toBytes(bytes, &r);
+        vectors += memcmp(bytes, baseMultiplyVectors[v].x, sizeof(bytes)) == 0;
+    }
+
+    for (int i = 0; i < P256_BYTES; i++) bytes[i] = (uint8_t)(0x5a ^ (i * 29));
+    P256Int_fromBytes(&d, bytes);
+    P256_scalarReduce(&d);
+    for (int n = 0; n < signatures; n++) {
+        SHA256_compute(&n, sizeof(n), bytes);
+        P256Int_fromBytes(&k, bytes);
+        P256_scalarReduce(&k);
+        if (!P256_scalarIsValid(&k)) continue;
+
+        uint64_t start = Bench_ticks();
+        P256_baseMultiplyX(&r, &k);
+        P256_scalarInvert(&kInverse, &k);
+        P256_scalarMul(&kInverseRD, &r, &d);
+        P256_scalarMul(&kInverseRD, &kInverse, &kInverseRD);
+        uint64_t elapsed = Bench_ticks() - start;
+        if (elapsed < bestOffline) bestOffline = elapsed;
+
+        SHA256_compute(bytes, sizeof(bytes), bytes);
+        start = Bench_ticks();
+        P256Int_fromBytes(&e, bytes);
+        P256_scalarReduce(&e);
+        P256_scalarMul(&s, &kInverse, &e);
+        P256_scalarAdd(&s, &s, &kInverseRD);
+        elapsed = Bench_ticks() - start;
+        if (elapsed < bestOnline) bestOnline = elapsed;
+
+        P256_scalarMul(&lhs, &s, &k);
+        P256_scalarMul(&rhs, &r, &d);
+        P256_scalarAdd(&rhs, &rhs, &e);
+        consistent &= memcmp(&lhs, &rhs, sizeof(lhs)) == 0;
+    }
+
+    snprintf(line, sizeof(line), "presign %d signatures: offline (k*G, k^-1) %lu %s, online %lu %s, %s; k*G vectors %d/%d%s",
+             signatures, (unsigned long)bestOffline, Bench_tickUnit(), (unsigned long)bestOnline, Bench_tickUnit(),
+             consistent ? "s*k = e + r*d" : "INCONSISTENT", vectors, VECTORS, vectors == VECTORS ? "" : ", CHECK FAILED");
+    print(line);
+}
+
+/* Ed25519 against ECDSA ----------------------------------------------------*/
+
+// Both suites over the 64-byte eddsa-rdfc-2022 signing input. On the host
+// ECDSA is the P-256 arithmetic Signer presigns with, k·G and the scalars
+// of one signature, as cmox does not run there; on the board it is cmox
+// through Signer, with an empty pool and then from a pre-signature.
+void Bench_ed25519(BenchPrintFn print, int signatures)
+{
+    char line[200];
+    uint8_t seed[32], secretKey[64], publicKey[32], message[64], signature[64];
+    uint64_t bestSign = UINT64_MAX, bestVerify = UINT64_MAX;
+    uint64_t bestEcdsaSign = UINT64_MAX;
+    int valid = 1;
+
+    for (int i = 0; i < (int)sizeof(seed); i++) seed[i] = (uint8_t)(0xa5 ^ (i * 31));
+    Ed25519_keyPair(secretKey, publicKey, seed);
+    for (int n = 0; n < signatures; n++) {
+        SHA256_compute(&n, sizeof(n), message);
+        SHA256_compute(message, SHA256_DIGEST_SIZE, message + SHA256_DIGEST_SIZE);
+
+        uint64_t start = Bench_ticks();
+        Ed25519_sign(signature, secretKey, message, sizeof(message));
+        uint64_t elapsed = Bench_ticks() - start;
+        if (elapsed < bestSign) bestSign = elapsed;
+
+        start = Bench_ticks();
+        valid &= Ed25519_check(signature, publicKey, message, sizeof(message)) == 0;
+        elapsed = Bench_ticks() - start;
+        if (elapsed < bestVerify) bestVerify = elapsed;
+
+        message[n % sizeof(message)] ^= 1;
+        valid &= Ed25519_check(signature, publicKey, message, sizeof(message)) != 0;
+    }
+
+#ifdef BENCH_HOST
+    P256Int d, k, r, kInverse, e, s;
+    for (int i = 0; i < P256_BYTES; i++) seed[i] = (uint8_t)(0x5a ^ (i * 29));
+    P256Int_fromBytes(&d, seed);
+    P256_scalarReduce(&d);
+    for (int n = 0; n < signatures; n++) {
+        SHA256_compute(&n, sizeof(n), message);
+        P256Int_fromBytes(&k, message);
+        P256_scalarReduce(&k);
+        if (!P256_scalarIsValid(&k)) continue;
+
+        uint64_t start = Bench_ticks();
+        P256_baseMultiplyX(&r, &k);
+        P256_scalarInvert(&kInverse, &k);
+        P256Int_fromBytes(&e, message);
+        P256_scalarReduce(&e);
+        P256_scalarMul(&s, &r, &d);
+        P256_scalarAdd(&s, &s, &e);
+        P256_scalarMul(&s, &kInverse, &s);
+        uint64_t elapsed = Bench_ticks() - start;
+        if (elapsed < bestEcdsaSign) bestEcdsaSign = elapsed;
+    }
+    snprintf(line, sizeof(line), "ed25519 %d signatures: sign %lu %s, verify %lu %s, %s; ecdsa p-256 sign %lu %s, verify needs cmox",
+             signatures, (unsigned long)bestSign, Bench_tickUnit(), (unsigned long)bestVerify, Bench_tickUnit(),
+             valid ? "signatures check" : "CHECK FAILED", (unsigned long)bestEcdsaSign, Bench_tickUnit());
+#else
+    static Signer signer;
+    uint64_t bestPresigned = UINT64_MAX, bestEcdsaVerify = UINT64_MAX;
+    uint8_t digest[CMOX_SHA224_SIZE], ecdsaSignature[CMOX_ECC_SECP256R1_SIG_LEN];
+
+    valid &= Signer_init(&signer, seed, sizeof(seed)) == CMOX_ECC_SUCCESS;
+    for (int n = 0; n < signatures && valid; n++) {
+        SHA256_compute(&n, sizeof(n), message);
+        memcpy(digest, message, sizeof(digest));
+
+        // Empty pool: cmox signs with a DRBG nonce
+        valid &= Signer_sign(&signer, digest, sizeof(digest), ecdsaSignature) == CMOX_ECC_SUCCESS;
+        if (signer.cycles < bestEcdsaSign) bestEcdsaSign = signer.cycles;
+        valid &= Signer_verify(&signer, NULL, digest, sizeof(digest), ecdsaSignature) == CMOX_ECC_AUTH_SUCCESS;
+        if (signer.cycles < bestEcdsaVerify) bestEcdsaVerify = signer.cycles;
+
+        Signer_presign(&signer);
+        valid &= Signer_sign(&signer, digest, sizeof(digest), ecdsaSignature) == CMOX_ECC_SUCCESS;
+        if (signer.cycles < bestPresigned) bestPresigned = signer.cycles;
+        valid &= Signer_verify(&signer, NULL, digest, sizeof(digest), ecdsaSignature) == CMOX_ECC_AUTH_SUCCESS;
+    }
+    Signer_free(&signer);
+    snprintf(line, sizeof(line), "ed25519 %d signatures: sign %lu, verify %lu cycles; ecdsa p-256 sign %lu (presigned %lu), verify %lu cycles; %s",
+             signatures, (unsigned long)bestSign, (unsigned long)bestVerify, (unsigned long)bestEcdsaSign,
+             (unsigned long)bestPresigned, (unsigned long)bestEcdsaVerify, valid ? "signatures check" : "CHECK FAILED");
+#endif
+    print(line);
+}
+
+/* Ed25519 hashes -----------------------------------------------------------*/
+
+// RFC 8032 section 7.1, tests 1 to 3: seed, public key, message, signature
+static const struct {
+    uint8_t seed[32], publicKey[32];
+    uint8_t message[2];
+    uint8_t length;
+    uint8_t signature[64];
+} rfc8032Vectors[] = {
+    { { 0x9d, 0x61, 0xb1, 0x9d, 0xef, 0xfd, 0x5a, 0x60, 0xba, 0x84, 0x4a, 0xf4, 0x92, 0xec, 0x2c, 0xc4,
+        0x44, 0x49, 0xc5, 0x69, 0x7b, 0x32, 0x69, 0x19, 0x70, 0x3b, 0xac, 0x03, 0x1c, 0xae, 0x7f, 0x60 },
+      { 0xd7, 0x5a, 0x98, 0x01, 0x82, 0xb1, 0x0a, 0xb7, 0xd5, 0x4b, 0xfe, 0xd3, 0xc9, 0x64, 0x07, 0x3a,
+        0x0e, 0xe1, 0x72, 0xf3, 0xda, 0xa6, 0x23, 0x25, 0xaf, 0x02, 0x1a, 0x68, 0xf7, 0x07, 0x51, 0x1a },
+      { 0 }, 0,
+      { 0xe5, 0x56, 0x43, 0x00, 0xc3, 0x60, 0xac, 0x72, 0x90, 0x86, 0xe2, 0xcc, 0x80, 0x6e, 0x82, 0x8a,
+        0x84, 0x87, 0x7f, 0x1e, 0xb8, 0xe5, 0xd9, 0x74, 0xd8, 0x73, 0xe0, 0x65, 0x22, 0x49, 0x01, 0x55,
+        0x5f, 0xb8, 0x82, 0x15, 0x90, 0xa3, 0x3b, 0xac, 0xc6, 0x1e, 0x39, 0x70, 0x1c, 0xf9, 0xb4, 0x6b,
+        0xd2, 0x5b, 0xf5, 0xf0, 0x59, 0x5b, 0xbe, 0x24, 0x65, 0x51, 0x41, 0x43, 0x8e, 0x7a, 0x10, 0x0b } },
+    { { 0x4c, 0xcd, 0x08, 0x9b, 0x28, 0xff, 0x96, 0xda, 0x9d, 0xb6, 0xc3, 0x46, 0xec, 0x11, 0x4e, 0x0f,
+        0x5b, 0x8a, 0x31, 0x9f, 0x35, 0xab, 0xa6, 0x24, 0xda, 0x8c, 0xf6, 0xed, 0x4f, 0xb8, 0xa6, 0xfb },
+      { 0x3d, 0x40, 0x17, 0xc3, 0xe8, 0x43, 0x89, 0x5a, 0x92, 0xb7, 0x0a, 0xa7, 0x4d, 0x1b, 0x7e, 0xbc,
+        0x9c, 0x98, 0x2c, 0xcf, 0x2e, 0xc4, 0x96, 0x8c, 0xc0, 0xcd, 0x55, 0xf1, 0x2a, 0xf4, 0x66, 0x0c },
+      { 0x72 }, 1,
+      { 0x92, 0xa0, 0x09, 0xa9, 0xf0, 0xd4, 0xca, 0xb8, 0x72, 0x0e, 0x82, 0x0b, 0x5f, 0x64, 0x25, 0x40,
+        0xa2, 0xb2, 0x7b, 0x54, 0x16, 0x50, 0x3f, 0x8f, 0xb3, 0x76, 0x22, 0x23, 0xeb, 0xdb, 0x69, 0xda,
+        0x08, 0x5a, 0xc1, 0xe4, 0x3e, 0x15, 0x99, 0x6e, 0x45, 0x8f, 0x36, 0x13, 0xd0, 0xf1, 0x1d, 0x8c,
+        0x38, 0x7b, 0x2e, 0xae, 0xb4, 0x30, 0x2a, 0xee, 0xb0, 0x0d, 0x29, 0x16, 0x12, 0xbb, 0x0c, 0x00 } },
+    { { 0xc5, 0xaa, 0x8d, 0xf4, 0x3f, 0x9f, 0x83, 0x7b, 0xed, 0xb7, 0x44, 0x2f, 0x31, 0xdc, 0xb7, 0xb1,
+        0x66, 0xd3, 0x85, 0x35, 0x07, 0x6f, 0x09, 0x4b, 0x85, 0xce, 0x3a, 0x2e, 0x0b, 0x44, 0x58, 0xf7 },
+      { 0xfc, 0x51, 0xcd, 0x8e, 0x62, 0x18, 0xa1, 0xa3, 0x8d, 0xa4, 0x7e, 0xd0, 0x02, 0x30, 0xf0, 0x58,
+        0x08, 0x16, 0xed, 0x13, 0xba, 0x33, 0x03, 0xac, 0x5d, 0xeb, 0x91, 0x15, 0x48, 0x90, 0x80, 0x25 },
+      { 0xaf, 0x82 }, 2,
+      { 0x62, 0x91, 0xd6, 0x57, 0xde, 0xec, 0x24, 0x02, 0x48, 0x27, 0xe6, 0x9c, 0x3a, 0xbe, 0x01, 0xa3,
+        0x0c, 0xe5, 0x48, 0xa2, 0x84, 0x74, 0x3a, 0x44, 0x5e, 0x36, 0x80, 0xd7, 0xdb, 0x5a, 0xc3, 0xac,
+        0x18, 0xff, 0x9b, 0x53, 0x8d, 0x16, 0xf2, 0x90, 0xae, 0x67, 0xf7, 0x60, 0x98, 0x4d, 0xc6, 0x59,
+        0x4a, 0x7c, 0x15, 0xe9, 0x71, 0x6e, 0xd2, 0x8d, 0xc0, 0x27, 0xbe, 0xce, 0xea, 0x1e, 0xc4, 0x0a } },
+};
+
+// RFC 8032 Ed25519 against monocypher's BLAKE2b variant: the hash alone
+// over a kilobyte, then signing and verifying the 64-byte Data Integrity
+// signing input. Checks the RFC 8032 test vectors and SHA-512("abc").
+void Bench_ed25519Hash(BenchPrintFn print)
+{
+    enum { VECTORS = sizeof(rfc8032Vectors) / sizeof(rfc8032Vectors[0]), HASHED = 1024 };
+    static const uint8_t abcDigest[8] = { 0xdd, 0xaf, 0x35, 0xa1, 0x93, 0x61, 0x7a, 0xba };
+    char line[200];
+    uint8_t seed[32], secretKey[64], publicKey[32], signature[64], digest[64];
+    const uint8_t *message = benchScratch;
+    uint64_t best[6] = { UINT64_MAX, UINT64_MAX, UINT64_MAX, UINT64_MAX, UINT64_MAX, UINT64_MAX };
+    int vectors = 0;
+
+    SHA512_compute("abc", 3, digest);
+    int pass = memcmp(digest, abcDigest, sizeof(abcDigest)) == 0;
+    for (int v = 0; v < VECTORS; v++) {
+        memcpy(seed, rfc8032Vectors[v].seed, sizeof(seed));
+        Ed25519_keyPair(secretKey, publicKey, seed);
+        Ed25519_sign(signature, secretKey, rfc8032Vectors[v].message, rfc8032Vectors[v].length);
+        vectors += memcmp(publicKey, rfc8032Vectors[v].publicKey, sizeof(publicKey)) == 0
+                   && memcmp(signature, rfc8032Vectors[v].signature, sizeof(signature)) == 0
+                   && Ed25519_check(signature, publicKey, rfc8032Vectors[v].message, rfc8032Vectors[v].length) == 0;
+    }
+
+    for (int i = 0; i < HASHED; i++) benchScratch[i] = (uint8_t)(i * 7);
+    for (int rep = 0; rep < BENCH_REPEAT; rep++) {
+        uint64_t start = Bench_ticks();
+        SHA512_compute(message, HASHED, digest);
+        uint64_t elapsed = Bench_ticks() - start;
+        if (elapsed < best[0]) best[0] = elapsed;
+
+        start = Bench_ticks();
+        crypto_blake2b(digest, sizeof(digest), message, HASHED);
+        elapsed = Bench_ticks() - start;
+        if (elapsed < best[1]) best[1] = elapsed;
+
+        memcpy(seed, rfc8032Vectors[0].seed, sizeof(seed));
+        Ed25519_keyPair(secretKey, publicKey, seed);
+        start = Bench_ticks();
+        Ed25519_sign(signature, secretKey, message, 64);
+        elapsed = Bench_ticks() - start;
+        if (elapsed < best[2]) best[2] = elapsed;
+        start = Bench_ticks();
+        pass &= Ed25519_check(signature, publicKey, message, 64) == 0;
+        elapsed = Bench_ticks() - start;
+        if (elapsed < best[3]) best[3] = elapsed;
+
+        memcpy(seed, rfc8032Vectors[0].seed, sizeof(seed));
+        crypto_eddsa_key_pair(secretKey, publicKey, seed);
+        start = Bench_ticks();
+        crypto_eddsa_sign(signature, secretKey, message, 64);
+        elapsed = Bench_ticks() - start;
+        if (elapsed < best[4]) best[4] = elapsed;
+        start = Bench_ticks();
+        pass &= crypto_eddsa_check(signature, publicKey, message, 64) == 0;
+        elapsed = Bench_ticks() - start;
+        if (elapsed < best[5]) best[5] = elapsed;
+    }
+
+    snprintf(line, sizeof(line), "ed25519 hash: %d B sha-512 %lu, blake2b %lu %s; sign/verify sha-512 %lu/%lu, blake2b %lu/%lu %s; rfc 8032 vectors %d/%d%s",
+             HASHED, (unsigned long)best[0], (unsigned long)best[1], Bench_tickUnit(),
+             (unsigned long)best[2], (unsigned long)best[3], (unsigned long)best[4], (unsigned long)best[5],
+             Bench_tickUnit(), vectors, VECTORS, pass ? "" : ", CHECK FAILED");
+    print(line);
+}
+
+/* Ed25519 batches ----------------------------------------------------------*/
+
+#define BATCH_BENCH_MAX 64
+
+// Ed25519_check() one by one against Ed25519_checkBatch() over runs of 1, 4
+// and 16 signatures and over all of them, per signature; then one forgery
+// in the full batch, which the fallback must pin down. Host only: a run of
+// 16 takes about 22 KB of stack.
+void Bench_ed25519Batch(BenchPrintFn print, int signatures)
+{
+    static const int runs[] = { 1, 4, 16 };
+    static uint8_t secretKeys[BATCH_BENCH_MAX][64], publicKeys[BATCH_BENCH_MAX][32];
+    static uint8_t messages[BATCH_BENCH_MAX][64], signatureList[BATCH_BENCH_MAX][64];
+    static Ed25519BatchItem items[BATCH_BENCH_MAX];
+    static int results[BATCH_BENCH_MAX];
+    char line[200];
+    uint8_t seed[32], random[32];
+    uint64_t bestSingle = UINT64_MAX, bestRun[4] = { UINT64_MAX, UINT64_MAX, UINT64_MAX, UINT64_MAX };
+    int valid = 1;
+
+    if (signatures > BATCH_BENCH_MAX) signatures = BATCH_BENCH_MAX;
+    for (int n = 0; n < signatures; n++) {
+        SHA256_compute(&n, sizeof(n), seed);
+        Ed25519_keyPair(secretKeys[n], publicKeys[n], seed);
+        SHA256_compute(publicKeys[n], sizeof(publicKeys[n]), messages[n]);
+        SHA256_compute(messages[n], SHA256_DIGEST_SIZE, messages[n] + SHA256_DIGEST_SIZE);
+        Ed25519_sign(signatureList[n], secretKeys[n], messages[n], sizeof(messages[n]));
+        items[n] = (Ed25519BatchItem){ signatureList[n], publicKeys[n], messages[n], sizeof(messages[n]) };
+    }
+    SHA256_compute("batch", 5, random);
+
+    for (int rep = 0; rep < BENCH_REPEAT; rep++) {
+        uint64_t start = Bench_ticks();
+        for (int n = 0; n < signatures; n++) {
+            valid &= Ed25519_check(signatureList[n], publicKeys[n], messages[n], sizeof(messages[n])) == 0;
+        }
+        uint64_t elapsed = Bench_ticks() - start;
+        if (elapsed < bestSingle) bestSingle = elapsed;
+
+        for (int r = 0; r < 4; r++) {
+            int run = r < 3 ? runs[r] : signatures;
+            int done = 0;
+            start = Bench_ticks();
+            for (; done + run <= signatures; done += run) {
+                valid &= Ed25519_checkBatch(items + done, (size_t)run, random, results + done) == 0;
+            }
+            elapsed = Bench_ticks() - start;
+            elapsed = done ? elapsed * (uint64_t)signatures / (uint64_t)done : elapsed;
+            if (elapsed < bestRun[r]) bestRun[r] = elapsed;
+        }
+        random[0]++;
+    }
+
+    // Forge one signature: the batch fails and only that item is flagged
+    int forged = signatures / 3;
+    signatureList[forged][40] ^= 0x10;
+    valid &= Ed25519_checkBatch(items, (size_t)signatures, random, results) != 0;
+    for (int n = 0; n < signatures; n++) {
+        valid &= results[n] == (n == forged ? -1 : 0);
+    }
+    signatureList[forged][40] ^= 0x10;
+
+    unsigned long perSignature = (unsigned long)(bestSingle / (uint64_t)signatures);
+    snprintf(line, sizeof(line), "ed25519 batch %d signatures, per signature: single %lu, batch of 1 %lu, 4 %lu, 16 %lu, %d %lu %s; %s",
+             signatures, perSignature, (unsigned long)(bestRun[0] / (uint64_t)signatures),
+             (unsigned long)(bestRun[1] / (uint64_t)signatures), (unsigned long)(bestRun[2] / (uint64_t)signatures),
+             signatures, (unsigned long)(bestRun[3] / (uint64_t)signatures), Bench_tickUnit(),
+             valid ? "forgery found" : "CHECK FAILED");
+    print(line);
+}
+
+/* N-Quads reading ----------------------------------------------------------*/
+
+// claims statements about one subject, every tenth with an escape to decode
+static size_t buildClaimQuads(char *out, size_t size, int claims)
+{
+    size_t n = 0;
+    for (int i = 0; i < claims && n < size; i++) {
+        n += (size_t)snprintf(out + n, size - n,
+            "<did:example:123456789abcdefghi> <http://example.org/claim%d> \"%s %d%s\" .\n",
+            i % 16, benchDescription, i, i % 10 == 0 ? " \\u00E9\\t" : "");
+    }
+    return n < size ? n : 0;
+}
+
+void Bench_nquadsRead(BenchPrintFn print, int claims)
+{
+    enum { CHUNK = 64 };        // about what a UART DMA half-buffer delivers
+    static NQuadsReader reader;
+    char line[160];
+    const char *text = (const char *)benchScratch;
+    size_t length = buildClaimQuads((char *)benchScratch, sizeof(benchScratch), claims);
+
+    if (length == 0 || claims > MAX_TRIPLES) {
+        snprintf(line, sizeof(line), "nquads read %d claims: does not fit this build", claims);
+        print(line);
+        return;
+    }
+
+    uint64_t best = UINT64_MAX;
+    RDFStatus status = RDF_OK;
+    for (int rep = 0; rep < BENCH_REPEAT && status == RDF_OK; rep++) {
+        uint64_t start = Bench_ticks();
+        RDFGraph_init(&benchGraph, benchArena, sizeof(benchArena));
+        NQuadsReader_init(&reader, &benchGraph);
+        for (size_t at = 0; at < length && status == RDF_OK; at += CHUNK) {
+            status = NQuadsReader_feed(&reader, text + at, length - at < CHUNK ? length - at : CHUNK);
+        }
+        if (status == RDF_OK) status = NQuadsReader_finish(&reader);
+        uint64_t elapsed = Bench_ticks() - start;
+        if (elapsed < best) best = elapsed;
+    }
+    if (status != RDF_OK) {
+        snprintf(line, sizeof(line), "nquads read %d claims: failed with status %d at line %lu",
+                 claims, (int)status, reader.line);
+        print(line);
+        return;
+    }
+
+#ifdef BENCH_HOST
+    snprintf(line, sizeof(line), "nquads read %d claims (%lu B, %d B chunks): %lu ns (%lu MB/s, %d triples)",
+             claims, (unsigned long)length, CHUNK, (unsigned long)best,
+             (unsigned long)(length * 1000 / (best ? best : 1)), benchGraph.size);
+#else
+    snprintf(line, sizeof(line), "nquads read %d claims (%lu B, %d B chunks): %lu cycles (%lu/byte, %d triples)",
+             claims, (unsigned long)length, CHUNK, (unsigned long)best,
+             (unsigned long)(best / length), benchGraph.size);
+#endif
+    print(line);
+    RDFGraph_free(&benchGraph);
+}
+
+/* Vocabulary lookup --------------------------------------------------------*/
+
+// The predicate dispatch the serializer used before the vocabulary table:
+// a strcmp() chain, here over the whole vocabulary in declaration order
+static RDFVocabTerm linearLookup(const char *iri)
+{
+    for (int i = 0; i < RDF_VOCAB_COUNT; i++) {
+        const RDFVocabPrefix *prefix = &RDFVocab_prefixes[RDFVocab_terms[i].prefix];
+        if (strncmp(iri, prefix->iri, prefix->length) == 0 && strcmp(iri + prefix->length, RDFVocab_compact((RDFVocabTerm)i)) == 0) {
+            return (RDFVocabTerm)i;
+        }
+    }
+    return RDF_VOCAB_NONE;
+}
+
+void Bench_vocabLookup(BenchPrintFn print)
+{
+    static const char *const probes[] = {
+        RDF_IRI_RDF_TYPE, RDF_IRI_DC_CREATED, RDF_IRI_SEC_VERIFICATION_METHOD,
+        RDF_IRI_SEC_PROOF_PURPOSE, RDF_IRI_SEC_JWS, "https://w3id.org/security#unknown"
+    };
+    enum { PROBES = sizeof(probes) / sizeof(probes[0]), RUNS = 100 };
+    char line[160];
+    size_t length[PROBES];
+    uint64_t bestLinear = UINT64_MAX, bestHash = UINT64_MAX;
+    volatile int sink = 0;
+    int agree = 1;
+
+    for (int p = 0; p < PROBES; p++) {
+        length[p] = strlen(probes[p]);
+        agree &= linearLookup(probes[p]) == RDFVocab_lookupIRI(probes[p], length[p]);
+    }
+
+    for (int rep = 0; rep < BENCH_REPEAT; rep++) {
+        uint64_t start = Bench_ticks();
+        for (int run = 0; run < RUNS; run++) {
+            for (int p = 0; p < PROBES; p++) sink += linearLookup(probes[p]);
+        }
+        uint64_t elapsed = (Bench_ticks() - start) / (RUNS * PROBES);
+        if (elapsed < bestLinear) bestLinear = elapsed;
+
+        start = Bench_ticks();
+        for (int run = 0; run < RUNS; run++) {
+            for (int p = 0; p < PROBES; p++) sink += RDFVocab_lookupIRI(probes[p], length[p]);
+        }
+        elapsed = (Bench_ticks() - start) / (RUNS * PROBES);
+        if (elapsed < bestHash) bestHash = elapsed;
+    }
+
+    snprintf(line, sizeof(line), "vocab %d terms: strcmp chain %lu %s, perfect hash %lu %s per lookup, results %s",
+             RDF_VOCAB_COUNT, (unsigned long)bestLinear, Bench_tickUnit(),
+             (unsigned long)bestHash, Bench_tickUnit(), agree ? "agree" : "DIFFER");
+    print(line);
+}
+
+void Bench_runAll(BenchPrintFn print)
+{
+#ifdef BENCH_HOST
+    Bench_canonicalSort(print, 10000);
+    Bench_canonicalSort(print, 100000);
+    Bench_canonicalize(print, 100, 1);
+    Bench_canonicalize(print, 1000, 4);
+    Bench_canonicalize(print, 100, 6);
+    Bench_recanonicalize(print, 100);
+    Bench_recanonicalize(print, 10000);
+    Bench_index(print, 1000);
+    Bench_index(print, 100000);
+    Bench_tripleColumns(print, 1000);
+    Bench_tripleColumns(print, 10000);
+    Bench_tripleColumns(print, 100000);
+    Bench_tripleColumns(print, 1000000);
+    Bench_jsonld(print, 0);
+    Bench_jsonld(print, 50);
+    Bench_jsonld(print, 500);
+    Bench_credentialTemplate(print);
+    Bench_jsonldRead(print, 1);
+    Bench_jsonldRead(print, 5000);
+    Bench_jcs(print, 5);
+    Bench_jcs(print, 20000);
+    Bench_signingMidstate(print);
+    Bench_presign(print, 20);
+    Bench_ed25519(print, 20);
+    Bench_ed25519Hash(print);
+    Bench_ed25519Batch(print, 64);
+    Bench_nquadsRead(print, 10);
+    Bench_nquadsRead(print, 20000);
+    Bench_vocabLookup(print);
+#else
+    Bench_canonicalSort(print, MAX_TRIPLES);
+    Bench_canonicalize(print, MAX_TRIPLES / 5, 1);
+    Bench_canonicalize(print, MAX_TRIPLES / 5, 2);
+    Bench_recanonicalize(print, MAX_TRIPLES / 2);
+    Bench_index(print, MAX_TRIPLES);
+    Bench_tripleColumns(print, MAX_TRIPLES);
+    Bench_jsonld(print, 0);
+    Bench_jsonld(print, 50);
+    Bench_jsonld(print, 500);
+    Bench_credentialTemplate(print);
+    Bench_jsonldRead(print, 1);
+    Bench_jsonldRead(print, MAX_TRIPLES / 6 < 16 ? MAX_TRIPLES / 6 : 16);
+    Bench_jcs(print, 5);
+    Bench_signingMidstate(print);
+    Bench_presign(print, 3);
+    Bench_ed25519(print, 3);
+    Bench_ed25519Hash(print);
+    Bench_nquadsRead(print, MAX_TRIPLES / 4);
+    Bench_vocabLookup(print);
+#endif
+}
+
+#ifdef BENCH_HOST
+static void hostPrint(const char *line)
+{
+    puts(line);
+}
+
+/* RDFC-1.0 test vectors -----------------------------------------------------*/
+
+static char *readFile(const char *path, size_t *size)
+{
+    FILE *f = fopen(path, "rb");
+    if (!f) return NULL;
+    fseek(f, 0, SEEK_END);
+    long len = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char *data = malloc((size_t)len + 1);
+    if (data && fread(data, 1, (size_t)len, f) != (size_t)len) {
+        free(data);
+        data = NULL;
+    }
+    fclose(f);
+    if (data) {
+        data[len] = '\0';
+        *size = (size_t)len;
+    }
+    return data;
+}
+
+// Read an N-Quads file through NQuadsReader a block at a time
+static RDFStatus loadNQuads(RDFGraph *graph, const char *path, unsigned long *line)
+{
+    static NQuadsReader reader;
+    char block[4096];
+    FILE *f = fopen(path, "rb");
+    if (!f) return RDF_ERR_INVALID;
+
+    NQuadsReader_init(&reader, graph);
+    RDFStatus status = RDF_OK;
+    size_t n;
+    while (status == RDF_OK && (n = fread(block, 1, sizeof(block), f)) > 0) {
+        status = NQuadsReader_feed(&reader, block, n);
+    }
+    fclose(f);
+    if (status == RDF_OK) status = NQuadsReader_finish(&reader);
+    *line = reader.line;
+    return status;
+}
+
+typedef struct {
+    char *data;
+    size_t size;
+    size_t capacity;
+} Buffer;
+
+static void bufferWrite(void *ctx, const char *data, size_t len)
+{
+    Buffer *buffer = (Buffer *)ctx;
+    if (buffer->size + len > buffer->capacity) {
+        buffer->capacity = 2 * (buffer->size + len);
+        buffer->data = realloc(buffer->data, buffer->capacity);
+    }
+    memcpy(buffer->data + buffer->size, data, len);
+    buffer->size += len;
+}
+
+// Canonicalize input and compare with expected, or print the result when
+// no expectation is given. Returns 0 on success.
+static int runVector(const char *input, const char *expected)
+{
+    char line[256];
+    size_t size;
+    unsigned long failedLine;
+
+    RDFGraph_init(&benchGraph, benchArena, sizeof(benchArena));
+    RDFStatus status = loadNQuads(&benchGraph, input, &failedLine);
+    if (status != RDF_OK) {
+        fprintf(stderr, "%s:%lu: load failed with status %d\n", input, failedLine, (int)status);
+        return 1;
+    }
+
+    RDFArena scratch;
+    RDFCanonOptions options = { benchClock, 100000 };
+    RDFCanonStats stats;
+    RDFCanonDataset canonical;
+    RDFArena_init(&scratch, benchScratch, sizeof(benchScratch));
+    status = RDFCanon_run(&benchGraph, &scratch, &options, &canonical, &stats);
+    if (status != RDF_OK) {
+        fprintf(stderr, "%s: canonicalization failed with status %d\n", input, (int)status);
+        return 1;
+    }
+
+    Buffer result = { NULL, 0, 0 };
+    RDFCanon_writeNQuads(&canonical, bufferWrite, &result);
+    reportCanon(hostPrint, input, &stats, canonical.count);
+
+    int failed = 0;
+    if (expected) {
+        char *want = readFile(expected, &size);
+        failed = !want || size != result.size || memcmp(want, result.data, size) != 0;
+        free(want);
+        snprintf(line, sizeof(line), "  %s", failed ? "FAIL" : "pass");
+        hostPrint(line);
+    } else if (result.size) {
+        fwrite(result.data, 1, result.size, stdout);
+    }
+    free(result.data);
+    return failed;
+}
+
+int main(int argc, char **argv)
+{
+    Bench_init();
+    if (argc > 2 && strcmp(argv[1], "rdfc") == 0) {
+        int failures = 0;
+        for (int i = 2; i < argc; i += 2) {
+            failures += runVector(argv[i], i + 1 < argc ? argv[i + 1] : NULL);
+        }
+        return failures != 0;
+    }
+    Bench_runAll(hostPrint);
+    return 0;
+}
+#endif
+
+#endif /* CREDSIGN_BENCH || BENCH_HOST */
@@ -0,0 +1,105 @@
+#include "credential_template.h"
+
+#include <string.h>
+
+// Whether value fits hole exactly and can go into a JSON string as it is
+static int fits(CredentialHoleId hole, const char *value)
+{
+    size_t length = CredentialTemplate_holes[hole].length;
+    for (size_t i = 0; i < length; i++) {
+        unsigned char ch = (unsigned char)value[i];
+        if (ch < 0x20 || ch == '"' || ch == '\\') return 0;
+    }
+    return value[length] == '\0';
+}
+
+RDFStatus CredentialTemplate_write(char *out, size_t size, const char *const values[CREDENTIAL_HOLE_COUNT])
+{
+    if (size <= CREDENTIAL_TEMPLATE_SIZE) {
+        return RDF_ERR_OVERFLOW;
+    }
+    for (int i = 0; i < CREDENTIAL_HOLE_COUNT; i++) {
+        if (!fits((CredentialHoleId)i, values[i])) return RDF_ERR_INVALID;
+    }
+    memcpy(out, CredentialTemplate_text, CREDENTIAL_TEMPLATE_SIZE + 1);
+    for (int i = 0; i < CREDENTIAL_HOLE_COUNT; i++) {
+        const CredentialHole *hole = &CredentialTemplate_holes[i];
+        memcpy(out + hole->offset, values[i], hole->length);
+    }
+    return RDF_OK;
+}
+
+RDFStatus CredentialTemplate_patch(char *out, CredentialHoleId hole, const char *value)
+{
+    if (!fits(hole, value)) {
+        return RDF_ERR_INVALID;
+    }
+    memcpy(out + CredentialTemplate_holes[hole].offset, value, CredentialTemplate_holes[hole].length);
+    return RDF_OK;
+}
+
+// Send text[from..size) to sink with values[i] in place of hole i, in the
+// order the holes appear
+static RDFStatus streamText(const char *text, size_t size, const CredentialHole *holes,
+                            const char *const values[CREDENTIAL_HOLE_COUNT], size_t from, RDFSinkFn sink, void *ctx)
+{
+    uint8_t order[CREDENTIAL_HOLE_COUNT];
+    int count = 0;
+    for (int i = 0; i < CREDENTIAL_HOLE_COUNT; i++) {
+        if (holes[i].length == 0) continue;
+        if (holes[i].offset < from || !fits((CredentialHoleId)i, values[i])) return RDF_ERR_INVALID;
+        int j = count++;
+        for (; j > 0 && holes[order[j - 1]].offset > holes[i].offset; j--) {
+            order[j] = order[j - 1];
+        }
+        order[j] = (uint8_t)i;
+    }
+
+    size_t at = from;
+    for (int i = 0; i < count; i++) {
+        const CredentialHole *hole = &holes[order[i]];
+        sink(ctx, text + at, hole->offset - at);
+        sink(ctx, values[order[i]], hole->length);
+        at = hole->offset + hole->length;
+    }
+    sink(ctx, text + at, size - at);
+    return RDF_OK;
+}
+
+RDFStatus CredentialTemplate_stream(const char *const values[CREDENTIAL_HOLE_COUNT], RDFSinkFn sink, void *ctx)
+{
+    return streamText(CredentialTemplate_text, CREDENTIAL_TEMPLATE_SIZE, CredentialTemplate_holes,
+                      values, 0, sink, ctx);
+}
+
+void CredentialTemplate_signingPrefix(SHA256Midstate *prefix)
+{
+    size_t constant = CREDENTIAL_SIGNING_SIZE;
+    for (int i = 0; i < CREDENTIAL_HOLE_COUNT; i++) {
+        const CredentialHole *hole = &CredentialTemplate_signingHoles[i];
+        if (hole->length && hole->offset < constant) constant = hole->offset;
+    }
+
+    SHA256Context md;
+    SHA224_init(&md);
+    SHA256_update(&md, CredentialTemplate_signingText, constant - constant % SHA256_BLOCK_SIZE);
+    SHA256_saveMidstate(&md, prefix);
+}
+
+static void hashSink(void *ctx, const char *data, size_t len)
+{
+    SHA256_update((SHA256Context *)ctx, data, len);
+}
+
+RDFStatus CredentialTemplate_signingDigest(const SHA256Midstate *prefix, const char *const values[CREDENTIAL_HOLE_COUNT],
+                                           uint8_t digest[SHA224_DIGEST_SIZE])
+{
+    SHA256Context md;
+    SHA256_resume(&md, prefix);
+    RDFStatus status = streamText(CredentialTemplate_signingText, CREDENTIAL_SIGNING_SIZE, CredentialTemplate_signingHoles,
+                                  values, prefix->length, hashSink, &md);
+    if (status == RDF_OK) {
+        SHA256_final(&md, digest);
+    }
+    return status;
+}
@@ -0,0 +1,33 @@
+/* Generated by Tools/gen_template.py from Tools/credential_template.json, do not edit. */
+
+#include "credential_template.h"
+
+const char CredentialTemplate_text[CREDENTIAL_TEMPLATE_SIZE + 1] =
+    "{\r\n"
+    "  \"@context\": [\"http://schema.org/\", \"https://w3id.org/security/v2\"],\r\n"
+    "  \"description\": \"Hello World!\",\r\n"
+    "  \"proof\": {\r\n"
+    "    \"type\": \"https://w3id.org/security#EcdsaSignature2018\",\r\n"
+    "    \"created\": \"00000000000000000000\",\r\n"
+    "    \"verificationMethod\": \"did:example:123456789abcdefghi#key1\",\r\n"
+    "    \"proofPurpose\": \"assertionMethod\",\r\n"
+    "    \"jws\": \"00000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000\"\r\n"
+    "  }\r\n"
+    "}\r\n";
+
+const CredentialHole CredentialTemplate_holes[CREDENTIAL_HOLE_COUNT] = {
+    [CREDENTIAL_HOLE_CREATED] = { 199, 20 },
+    [CREDENTIAL_HOLE_JWS] = { 341, 128 },
+};
+
+// One line per SHA-256 block
+const char CredentialTemplate_signingText[CREDENTIAL_SIGNING_SIZE + 1] =
+    "{\"@context\":[\"http://schema.org/\",\"https://w3id.org/security/v2\""
+    "],\"description\":\"Hello World!\",\"proof\":{\"created\":\"0000000000000"
+    "0000000\",\"proofPurpose\":\"assertionMethod\",\"type\":\"https://w3id.o"
+    "rg/security#EcdsaSignature2018\",\"verificationMethod\":\"did:exampl"
+    "e:123456789abcdefghi#key1\"}}";
+
+const CredentialHole CredentialTemplate_signingHoles[CREDENTIAL_HOLE_COUNT] = {
+    [CREDENTIAL_HOLE_CREATED] = { 115, 20 },
+};
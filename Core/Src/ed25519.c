@@ -0,0 +1,121 @@
+#include "ed25519.h"
+
+#include <string.h>
+
+#include "monocypher.h"
+#include "sha512.h"
+
+// SHA-512 of a || b || c, reduced mod L
+static void hashReduce(uint8_t h[32], const uint8_t *a, size_t aLength, const uint8_t *b, size_t bLength,
+                       const uint8_t *c, size_t cLength)
+{
+    uint8_t hash[SHA512_DIGEST_SIZE];
+    SHA512Context md;
+
+    SHA512_init(&md);
+    SHA512_update(&md, a, aLength);
+    SHA512_update(&md, b, bLength);
+    SHA512_update(&md, c, cLength);
+    SHA512_final(&md, hash);
+    crypto_eddsa_reduce(h, hash);
+    crypto_wipe(hash, sizeof(hash));
+}
+
+void Ed25519_keyPair(uint8_t secretKey[64], uint8_t publicKey[32], uint8_t seed[32])
+{
+    uint8_t a[SHA512_DIGEST_SIZE];
+
+    // Written in this order so that the arguments may overlap, as with
+    // crypto_eddsa_key_pair()
+    memcpy(a, seed, 32);
+    crypto_wipe(seed, 32);
+    memcpy(secretKey, a, 32);
+    SHA512_compute(a, 32, a);
+    crypto_eddsa_trim_scalar(a, a);
+    crypto_eddsa_scalarbase(secretKey + 32, a);
+    memcpy(publicKey, secretKey + 32, 32);
+    crypto_wipe(a, sizeof(a));
+}
+
+// scalar, prefix = SHA-512(seed); r = SHA-512(prefix || M) mod L; R = r·B;
+// h = SHA-512(R || A || M) mod L; S = h·scalar + r mod L
+void Ed25519_sign(uint8_t signature[64], const uint8_t secretKey[64], const uint8_t *message, size_t length)
+{
+    uint8_t a[SHA512_DIGEST_SIZE];  // secret scalar and prefix
+    uint8_t r[32];                  // deterministic nonce
+    uint8_t h[32];
+    uint8_t R[32];                  // lets signature overlap the message
+
+    SHA512_compute(secretKey, 32, a);
+    crypto_eddsa_trim_scalar(a, a);
+    hashReduce(r, a + 32, 32, message, length, NULL, 0);
+    crypto_eddsa_scalarbase(R, r);
+    hashReduce(h, R, 32, secretKey + 32, 32, message, length);
+    memcpy(signature, R, 32);
+    crypto_eddsa_mul_add(signature + 32, h, a, r);
+
+    crypto_wipe(a, sizeof(a));
+    crypto_wipe(r, sizeof(r));
+}
+
+int Ed25519_check(const uint8_t signature[64], const uint8_t publicKey[32], const uint8_t *message, size_t length)
+{
+    uint8_t h[32];
+    hashReduce(h, signature, 32, publicKey, 32, message, length);
+    return crypto_eddsa_check_equation(signature, publicKey, h);
+}
+
+// Checks one run of at most CRYPTO_EDDSA_BATCH_MAX items; first is the
+// run's position in the batch, which keeps duplicate items' weights apart
+static int checkRun(const Ed25519BatchItem *items, size_t count, size_t first, const uint8_t random[32], int *results)
+{
+    const uint8_t *signatures[CRYPTO_EDDSA_BATCH_MAX], *publicKeys[CRYPTO_EDDSA_BATCH_MAX];
+    uint8_t h[CRYPTO_EDDSA_BATCH_MAX][32], weights[CRYPTO_EDDSA_BATCH_MAX][16];
+    uint8_t hash[SHA512_DIGEST_SIZE];
+    SHA512Context md;
+
+    for (size_t i = 0; i < count; i++) {
+        uint8_t index[4] = { (uint8_t)(first + i), (uint8_t)((first + i) >> 8), (uint8_t)((first + i) >> 16),
+                             (uint8_t)((first + i) >> 24) };
+        signatures[i] = items[i].signature;
+        publicKeys[i] = items[i].publicKey;
+        hashReduce(h[i], items[i].signature, 32, items[i].publicKey, 32, items[i].message, items[i].length);
+
+        // z_i = SHA-512(random || i || R || S || A || h_i), 128 bits with
+        // the top one set so that no weight is zero
+        SHA512_init(&md);
+        SHA512_update(&md, random, 32);
+        SHA512_update(&md, index, sizeof(index));
+        SHA512_update(&md, items[i].signature, 64);
+        SHA512_update(&md, items[i].publicKey, 32);
+        SHA512_update(&md, h[i], 32);
+        SHA512_final(&md, hash);
+        memcpy(weights[i], hash, 16);
+        weights[i][15] |= 0x80;
+    }
+    crypto_wipe(hash, sizeof(hash));
+
+    int retval = crypto_eddsa_check_batch_equation(signatures, publicKeys, (const uint8_t (*)[32])h,
+                                                   (const uint8_t (*)[16])weights, count);
+    crypto_wipe(weights, sizeof(weights));
+    if (retval == 0) {
+        for (size_t i = 0; i < count; i++) results[i] = 0;
+        return 0;
+    }
+    retval = 0;
+    for (size_t i = 0; i < count; i++) {
+        results[i] = crypto_eddsa_check_equation(signatures[i], publicKeys[i], h[i]);
+        retval |= results[i];
+    }
+    return retval;
+}
+
+int Ed25519_checkBatch(const Ed25519BatchItem *items, size_t count, const uint8_t random[32], int *results)
+{
+    int retval = 0;
+    for (size_t first = 0; first < count; first += CRYPTO_EDDSA_BATCH_MAX) {
+        size_t run = count - first < CRYPTO_EDDSA_BATCH_MAX ? count - first : CRYPTO_EDDSA_BATCH_MAX;
+        retval |= checkRun(items + first, run, first, random, results + first);
+    }
+    return retval;
+}
@@ -0,0 +1,43 @@
+#include "ed25519_signer.h"
+
+#include "ed25519.h"
+#include "main.h"
+#include "monocypher.h"
+#include "sha256.h"
+
+void Ed25519Signer_init(Ed25519Signer *signer, const uint8_t *seed, size_t seedLength)
+{
+    uint8_t keySeed[32];
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    uint32_t start = DWT->CYCCNT;
+    // Seeds of any length condense to the 32 bytes EdDSA takes; the key
+    // pair differs from the ECDSA one derived from the same seed
+    SHA256_compute(seed, seedLength, keySeed);
+    Ed25519_keyPair(signer->secretKey, signer->publicKey, keySeed);  // wipes keySeed
+    signer->cycles = DWT->CYCCNT - start;
+}
+
+void Ed25519Signer_sign(Ed25519Signer *signer, const uint8_t *message, size_t length,
+                        uint8_t signature[ED25519_SIGNATURE_SIZE])
+{
+    uint32_t start = DWT->CYCCNT;
+    Ed25519_sign(signature, signer->secretKey, message, length);
+    signer->cycles = DWT->CYCCNT - start;
+}
+
+int Ed25519Signer_verify(Ed25519Signer *signer, const uint8_t *publicKey, const uint8_t *message, size_t length,
+                         const uint8_t signature[ED25519_SIGNATURE_SIZE])
+{
+    uint32_t start = DWT->CYCCNT;
+    int retval = Ed25519_check(signature, publicKey ? publicKey : signer->publicKey, message, length);
+    signer->cycles = DWT->CYCCNT - start;
+    return retval == 0;
+}
+
+void Ed25519Signer_free(Ed25519Signer *signer)
+{
+    crypto_wipe(signer->secretKey, sizeof(signer->secretKey));
+}
@@ -0,0 +1,467 @@
+#include "json_canon.h"
+#include "json_parser.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Input has been through JSONParser by the time it is scanned, so the
+// scanner below takes its structure for granted
+// An object member: key points past its opening quote
+typedef struct {
+    const char *key;
+    const char *value;
+    uint32_t keyLength;         // escapes included
+} Member;
+
+typedef struct {
+    RDFArena *scratch;
+    JSONWriter *writer;
+    Member omit;                // key of the members left out, if any
+} Canon;
+
+static RDFStatus writeValue(Canon *canon, const char *p, const char *end);
+
+static RDFStatus acceptEvent(void *ctx, JSONEvent event, const JSONToken *token)
+{
+    (void)ctx;
+    (void)event;
+    (void)token;
+    return RDF_OK;
+}
+
+/* Scanning ------------------------------------------------------------------*/
+
+static const char *skipSpace(const char *p)
+{
+    while (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n') p++;
+    return p;
+}
+
+// p is at an opening quote; returns the closing one
+static const char *stringEnd(const char *p)
+{
+    for (p++; *p != '"'; p++) {
+        if (*p == '\\') p++;
+    }
+    return p;
+}
+
+static const char *valueEnd(const char *p, const char *end)
+{
+    if (*p == '"') {
+        return stringEnd(p) + 1;
+    }
+    if (*p == '{' || *p == '[') {
+        int depth = 0;
+        for (; p < end; p++) {
+            if (*p == '"') {
+                p = stringEnd(p);
+            } else if (*p == '{' || *p == '[') {
+                depth++;
+            } else if ((*p == '}' || *p == ']') && --depth == 0) {
+                return p + 1;
+            }
+        }
+        return p;
+    }
+    while (p < end && *p != ',' && *p != '}' && *p != ']' && *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n') {
+        p++;
+    }
+    return p;
+}
+
+static uint32_t readHex4(const char *s)
+{
+    uint32_t value = 0;
+    for (int i = 0; i < 4; i++) {
+        char c = s[i];
+        value = (value << 4) | (uint32_t)(c <= '9' ? c - '0' : (c | 0x20) - 'a' + 10);
+    }
+    return value;
+}
+
+// Length of the UTF-8 sequence at p, 0 if it is malformed, overlong or a
+// surrogate; *cp receives the code point
+static size_t decodeUtf8(const unsigned char *p, const unsigned char *end, uint32_t *cp)
+{
+    unsigned char c = p[0];
+    size_t len = c < 0x80 ? 1 : c >= 0xC2 && c < 0xE0 ? 2 : c >= 0xE0 && c < 0xF0 ? 3 : c >= 0xF0 && c < 0xF5 ? 4 : 0;
+    if (len == 0 || (size_t)(end - p) < len) return 0;
+    if (len == 1) {
+        *cp = c;
+        return 1;
+    }
+    uint32_t value = c & (0x7Fu >> len);
+    for (size_t i = 1; i < len; i++) {
+        if ((p[i] & 0xC0) != 0x80) return 0;
+        value = (value << 6) | (p[i] & 0x3Fu);
+    }
+    static const uint32_t least[] = { 0, 0, 0x80, 0x800, 0x10000 };
+    if (value < least[len] || value > 0x10FFFF || (value >= 0xD800 && value <= 0xDFFF)) return 0;
+    *cp = value;
+    return len;
+}
+
+/* Keys ----------------------------------------------------------------------*/
+
+// Reads a raw key as UTF-16 code units, the order RFC 8785 sorts by.
+// \u escapes already are code units.
+typedef struct {
+    const char *p;
+    const char *end;
+    uint16_t low;               // second half of a surrogate pair, if pending
+} UnitReader;
+
+static int32_t nextUnit(UnitReader *reader)
+{
+    if (reader->low) {
+        int32_t unit = reader->low;
+        reader->low = 0;
+        return unit;
+    }
+    if (reader->p >= reader->end) return -1;
+
+    const char *p = reader->p;
+    if (*p == '\\') {
+        reader->p += 2;
+        switch (p[1]) {
+        case 'b': return '\b';
+        case 'f': return '\f';
+        case 'n': return '\n';
+        case 'r': return '\r';
+        case 't': return '\t';
+        case 'u':
+            reader->p += 4;
+            return (int32_t)readHex4(p + 2);
+        default: return (unsigned char)p[1];
+        }
+    }
+    uint32_t cp;
+    size_t len = decodeUtf8((const unsigned char *)p, (const unsigned char *)reader->end, &cp);
+    if (len == 0) {
+        // Rejected when the key is written; any order will do until then
+        reader->p++;
+        return (unsigned char)*p;
+    }
+    reader->p += len;
+    if (cp < 0x10000) return (int32_t)cp;
+    cp -= 0x10000;
+    reader->low = (uint16_t)(0xDC00 | (cp & 0x3FF));
+    return (int32_t)(0xD800 | (cp >> 10));
+}
+
+static int compareKeys(const Member *a, const Member *b)
+{
+    UnitReader x = { a->key, a->key + a->keyLength, 0 };
+    UnitReader y = { b->key, b->key + b->keyLength, 0 };
+    for (;;) {
+        int32_t u = nextUnit(&x), v = nextUnit(&y);
+        if (u != v) return u < v ? -1 : 1;
+        if (u < 0) return 0;
+    }
+}
+
+// Shell sort: in place, no recursion, and objects are mostly small
+static void sortMembers(Member *members, int count)
+{
+    static const int gaps[] = { 701, 301, 132, 57, 23, 10, 4, 1 };
+    for (size_t g = 0; g < sizeof(gaps) / sizeof(gaps[0]); g++) {
+        int gap = gaps[g];
+        for (int i = gap; i < count; i++) {
+            Member member = members[i];
+            int j = i;
+            for (; j >= gap && compareKeys(&members[j - gap], &member) > 0; j -= gap) {
+                members[j] = members[j - gap];
+            }
+            members[j] = member;
+        }
+    }
+}
+
+/* Values --------------------------------------------------------------------*/
+
+static void writeCodePoint(JSONWriter *writer, uint32_t cp)
+{
+    char out[4];
+    size_t n;
+    if (cp < 0x80) {
+        out[0] = (char)cp;
+        n = 1;
+    } else if (cp < 0x800) {
+        out[0] = (char)(0xC0 | (cp >> 6));
+        out[1] = (char)(0x80 | (cp & 0x3F));
+        n = 2;
+    } else if (cp < 0x10000) {
+        out[0] = (char)(0xE0 | (cp >> 12));
+        out[1] = (char)(0x80 | ((cp >> 6) & 0x3F));
+        out[2] = (char)(0x80 | (cp & 0x3F));
+        n = 3;
+    } else {
+        out[0] = (char)(0xF0 | (cp >> 18));
+        out[1] = (char)(0x80 | ((cp >> 12) & 0x3F));
+        out[2] = (char)(0x80 | ((cp >> 6) & 0x3F));
+        out[3] = (char)(0x80 | (cp & 0x3F));
+        n = 4;
+    }
+    JSONWriter_escape(writer, out, n);
+}
+
+// text[0..len) is the raw inside of a string. Runs without escapes are
+// checked and passed on as they are; escapes are decoded and written
+// again the way JSONWriter_escape() has it.
+static RDFStatus writeString(JSONWriter *writer, const char *text, size_t len)
+{
+    const unsigned char *p = (const unsigned char *)text, *end = p + len;
+    JSONWriter_write(writer, "\"", 1);
+    while (p < end) {
+        const unsigned char *run = p;
+        while (p < end && *p != '\\') {
+            uint32_t cp;
+            size_t n = *p < 0x80 ? 1 : decodeUtf8(p, end, &cp);
+            if (n == 0) return RDF_ERR_INVALID;
+            p += n;
+        }
+        JSONWriter_escape(writer, (const char *)run, (size_t)(p - run));
+        if (p == end) break;
+
+        unsigned char escape = p[1];
+        p += 2;
+        if (escape != 'u') {
+            static const char from[] = "bfnrt", to[] = "\b\f\n\r\t";
+            const char *named = memchr(from, escape, sizeof(from) - 1);
+            char ch = named ? to[named - from] : (char)escape;
+            JSONWriter_escape(writer, &ch, 1);
+            continue;
+        }
+        uint32_t cp = readHex4((const char *)p);
+        p += 4;
+        if (cp >= 0xD800 && cp <= 0xDBFF) {
+            uint32_t low = end - p >= 6 && p[0] == '\\' && p[1] == 'u' ? readHex4((const char *)p + 2) : 0;
+            if (low < 0xDC00 || low > 0xDFFF) return RDF_ERR_INVALID;
+            cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+            p += 6;
+        } else if (cp >= 0xDC00 && cp <= 0xDFFF) {
+            return RDF_ERR_INVALID;
+        }
+        writeCodePoint(writer, cp);
+    }
+    JSONWriter_write(writer, "\"", 1);
+    return RDF_OK;
+}
+
+// Step the last of the precision digits of buf, [-]d[.ddd]e(+|-)dd, by
+// delta (+1 or -1) in magnitude into out, carrying into the exponent
+static void stepLastDigit(const char *buf, int precision, int delta, char *out, size_t size)
+{
+    char digits[20];
+    const char *p = buf + (*buf == '-');
+    int k = 0;
+    for (; *p != 'e'; p++) {
+        if (*p != '.') digits[k++] = *p;
+    }
+    int exponent = atoi(p + 1);
+    int i = k - 1;
+    if (delta > 0) {
+        while (i >= 0 && digits[i] == '9') digits[i--] = '0';
+        if (i < 0) {
+            digits[0] = '1';    // 9.99 + 1 ulp is 1.00 one decade up
+            exponent++;
+        } else {
+            digits[i]++;
+        }
+    } else {
+        while (i >= 0 && digits[i] == '0') digits[i--] = '9';
+        digits[i]--;            // digits[0] is never 0
+        if (digits[0] == '0') { // 1.00 - 1 ulp is 9.99 one decade down
+            memmove(digits, digits + 1, (size_t)(k - 1));
+            digits[k - 1] = '9';
+            exponent--;
+        }
+    }
+    snprintf(out, size, "%s%c.%.*se%d", *buf == '-' ? "-" : "", digits[0], precision - 1, digits + 1, exponent);
+}
+
+// value as ECMAScript's Number::toString prints it: the fewest significant
+// digits that read back as value, then laid out plainly below 1e21 and
+// above 1e-7. At each precision %e gives the nearest candidate; when that
+// misses, the one a last-digit step away may still read back, as at powers
+// of two, where the doubles below are twice as close as those above.
+static size_t formatNumber(double value, char *out)
+{
+    char buf[32], step[32], digits[20];
+    if (value == 0) {
+        out[0] = '0';
+        return 1;
+    }
+    for (int precision = 1; precision <= 17; precision++) {
+        snprintf(buf, sizeof(buf), "%.*e", precision - 1, value);
+        double nearest = strtod(buf, NULL);
+        if (nearest == value) break;
+        // Only the step past value can read back: the other is further off
+        stepLastDigit(buf, precision, fabs(nearest) < fabs(value) ? 1 : -1, step, sizeof(step));
+        if (strtod(step, NULL) == value) {
+            memcpy(buf, step, sizeof(buf));
+            break;
+        }
+    }
+
+    // buf is [-]d[.ddd]e(+|-)dd
+    const char *p = buf;
+    size_t n = 0, k = 0;
+    if (*p == '-') out[n++] = *p++;
+    for (; *p != 'e'; p++) {
+        if (*p != '.') digits[k++] = *p;
+    }
+    while (k > 1 && digits[k - 1] == '0') k--;
+    int point = atoi(p + 1) + 1;    // digits[0] is in front of it
+
+    if ((int)k <= point && point <= 21) {
+        memcpy(out + n, digits, k);
+        n += k;
+        for (int i = (int)k; i < point; i++) out[n++] = '0';
+    } else if (0 < point && point <= 21) {
+        memcpy(out + n, digits, (size_t)point);
+        n += (size_t)point;
+        out[n++] = '.';
+        memcpy(out + n, digits + point, k - (size_t)point);
+        n += k - (size_t)point;
+    } else if (-6 < point && point <= 0) {
+        out[n++] = '0';
+        out[n++] = '.';
+        for (int i = point; i < 0; i++) out[n++] = '0';
+        memcpy(out + n, digits, k);
+        n += k;
+    } else {
+        out[n++] = digits[0];
+        if (k > 1) {
+            out[n++] = '.';
+            memcpy(out + n, digits + 1, k - 1);
+            n += k - 1;
+        }
+        n += (size_t)sprintf(out + n, "e%c%d", point - 1 < 0 ? '-' : '+', abs(point - 1));
+    }
+    return n;
+}
+
+static RDFStatus writeNumber(JSONWriter *writer, const char *text, size_t len)
+{
+    // Integers that are exact in a double are printed as they were written,
+    // JSON having no leading zeros; -0 is 0
+    size_t digits = 0;
+    while (digits < len && text[digits] != '.' && text[digits] != 'e' && text[digits] != 'E') digits++;
+    if (digits == len && len - (text[0] == '-') <= 15) {
+        if (len == 2 && text[0] == '-' && text[1] == '0') {
+            text++;
+            len--;
+        }
+        JSONWriter_write(writer, text, len);
+        return RDF_OK;
+    }
+
+    char number[JSON_CANON_NUMBER_MAX + 1], out[32];
+    if (len > JSON_CANON_NUMBER_MAX) {
+        return RDF_ERR_LIMIT;
+    }
+    memcpy(number, text, len);
+    number[len] = '\0';
+    double value = strtod(number, NULL);
+    if (!isfinite(value)) {
+        return RDF_ERR_INVALID;
+    }
+    JSONWriter_write(writer, out, formatNumber(value, out));
+    return RDF_OK;
+}
+
+static RDFStatus writeObject(Canon *canon, const char *p, const char *end)
+{
+    int count = 0;
+    for (const char *q = skipSpace(p + 1); *q != '}'; count++) {
+        q = skipSpace(stringEnd(q) + 1) + 1;
+        q = skipSpace(valueEnd(skipSpace(q), end));
+        if (*q == ',') q = skipSpace(q + 1);
+    }
+
+    size_t mark = canon->scratch->used;
+    Member *members = NULL;
+    if (count > 0) {
+        members = (Member *)RDFArena_alloc(canon->scratch, (size_t)count * sizeof(Member), sizeof(void *));
+        if (!members) return RDF_ERR_ARENA_FULL;
+    }
+    const char *q = skipSpace(p + 1);
+    for (int i = 0; i < count; i++) {
+        const char *close = stringEnd(q);
+        members[i].key = q + 1;
+        members[i].keyLength = (uint32_t)(close - q - 1);
+        members[i].value = skipSpace(skipSpace(close + 1) + 1);
+        q = skipSpace(valueEnd(members[i].value, end));
+        if (*q == ',') q = skipSpace(q + 1);
+    }
+    sortMembers(members, count);
+
+    RDFStatus status = RDF_OK;
+    int written = 0;
+    JSONWriter_write(canon->writer, "{", 1);
+    for (int i = 0; i < count && status == RDF_OK; i++) {
+        if (i > 0 && compareKeys(&members[i - 1], &members[i]) == 0) {
+            status = RDF_ERR_INVALID;
+            break;
+        }
+        if (canon->omit.key && compareKeys(&canon->omit, &members[i]) == 0) {
+            continue;
+        }
+        if (written++ > 0) {
+            JSONWriter_write(canon->writer, ",", 1);
+        }
+        status = writeString(canon->writer, members[i].key, members[i].keyLength);
+        JSONWriter_write(canon->writer, ":", 1);
+        if (status == RDF_OK) status = writeValue(canon, members[i].value, end);
+    }
+    JSONWriter_write(canon->writer, "}", 1);
+    RDFArena_release(canon->scratch, mark);
+    return status;
+}
+
+static RDFStatus writeArray(Canon *canon, const char *p, const char *end)
+{
+    RDFStatus status = RDF_OK;
+    const char *first = skipSpace(p + 1);
+    JSONWriter_write(canon->writer, "[", 1);
+    for (const char *q = first; *q != ']' && status == RDF_OK; ) {
+        if (q != first) JSONWriter_write(canon->writer, ",", 1);
+        status = writeValue(canon, q, end);
+        q = skipSpace(valueEnd(q, end));
+        if (*q == ',') q = skipSpace(q + 1);
+    }
+    JSONWriter_write(canon->writer, "]", 1);
+    return status;
+}
+
+static RDFStatus writeValue(Canon *canon, const char *p, const char *end)
+{
+    switch (*p) {
+    case '{': return writeObject(canon, p, end);
+    case '[': return writeArray(canon, p, end);
+    case '"': return writeString(canon->writer, p + 1, (size_t)(stringEnd(p) - p - 1));
+    case 't': JSONWriter_write(canon->writer, "true", 4); return RDF_OK;
+    case 'f': JSONWriter_write(canon->writer, "false", 5); return RDF_OK;
+    case 'n': JSONWriter_write(canon->writer, "null", 4); return RDF_OK;
+    default: return writeNumber(canon->writer, p, (size_t)(valueEnd(p, end) - p));
+    }
+}
+
+RDFStatus JSONCanon_write(const char *json, size_t length, const char *omit, RDFArena *scratch, JSONWriter *writer)
+{
+    // Checked up front, which also bounds the recursion by JSON_MAX_DEPTH
+    JSONParser parser;
+    JSONParser_init(&parser, json, acceptEvent, NULL);
+    RDFStatus status = JSONParser_feed(&parser, length);
+    if (status != RDF_OK) return status;
+    if (!JSONParser_done(&parser)) return RDF_ERR_INVALID;
+
+    Canon canon = { scratch, writer, { omit, NULL, omit ? (uint32_t)strlen(omit) : 0 } };
+    status = writeValue(&canon, skipSpace(json), json + length);
+    RDFStatus finished = JSONWriter_finish(writer);
+    return status != RDF_OK ? status : finished;
+}
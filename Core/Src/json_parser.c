@@ -0,0 +1,338 @@
+#include "json_parser.h"
+
+#include <string.h>
+
+#if JSON_MAX_DEPTH > 32
+#error "JSON_MAX_DEPTH must fit the 32-bit container stack"
+#endif
+
+typedef enum {
+    STATE_START,         // before the top-level value
+    STATE_VALUE,         // after ':' or ',' in an array
+    STATE_ARRAY_FIRST,   // after '[': a value or ']'
+    STATE_OBJECT_FIRST,  // after '{': a key or '}'
+    STATE_KEY,           // after ',' in an object
+    STATE_COLON,
+    STATE_AFTER_VALUE,   // ',' or the closing bracket
+    STATE_STRING,
+    STATE_NUMBER,
+    STATE_LITERAL,
+    STATE_DONE
+} ParserState;
+
+// substate while in STATE_STRING
+enum { STRING_PLAIN, STRING_ESCAPE, STRING_HEX };  // STRING_HEX + n: n digits read
+
+// substate while in STATE_NUMBER, following the JSON number grammar
+enum {
+    NUMBER_MINUS,        // after '-'
+    NUMBER_ZERO,         // a leading 0, no more integer digits allowed
+    NUMBER_INTEGER,
+    NUMBER_POINT,        // after '.', a digit must follow
+    NUMBER_FRACTION,
+    NUMBER_E,            // after 'e' or 'E'
+    NUMBER_EXPONENT_SIGN,
+    NUMBER_EXPONENT
+};
+
+#define FLAG_KEY     0x01
+#define FLAG_ESCAPED 0x02
+#define LITERAL_SHIFT 4  // flags >> LITERAL_SHIFT indexes literals[]
+
+static const struct {
+    const char *text;
+    JSONEvent event;
+} literals[] = {
+    { "true", JSON_TRUE },
+    { "false", JSON_FALSE },
+    { "null", JSON_NULL }
+};
+
+void JSONParser_init(JSONParser *parser, const char *buffer, JSONHandlerFn handler, void *ctx)
+{
+    memset(parser, 0, sizeof(*parser));
+    parser->buffer = buffer;
+    parser->state = STATE_START;
+    parser->handler = handler;
+    parser->ctx = ctx;
+    parser->status = RDF_OK;
+}
+
+int JSONParser_done(const JSONParser *parser)
+{
+    return parser->state == STATE_DONE;
+}
+
+static void emit(JSONParser *parser, JSONEvent event, size_t start, size_t end)
+{
+    JSONToken token;
+    token.text = parser->buffer + start;
+    token.length = end - start;
+    token.escaped = (parser->flags & FLAG_ESCAPED) != 0;
+    parser->status = parser->handler(parser->ctx, event, &token);
+}
+
+static void afterValue(JSONParser *parser)
+{
+    parser->state = parser->depth == 0 ? STATE_DONE : STATE_AFTER_VALUE;
+}
+
+static int inObject(const JSONParser *parser)
+{
+    return (parser->objects >> (parser->depth - 1)) & 1u;
+}
+
+static void push(JSONParser *parser, int object, size_t at)
+{
+    if (parser->depth >= JSON_MAX_DEPTH) {
+        parser->status = RDF_ERR_LIMIT;
+        return;
+    }
+    if (object) {
+        parser->objects |= 1u << parser->depth;
+    } else {
+        parser->objects &= ~(1u << parser->depth);
+    }
+    parser->depth++;
+    parser->state = object ? STATE_OBJECT_FIRST : STATE_ARRAY_FIRST;
+    parser->flags = 0;
+    emit(parser, object ? JSON_OBJECT_BEGIN : JSON_ARRAY_BEGIN, at, at + 1);
+}
+
+static void pop(JSONParser *parser, char closer, size_t at)
+{
+    int object = closer == '}';
+    if (parser->depth == 0 || inObject(parser) != object) {
+        parser->status = RDF_ERR_INVALID;
+        return;
+    }
+    parser->depth--;
+    afterValue(parser);
+    parser->flags = 0;
+    emit(parser, object ? JSON_OBJECT_END : JSON_ARRAY_END, at, at + 1);
+}
+
+// First byte of a value
+static void beginValue(JSONParser *parser, char c, size_t at)
+{
+    parser->flags = 0;
+    parser->tokenStart = at;
+    switch (c) {
+    case '{':
+        push(parser, 1, at);
+        break;
+    case '[':
+        push(parser, 0, at);
+        break;
+    case '"':
+        parser->tokenStart = at + 1;
+        parser->state = STATE_STRING;
+        parser->substate = STRING_PLAIN;
+        break;
+    case '-':
+        parser->state = STATE_NUMBER;
+        parser->substate = NUMBER_MINUS;
+        break;
+    case 't':
+    case 'f':
+    case 'n':
+        parser->state = STATE_LITERAL;
+        parser->flags = (uint8_t)((c == 't' ? 0 : c == 'f' ? 1 : 2) << LITERAL_SHIFT);
+        parser->substate = 1;
+        break;
+    default:
+        if (c >= '0' && c <= '9') {
+            parser->state = STATE_NUMBER;
+            parser->substate = c == '0' ? NUMBER_ZERO : NUMBER_INTEGER;
+        } else {
+            parser->status = RDF_ERR_INVALID;
+        }
+        break;
+    }
+}
+
+static int isHex(char c)
+{
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+// One byte of a number; returns 0 when c is not part of it
+static int numberByte(JSONParser *parser, char c)
+{
+    int digit = c >= '0' && c <= '9';
+    uint8_t next;
+
+    switch (parser->substate) {
+    case NUMBER_MINUS:
+        next = c == '0' ? NUMBER_ZERO : digit ? NUMBER_INTEGER : 0xFF;
+        break;
+    case NUMBER_ZERO:
+    case NUMBER_INTEGER:
+        if (digit && parser->substate == NUMBER_INTEGER) next = NUMBER_INTEGER;
+        else if (c == '.') next = NUMBER_POINT;
+        else if (c == 'e' || c == 'E') next = NUMBER_E;
+        else return 0;
+        break;
+    case NUMBER_POINT:
+    case NUMBER_FRACTION:
+        if (digit) next = NUMBER_FRACTION;
+        else if (parser->substate == NUMBER_POINT) next = 0xFF;
+        else if (c == 'e' || c == 'E') next = NUMBER_E;
+        else return 0;
+        break;
+    case NUMBER_E:
+        next = digit ? NUMBER_EXPONENT : (c == '+' || c == '-') ? NUMBER_EXPONENT_SIGN : 0xFF;
+        break;
+    case NUMBER_EXPONENT_SIGN:
+        next = digit ? NUMBER_EXPONENT : 0xFF;
+        break;
+    default:
+        if (!digit) return 0;
+        next = NUMBER_EXPONENT;
+        break;
+    }
+    if (next == 0xFF) {
+        parser->status = RDF_ERR_INVALID;
+    } else {
+        parser->substate = next;
+    }
+    return 1;
+}
+
+RDFStatus JSONParser_feed(JSONParser *parser, size_t available)
+{
+    const char *buffer = parser->buffer;
+    size_t i = parser->offset;
+
+    while (parser->status == RDF_OK && i < available) {
+        char c = buffer[i];
+
+        if (parser->state == STATE_STRING) {
+            if (parser->substate == STRING_PLAIN) {
+                // Fast path: most bytes of a string need no attention
+                while (c != '"' && c != '\\' && (unsigned char)c >= 0x20) {
+                    if (++i == available) goto out;
+                    c = buffer[i];
+                }
+                if (c == '"') {
+                    int key = parser->flags & FLAG_KEY;
+                    parser->state = key ? STATE_COLON : STATE_AFTER_VALUE;
+                    emit(parser, key ? JSON_KEY : JSON_STRING, parser->tokenStart, i);
+                } else if (c == '\\') {
+                    parser->flags |= FLAG_ESCAPED;
+                    parser->substate = STRING_ESCAPE;
+                } else {
+                    parser->status = RDF_ERR_INVALID;  // raw control character
+                }
+            } else if (parser->substate == STRING_ESCAPE) {
+                if (c == 'u') {
+                    parser->substate = STRING_HEX;
+                } else if (c != '\0' && strchr("\"\\/bfnrt", c)) {
+                    parser->substate = STRING_PLAIN;
+                } else {
+                    parser->status = RDF_ERR_INVALID;
+                }
+            } else if (isHex(c)) {
+                parser->substate = parser->substate == STRING_HEX + 3 ? STRING_PLAIN : parser->substate + 1;
+            } else {
+                parser->status = RDF_ERR_INVALID;
+            }
+            i++;
+            continue;
+        }
+
+        if (parser->state == STATE_NUMBER) {
+            if (numberByte(parser, c)) {
+                i++;
+                continue;
+            }
+            if (parser->substate != NUMBER_ZERO && parser->substate != NUMBER_INTEGER
+                && parser->substate != NUMBER_FRACTION && parser->substate != NUMBER_EXPONENT) {
+                parser->status = RDF_ERR_INVALID;
+                break;
+            }
+            afterValue(parser);
+            emit(parser, JSON_NUMBER, parser->tokenStart, i);
+            continue;  // c still has to be looked at
+        }
+
+        if (parser->state == STATE_LITERAL) {
+            int literal = parser->flags >> LITERAL_SHIFT;
+            const char *text = literals[literal].text;
+            if (c != text[parser->substate]) {
+                parser->status = RDF_ERR_INVALID;
+                break;
+            }
+            i++;
+            if (text[++parser->substate] == '\0') {
+                afterValue(parser);
+                emit(parser, literals[literal].event, parser->tokenStart, i);
+            }
+            continue;
+        }
+
+        if (c == ' ' || c == '\n' || c == '\r' || c == '\t') {
+            i++;
+            continue;
+        }
+
+        switch (parser->state) {
+        case STATE_START:
+            if (c == '{' || c == '[') {
+                beginValue(parser, c, i);
+            } else {
+                parser->status = RDF_ERR_INVALID;
+            }
+            break;
+        case STATE_ARRAY_FIRST:
+            if (c == ']') {
+                pop(parser, c, i);
+                break;
+            }
+            /* fall through */
+        case STATE_VALUE:
+            beginValue(parser, c, i);
+            break;
+        case STATE_OBJECT_FIRST:
+            if (c == '}') {
+                pop(parser, c, i);
+                break;
+            }
+            /* fall through */
+        case STATE_KEY:
+            if (c == '"') {
+                parser->state = STATE_STRING;
+                parser->substate = STRING_PLAIN;
+                parser->flags = FLAG_KEY;
+                parser->tokenStart = i + 1;
+            } else {
+                parser->status = RDF_ERR_INVALID;
+            }
+            break;
+        case STATE_COLON:
+            if (c == ':') {
+                parser->state = STATE_VALUE;
+            } else {
+                parser->status = RDF_ERR_INVALID;
+            }
+            break;
+        case STATE_AFTER_VALUE:
+            if (c == ',') {
+                parser->state = inObject(parser) ? STATE_KEY : STATE_VALUE;
+            } else if (c == '}' || c == ']') {
+                pop(parser, c, i);
+            } else {
+                parser->status = RDF_ERR_INVALID;
+            }
+            break;
+        default:
+            parser->status = RDF_ERR_INVALID;  // trailing bytes after the document
+            break;
+        }
+        i++;
+    }
+
+out:
+    parser->offset = i;
+    return parser->status;
+}
@@ -0,0 +1,187 @@
+#include "jsonld_context.h"
+
+#include <string.h>
+
+void JSONLDActiveContext_init(JSONLDActiveContext *context)
+{
+    context->count = 0;
+}
+
+RDFStatus JSONLDActiveContext_add(JSONLDActiveContext *context, const char *url, size_t len)
+{
+    for (int id = 0; id < JSONLD_CONTEXT_COUNT; id++) {
+        const JSONLDContextEntry *entry = &JSONLD_contexts[id];
+        if (len != entry->urlLength || memcmp(url, entry->url, len) != 0) continue;
+        if (context->count >= JSONLD_MAX_CONTEXTS) return RDF_ERR_LIMIT;
+        context->ids[context->count++] = (uint8_t)id;
+        return RDF_OK;
+    }
+    return RDF_ERR_INVALID;
+}
+
+int JSONLDActiveContext_aliases(const JSONLDActiveContext *context, uint8_t alias)
+{
+    for (int i = 0; i < context->count; i++) {
+        if (JSONLD_contexts[context->ids[i]].aliases & alias) return 1;
+    }
+    return 0;
+}
+
+static int compareText(const char *a, size_t aLength, const char *b, size_t bLength)
+{
+    int cmp = memcmp(a, b, aLength < bLength ? aLength : bLength);
+    return cmp != 0 ? cmp : (aLength > bLength) - (aLength < bLength);
+}
+
+static const JSONLDTermDefinition *findName(const JSONLDContextEntry *entry, const char *name, size_t len)
+{
+    int low = 0, high = entry->termCount;
+    while (low < high) {
+        int mid = (low + high) / 2;
+        const JSONLDTermDefinition *term = &entry->terms[mid];
+        int cmp = compareText(name, len, term->name, term->nameLength);
+        if (cmp == 0) return term;
+        if (cmp < 0) high = mid;
+        else low = mid + 1;
+    }
+    return NULL;
+}
+
+static const JSONLDTermDefinition *findIri(const JSONLDContextEntry *entry, const char *iri, size_t len)
+{
+    int low = 0, high = entry->termCount;
+    while (low < high) {
+        int mid = (low + high) / 2;
+        const JSONLDTermDefinition *term = &entry->terms[entry->termsByIri[mid]];
+        int cmp = compareText(iri, len, term->iri, term->iriLength);
+        if (cmp == 0) return term;
+        if (cmp < 0) high = mid;
+        else low = mid + 1;
+    }
+    return NULL;
+}
+
+// @vocab of the last context that sets one
+static const JSONLDContextEntry *vocabContext(const JSONLDActiveContext *context)
+{
+    for (int i = context->count - 1; i >= 0; i--) {
+        const JSONLDContextEntry *entry = &JSONLD_contexts[context->ids[i]];
+        if (entry->vocab) return entry;
+    }
+    return NULL;
+}
+
+uint8_t JSONLDActiveContext_expand(const JSONLDActiveContext *context, const char *name, size_t len,
+                                   JSONLDExpansion *out)
+{
+    RDFVocabTerm term = RDFVocab_lookupCompact(name, len);
+    out->term = RDF_VOCAB_NONE;
+    out->iri = NULL;
+    out->iriLength = 0;
+    out->vocabRelative = 0;
+
+    if (len == 4 && memcmp(name, "type", 4) == 0 && JSONLDActiveContext_aliases(context, JSONLD_ALIAS_TYPE)) {
+        out->term = RDF_VOCAB_RDF_TYPE;
+        return out->coercion = JSONLD_COERCE_VOCAB;
+    }
+    if (len == 2 && memcmp(name, "id", 2) == 0 && JSONLDActiveContext_aliases(context, JSONLD_ALIAS_ID)) {
+        return out->coercion = JSONLD_UNDEFINED;  // a keyword, not a term
+    }
+
+    for (int i = context->count - 1; i >= 0; i--) {
+        const JSONLDContextEntry *entry = &JSONLD_contexts[context->ids[i]];
+        if (term != RDF_VOCAB_NONE && entry->coercions[term] != JSONLD_UNDEFINED) {
+            out->term = term;
+            return out->coercion = entry->coercions[term];
+        }
+        const JSONLDTermDefinition *definition = findName(entry, name, len);
+        if (definition) {
+            out->term = RDFVocab_lookupIRI(definition->iri, definition->iriLength);
+            out->iri = definition->iri;
+            out->iriLength = definition->iriLength;
+            return out->coercion = definition->coercion;
+        }
+    }
+
+    // Names with a colon are IRIs, not relative to @vocab
+    const JSONLDContextEntry *entry = vocabContext(context);
+    if (!entry || len == 0 || memchr(name, ':', len)) {
+        return out->coercion = JSONLD_UNDEFINED;
+    }
+    const RDFVocabEntry *vocab = term != RDF_VOCAB_NONE ? &RDFVocab_terms[term] : NULL;
+    if (vocab && vocab->length - vocab->nameLength == entry->vocabLength
+        && memcmp(vocab->iri, entry->vocab, entry->vocabLength) == 0) {
+        out->term = term;
+    } else {
+        out->iri = entry->vocab;
+        out->iriLength = entry->vocabLength;
+        out->vocabRelative = 1;
+    }
+    return out->coercion = JSONLD_COERCE_NONE;
+}
+
+// Non-zero if name is in effect for iri, not shadowed by a later context
+static int expandsTo(const JSONLDActiveContext *context, const char *name, size_t nameLength,
+                     const char *iri, size_t len)
+{
+    JSONLDExpansion expansion;
+    if (JSONLDActiveContext_expand(context, name, nameLength, &expansion) == JSONLD_UNDEFINED) return 0;
+    if (expansion.term != RDF_VOCAB_NONE) {
+        return len == RDFVocab_terms[expansion.term].length && memcmp(iri, RDFVocab_iri(expansion.term), len) == 0;
+    }
+    if (expansion.vocabRelative) {
+        return len == expansion.iriLength + nameLength && memcmp(iri, expansion.iri, expansion.iriLength) == 0
+            && memcmp(iri + expansion.iriLength, name, nameLength) == 0;
+    }
+    return len == expansion.iriLength && memcmp(iri, expansion.iri, len) == 0;
+}
+
+const char *JSONLDActiveContext_compact(const JSONLDActiveContext *context, const char *iri, size_t len,
+                                        RDFVocabTerm term, size_t *nameLength, uint8_t *coercion)
+{
+    if (term == RDF_VOCAB_RDF_TYPE) {
+        *coercion = JSONLD_COERCE_VOCAB;
+        if (!JSONLDActiveContext_aliases(context, JSONLD_ALIAS_TYPE)) {
+            *nameLength = 5;
+            return "@type";
+        }
+        *nameLength = 4;
+        return "type";
+    }
+
+    for (int i = context->count - 1; i >= 0; i--) {
+        const JSONLDContextEntry *entry = &JSONLD_contexts[context->ids[i]];
+        const char *name = NULL;
+        size_t length = 0;
+        uint8_t kind = JSONLD_UNDEFINED;
+        if (term != RDF_VOCAB_NONE && entry->coercions[term] != JSONLD_UNDEFINED) {
+            name = RDFVocab_compact(term);
+            length = RDFVocab_terms[term].nameLength;
+            kind = entry->coercions[term];
+        } else {
+            const JSONLDTermDefinition *definition = findIri(entry, iri, len);
+            if (definition) {
+                name = definition->name;
+                length = definition->nameLength;
+                kind = definition->coercion;
+            }
+        }
+        if (name && kind != JSONLD_COERCE_UNSUPPORTED && expandsTo(context, name, length, iri, len)) {
+            *nameLength = length;
+            *coercion = kind;
+            return name;
+        }
+    }
+
+    const JSONLDContextEntry *entry = vocabContext(context);
+    if (entry && len > entry->vocabLength && memcmp(iri, entry->vocab, entry->vocabLength) == 0) {
+        const char *name = iri + entry->vocabLength;
+        size_t length = len - entry->vocabLength;
+        if (name[0] != '@' && expandsTo(context, name, length, iri, len)) {
+            *nameLength = length;
+            *coercion = JSONLD_COERCE_NONE;
+            return name;
+        }
+    }
+    return NULL;
+}
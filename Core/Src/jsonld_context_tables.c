@@ -0,0 +1,211 @@
+/* Generated by Tools/gen_context.py from Tools/contexts, do not edit. */
+
+#include "jsonld_context.h"
+
+static const uint8_t schemaOrgCoercions[RDF_VOCAB_COUNT] = {
+    [RDF_VOCAB_SCHEMA_URL] = JSONLD_COERCE_ID,
+    [RDF_VOCAB_SCHEMA_IMAGE] = JSONLD_COERCE_ID,
+};
+
+static const JSONLDTermDefinition schemaOrgTerms[2] = {
+    { "sameAs", "http://schema.org/sameAs", 6, 24, JSONLD_COERCE_ID },
+    { "schema", "http://schema.org/", 6, 18, JSONLD_COERCE_NONE },
+};
+
+static const uint8_t schemaOrgTermsByIri[2] = {
+    1, 0,
+};
+
+static const uint8_t securityV1Coercions[RDF_VOCAB_COUNT] = {
+    [RDF_VOCAB_DC_CREATED] = JSONLD_COERCE_DATETIME,
+    [RDF_VOCAB_SEC_ECDSA_KOBLITZ_SIGNATURE2016] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_ED25519_SIGNATURE2018] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_ENCRYPTED_MESSAGE] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_GRAPH_SIGNATURE2012] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_LINKED_DATA_SIGNATURE2015] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_LINKED_DATA_SIGNATURE2016] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_AUTHENTICATION_TAG] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_CANONICALIZATION_ALGORITHM] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_CIPHER_ALGORITHM] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_CIPHER_DATA] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_CIPHER_KEY] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_DIGEST_ALGORITHM] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_DIGEST_VALUE] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_DOMAIN] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_ENCRYPTION_KEY] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_EXPIRATION] = JSONLD_COERCE_DATETIME,
+    [RDF_VOCAB_SEC_INITIALIZATION_VECTOR] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_ITERATION_COUNT] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_NONCE] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_NORMALIZATION_ALGORITHM] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_OWNER] = JSONLD_COERCE_ID,
+    [RDF_VOCAB_SEC_PASSWORD] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_PRIVATE_KEY] = JSONLD_COERCE_ID,
+    [RDF_VOCAB_SEC_PRIVATE_KEY_PEM] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_PUBLIC_KEY] = JSONLD_COERCE_ID,
+    [RDF_VOCAB_SEC_PUBLIC_KEY_BASE58] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_PUBLIC_KEY_PEM] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_PUBLIC_KEY_WIF] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_REVOKED] = JSONLD_COERCE_DATETIME,
+    [RDF_VOCAB_SEC_SALT] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_SIGNATURE] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_SIGNATURE_VALUE] = JSONLD_COERCE_NONE,
+};
+
+static const JSONLDTermDefinition securityV1Terms[8] = {
+    { "CryptographicKey", "https://w3id.org/security#Key", 16, 29, JSONLD_COERCE_NONE },
+    { "creator", "http://purl.org/dc/terms/creator", 7, 32, JSONLD_COERCE_ID },
+    { "dc", "http://purl.org/dc/terms/", 2, 25, JSONLD_COERCE_NONE },
+    { "expires", "https://w3id.org/security#expiration", 7, 36, JSONLD_COERCE_DATETIME },
+    { "publicKeyService", "https://w3id.org/security#publicKeyService", 16, 42, JSONLD_COERCE_ID },
+    { "sec", "https://w3id.org/security#", 3, 26, JSONLD_COERCE_NONE },
+    { "signatureAlgorithm", "https://w3id.org/security#signingAlgorithm", 18, 42, JSONLD_COERCE_NONE },
+    { "xsd", "http://www.w3.org/2001/XMLSchema#", 3, 33, JSONLD_COERCE_NONE },
+};
+
+static const uint8_t securityV1TermsByIri[8] = {
+    2, 1, 7, 5, 0, 3, 4, 6,
+};
+
+static const uint8_t securityV2Coercions[RDF_VOCAB_COUNT] = {
+    [RDF_VOCAB_DC_CREATED] = JSONLD_COERCE_DATETIME,
+    [RDF_VOCAB_SEC_ECDSA_KOBLITZ_SIGNATURE2016] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_ECDSA_SECP256K1_SIGNATURE2019] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_ECDSA_SECP256K1_VERIFICATION_KEY2019] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_ED25519_SIGNATURE2018] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_ED25519_VERIFICATION_KEY2018] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_ENCRYPTED_MESSAGE] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_GRAPH_SIGNATURE2012] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_LINKED_DATA_SIGNATURE2015] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_LINKED_DATA_SIGNATURE2016] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_RSA_SIGNATURE2018] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_RSA_VERIFICATION_KEY2018] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_SCHNORR_SECP256K1_SIGNATURE2019] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_SCHNORR_SECP256K1_VERIFICATION_KEY2019] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_ALLOWED_ACTION] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_ASSERTION_METHOD] = JSONLD_COERCE_ID,
+    [RDF_VOCAB_SEC_AUTHENTICATION_TAG] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_CANONICALIZATION_ALGORITHM] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_CAPABILITY] = JSONLD_COERCE_ID,
+    [RDF_VOCAB_SEC_CAPABILITY_ACTION] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_CAPABILITY_CHAIN] = JSONLD_COERCE_UNSUPPORTED,
+    [RDF_VOCAB_SEC_CAVEAT] = JSONLD_COERCE_ID,
+    [RDF_VOCAB_SEC_CHALLENGE] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_CIPHER_ALGORITHM] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_CIPHER_DATA] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_CIPHER_KEY] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_CIPHERTEXT] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_CONTROLLER] = JSONLD_COERCE_ID,
+    [RDF_VOCAB_SEC_DELEGATOR] = JSONLD_COERCE_ID,
+    [RDF_VOCAB_SEC_DIGEST_ALGORITHM] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_DIGEST_VALUE] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_DOMAIN] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_ENCRYPTION_KEY] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_EXPIRATION] = JSONLD_COERCE_DATETIME,
+    [RDF_VOCAB_SEC_INITIALIZATION_VECTOR] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_INVOCATION_TARGET] = JSONLD_COERCE_ID,
+    [RDF_VOCAB_SEC_INVOKER] = JSONLD_COERCE_ID,
+    [RDF_VOCAB_SEC_ITERATION_COUNT] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_JWS] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_NONCE] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_NORMALIZATION_ALGORITHM] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_OWNER] = JSONLD_COERCE_ID,
+    [RDF_VOCAB_SEC_PARENT_CAPABILITY] = JSONLD_COERCE_ID,
+    [RDF_VOCAB_SEC_PASSWORD] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_PLAINTEXT] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_PRIVATE_KEY] = JSONLD_COERCE_ID,
+    [RDF_VOCAB_SEC_PRIVATE_KEY_PEM] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_PROOF] = JSONLD_COERCE_GRAPH,
+    [RDF_VOCAB_SEC_PROOF_PURPOSE] = JSONLD_COERCE_VOCAB,
+    [RDF_VOCAB_SEC_PROOF_VALUE] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_PUBLIC_KEY] = JSONLD_COERCE_ID,
+    [RDF_VOCAB_SEC_PUBLIC_KEY_BASE58] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_PUBLIC_KEY_PEM] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_PUBLIC_KEY_WIF] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_REVOKED] = JSONLD_COERCE_DATETIME,
+    [RDF_VOCAB_SEC_SALT] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_SIGNATURE] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_SIGNATURE_VALUE] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_VERIFICATION_METHOD] = JSONLD_COERCE_ID,
+    [RDF_VOCAB_SEC_VERIFY_DATA] = JSONLD_COERCE_NONE,
+};
+
+static const JSONLDTermDefinition securityV2Terms[12] = {
+    { "CryptographicKey", "https://w3id.org/security#Key", 16, 29, JSONLD_COERCE_NONE },
+    { "authentication", "https://w3id.org/security#authenticationMethod", 14, 46, JSONLD_COERCE_ID },
+    { "capabilityDelegation", "https://w3id.org/security#capabilityDelegationMethod", 20, 52, JSONLD_COERCE_ID },
+    { "capabilityInvocation", "https://w3id.org/security#capabilityInvocationMethod", 20, 52, JSONLD_COERCE_ID },
+    { "creator", "http://purl.org/dc/terms/creator", 7, 32, JSONLD_COERCE_ID },
+    { "dc", "http://purl.org/dc/terms/", 2, 25, JSONLD_COERCE_NONE },
+    { "expires", "https://w3id.org/security#expiration", 7, 36, JSONLD_COERCE_DATETIME },
+    { "keyAgreement", "https://w3id.org/security#keyAgreementMethod", 12, 44, JSONLD_COERCE_ID },
+    { "publicKeyService", "https://w3id.org/security#publicKeyService", 16, 42, JSONLD_COERCE_ID },
+    { "sec", "https://w3id.org/security#", 3, 26, JSONLD_COERCE_NONE },
+    { "signatureAlgorithm", "https://w3id.org/security#signingAlgorithm", 18, 42, JSONLD_COERCE_NONE },
+    { "xsd", "http://www.w3.org/2001/XMLSchema#", 3, 33, JSONLD_COERCE_NONE },
+};
+
+static const uint8_t securityV2TermsByIri[12] = {
+    5, 4, 11, 9, 0, 1, 2, 3, 6, 7, 8, 10,
+};
+
+static const uint8_t credentialsV1Coercions[RDF_VOCAB_COUNT] = {
+    [RDF_VOCAB_DC_CREATED] = JSONLD_COERCE_DATETIME,
+    [RDF_VOCAB_SEC_ECDSA_SECP256K1_SIGNATURE2019] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_ASSERTION_METHOD] = JSONLD_COERCE_ID,
+    [RDF_VOCAB_SEC_CHALLENGE] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_DOMAIN] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_JWS] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_NONCE] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_PROOF] = JSONLD_COERCE_GRAPH,
+    [RDF_VOCAB_SEC_PROOF_PURPOSE] = JSONLD_COERCE_VOCAB,
+    [RDF_VOCAB_SEC_PROOF_VALUE] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_SEC_VERIFICATION_METHOD] = JSONLD_COERCE_ID,
+    [RDF_VOCAB_CRED_VERIFIABLE_CREDENTIAL] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_CRED_VERIFIABLE_PRESENTATION] = JSONLD_COERCE_NONE,
+    [RDF_VOCAB_CRED_CREDENTIAL_SUBJECT] = JSONLD_COERCE_ID,
+    [RDF_VOCAB_CRED_CREDENTIAL_STATUS] = JSONLD_COERCE_ID,
+    [RDF_VOCAB_CRED_CREDENTIAL_SCHEMA] = JSONLD_COERCE_ID,
+    [RDF_VOCAB_CRED_EVIDENCE] = JSONLD_COERCE_ID,
+    [RDF_VOCAB_CRED_EXPIRATION_DATE] = JSONLD_COERCE_DATETIME,
+    [RDF_VOCAB_CRED_HOLDER] = JSONLD_COERCE_ID,
+    [RDF_VOCAB_CRED_ISSUANCE_DATE] = JSONLD_COERCE_DATETIME,
+    [RDF_VOCAB_CRED_ISSUER] = JSONLD_COERCE_ID,
+    [RDF_VOCAB_CRED_REFRESH_SERVICE] = JSONLD_COERCE_ID,
+    [RDF_VOCAB_CRED_TERMS_OF_USE] = JSONLD_COERCE_ID,
+    [RDF_VOCAB_CRED_VERIFIABLE_CREDENTIAL_PROPERTY] = JSONLD_COERCE_GRAPH,
+};
+
+static const JSONLDTermDefinition credentialsV1Terms[8] = {
+    { "authentication", "https://w3id.org/security#authenticationMethod", 14, 46, JSONLD_COERCE_ID },
+    { "cred", "https://www.w3.org/2018/credentials#", 4, 36, JSONLD_COERCE_NONE },
+    { "expires", "https://w3id.org/security#expiration", 7, 36, JSONLD_COERCE_DATETIME },
+    { "issued", "https://www.w3.org/2018/credentials#issued", 6, 42, JSONLD_COERCE_DATETIME },
+    { "sec", "https://w3id.org/security#", 3, 26, JSONLD_COERCE_NONE },
+    { "validFrom", "https://www.w3.org/2018/credentials#validFrom", 9, 45, JSONLD_COERCE_DATETIME },
+    { "validUntil", "https://www.w3.org/2018/credentials#validUntil", 10, 46, JSONLD_COERCE_DATETIME },
+    { "xsd", "http://www.w3.org/2001/XMLSchema#", 3, 33, JSONLD_COERCE_NONE },
+};
+
+static const uint8_t credentialsV1TermsByIri[8] = {
+    7, 4, 0, 2, 1, 3, 5, 6,
+};
+
+const JSONLDContextEntry JSONLD_contexts[JSONLD_CONTEXT_COUNT] = {
+    [JSONLD_CONTEXT_SCHEMA_ORG] = {
+        JSONLD_URL_SCHEMA_ORG, 18, JSONLD_ALIAS_ID | JSONLD_ALIAS_TYPE,
+        "http://schema.org/", 18, schemaOrgCoercions, schemaOrgTerms, schemaOrgTermsByIri, 2
+    },
+    [JSONLD_CONTEXT_SECURITY_V1] = {
+        JSONLD_URL_SECURITY_V1, 28, JSONLD_ALIAS_ID | JSONLD_ALIAS_TYPE,
+        NULL, 0, securityV1Coercions, securityV1Terms, securityV1TermsByIri, 8
+    },
+    [JSONLD_CONTEXT_SECURITY_V2] = {
+        JSONLD_URL_SECURITY_V2, 28, JSONLD_ALIAS_ID | JSONLD_ALIAS_TYPE,
+        NULL, 0, securityV2Coercions, securityV2Terms, securityV2TermsByIri, 12
+    },
+    [JSONLD_CONTEXT_CREDENTIALS_V1] = {
+        JSONLD_URL_CREDENTIALS_V1, 38, JSONLD_ALIAS_ID | JSONLD_ALIAS_TYPE,
+        NULL, 0, credentialsV1Coercions, credentialsV1Terms, credentialsV1TermsByIri, 8
+    },
+};
@@ -0,0 +1,598 @@
+#include "jsonld_reader.h"
+#include "jsonld_context.h"
+#include "rdf_vocab.h"
+
+#include <string.h>
+
+static RDFStatus handleEvent(void *ctx, JSONEvent event, const JSONToken *token);
+
+// contextState: where in the value of @context the reader is
+enum { CONTEXT_NONE, CONTEXT_VALUE, CONTEXT_ARRAY };
+
+// valueState: a node object, or which member of a value object comes next.
+// The literal is assembled in reader->term as the members arrive.
+enum { VALUE_NONE, VALUE_LEXICAL, VALUE_READ, VALUE_LANGUAGE, VALUE_TYPE, VALUE_ANNOTATED };
+
+void JSONLDReader_init(JSONLDReader *reader, RDFGraph *graph, const char *buffer)
+{
+    JSONParser_init(&reader->parser, buffer, handleEvent, reader);
+    reader->graph = graph;
+    JSONLDActiveContext_init(&reader->context);
+    reader->contextState = CONTEXT_NONE;
+    reader->depth = 0;
+    reader->skip = 0;
+    reader->skipNext = 0;
+    reader->blankNodes = 0;
+    reader->termLength = 0;
+}
+
+RDFStatus JSONLDReader_feed(JSONLDReader *reader, size_t available)
+{
+    return JSONParser_feed(&reader->parser, available);
+}
+
+int JSONLDReader_done(const JSONLDReader *reader)
+{
+    return JSONParser_done(&reader->parser);
+}
+
+/* Terms ---------------------------------------------------------------------*/
+
+static RDFStatus internFailure(const RDFGraph *graph)
+{
+    return graph->termCount >= RDF_MAX_TERMS ? RDF_ERR_TERMS_FULL : RDF_ERR_ARENA_FULL;
+}
+
+static RDFStatus append(JSONLDReader *reader, const char *data, size_t len)
+{
+    if (len > sizeof(reader->term) - reader->termLength) {
+        return RDF_ERR_LIMIT;
+    }
+    memcpy(reader->term + reader->termLength, data, len);
+    reader->termLength += len;
+    return RDF_OK;
+}
+
+static int hexValue(char c)
+{
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return c - 'A' + 10;
+}
+
+static uint32_t readHex4(const char *s)
+{
+    return (uint32_t)(hexValue(s[0]) << 12 | hexValue(s[1]) << 8 | hexValue(s[2]) << 4 | hexValue(s[3]));
+}
+
+// Next code point of a JSON string the tokenizer has validated, or
+// 0xFFFFFFFF for an unpaired surrogate
+static uint32_t nextCodePoint(const char **p, const char *end, int *raw)
+{
+    const char *s = *p;
+    *raw = *s != '\\';
+    if (*raw) {
+        *p = s + 1;
+        return (unsigned char)*s;
+    }
+    *p = s + 2;
+    switch (s[1]) {
+    case 'b': return '\b';
+    case 'f': return '\f';
+    case 'n': return '\n';
+    case 'r': return '\r';
+    case 't': return '\t';
+    case 'u': break;
+    default: return (unsigned char)s[1];
+    }
+
+    uint32_t cp = readHex4(s + 2);
+    *p = s + 6;
+    if (cp >= 0xDC00 && cp <= 0xDFFF) return 0xFFFFFFFFu;
+    if (cp >= 0xD800 && cp <= 0xDBFF) {
+        if (end - *p < 6 || (*p)[0] != '\\' || (*p)[1] != 'u') return 0xFFFFFFFFu;
+        uint32_t low = readHex4(*p + 2);
+        if (low < 0xDC00 || low > 0xDFFF) return 0xFFFFFFFFu;
+        *p += 6;
+        cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+    }
+    return cp;
+}
+
+static RDFStatus appendUtf8(JSONLDReader *reader, uint32_t cp)
+{
+    char out[4];
+    size_t n;
+    if (cp < 0x80) {
+        out[0] = (char)cp;
+        n = 1;
+    } else if (cp < 0x800) {
+        out[0] = (char)(0xC0 | (cp >> 6));
+        out[1] = (char)(0x80 | (cp & 0x3F));
+        n = 2;
+    } else if (cp < 0x10000) {
+        out[0] = (char)(0xE0 | (cp >> 12));
+        out[1] = (char)(0x80 | ((cp >> 6) & 0x3F));
+        out[2] = (char)(0x80 | (cp & 0x3F));
+        n = 3;
+    } else {
+        out[0] = (char)(0xF0 | (cp >> 18));
+        out[1] = (char)(0x80 | ((cp >> 12) & 0x3F));
+        out[2] = (char)(0x80 | ((cp >> 6) & 0x3F));
+        out[3] = (char)(0x80 | (cp & 0x3F));
+        n = 4;
+    }
+    return append(reader, out, n);
+}
+
+// Append a JSON string's value, unescaped; as a literal's lexical form it
+// gets the canonical N-Quads escapes instead
+static RDFStatus appendString(JSONLDReader *reader, const JSONToken *token, int lexical)
+{
+    static const char hexDigits[] = "0123456789ABCDEF";
+    const char *p = token->text;
+    const char *end = token->text + token->length;
+    RDFStatus status = RDF_OK;
+
+    while (status == RDF_OK && p < end) {
+        int raw;
+        uint32_t cp = nextCodePoint(&p, end, &raw);
+        if (cp == 0xFFFFFFFFu) return RDF_ERR_INVALID;
+
+        const char *echar = !lexical ? NULL
+                          : cp == '"' ? "\\\"" : cp == '\\' ? "\\\\" : cp == '\n' ? "\\n"
+                          : cp == '\r' ? "\\r" : cp == '\b' ? "\\b" : cp == '\t' ? "\\t"
+                          : cp == '\f' ? "\\f" : NULL;
+        if (echar) {
+            status = append(reader, echar, 2);
+        } else if (lexical && (cp < 0x20 || cp == 0x7F)) {
+            char uchar[6] = { '\\', 'u', '0', '0', hexDigits[cp >> 4], hexDigits[cp & 0x0F] };
+            status = append(reader, uchar, sizeof(uchar));
+        } else if (raw) {
+            status = append(reader, p - 1, 1);  // UTF-8 bytes pass through
+        } else {
+            status = appendUtf8(reader, cp);
+        }
+    }
+    return status;
+}
+
+static RDFTermId internScratch(JSONLDReader *reader)
+{
+    return RDFGraph_intern(reader->graph, reader->term, reader->termLength);
+}
+
+// "lexical"^^<datatype> with lexical taken from a JSON string or number
+static RDFStatus typedLiteral(JSONLDReader *reader, const JSONToken *token, int string,
+                              RDFVocabTerm datatype, RDFTermId *out)
+{
+    RDFStatus status;
+    reader->termLength = 0;
+    status = append(reader, "\"", 1);
+    if (status == RDF_OK) {
+        status = string ? appendString(reader, token, 1) : append(reader, token->text, token->length);
+    }
+    if (status == RDF_OK) status = append(reader, "\"^^<", 4);
+    if (status == RDF_OK) status = append(reader, RDFVocab_iri(datatype), RDFVocab_terms[datatype].length);
+    if (status == RDF_OK) status = append(reader, ">", 1);
+    if (status != RDF_OK) return status;
+
+    *out = internScratch(reader);
+    return *out == RDF_NO_TERM ? internFailure(reader->graph) : RDF_OK;
+}
+
+// An IRI given by a JSON string; zero-copy unless it has escapes
+static RDFStatus iriTerm(JSONLDReader *reader, const JSONToken *token, RDFTermId *out)
+{
+    if (!token->escaped) {
+        *out = RDFGraph_internRef(reader->graph, token->text, token->length);
+    } else {
+        reader->termLength = 0;
+        RDFStatus status = appendString(reader, token, 0);
+        if (status != RDF_OK) return status;
+        *out = internScratch(reader);
+    }
+    return *out == RDF_NO_TERM ? internFailure(reader->graph) : RDF_OK;
+}
+
+static RDFStatus vocabTerm(JSONLDReader *reader, RDFVocabTerm term, RDFTermId *out)
+{
+    *out = RDFGraph_internRef(reader->graph, RDFVocab_iri(term), RDFVocab_terms[term].length);
+    return *out == RDF_NO_TERM ? internFailure(reader->graph) : RDF_OK;
+}
+
+// What a key or @type value expanded to: a vocabulary term, a term
+// definition's IRI, or @vocab followed by the name
+static RDFStatus expandedTerm(JSONLDReader *reader, const JSONLDExpansion *expansion, const JSONToken *token,
+                              RDFTermId *out)
+{
+    if (expansion->term != RDF_VOCAB_NONE) {
+        return vocabTerm(reader, expansion->term, out);
+    }
+    if (!expansion->vocabRelative) {
+        *out = RDFGraph_internRef(reader->graph, expansion->iri, expansion->iriLength);
+    } else {
+        reader->termLength = 0;
+        RDFStatus status = append(reader, expansion->iri, expansion->iriLength);
+        if (status == RDF_OK) status = appendString(reader, token, 0);
+        if (status != RDF_OK) return status;
+        *out = internScratch(reader);
+    }
+    return *out == RDF_NO_TERM ? internFailure(reader->graph) : RDF_OK;
+}
+
+// A plain literal. The JSON string with its quotes is already a literal
+// in canonical N-Quads form when it has no escapes and no DEL.
+static RDFStatus literalTerm(JSONLDReader *reader, const JSONToken *token, RDFTermId *out)
+{
+    if (!token->escaped && !memchr(token->text, 0x7F, token->length)) {
+        *out = RDFGraph_internRef(reader->graph, token->text - 1, token->length + 2);
+    } else {
+        reader->termLength = 0;
+        RDFStatus status = append(reader, "\"", 1);
+        if (status == RDF_OK) status = appendString(reader, token, 1);
+        if (status == RDF_OK) status = append(reader, "\"", 1);
+        if (status != RDF_OK) return status;
+        *out = internScratch(reader);
+    }
+    return *out == RDF_NO_TERM ? internFailure(reader->graph) : RDF_OK;
+}
+
+static RDFStatus blankNode(JSONLDReader *reader, RDFTermId *out)
+{
+    char label[16] = "_:b";
+    size_t n = 3;
+    char digits[10];
+    size_t count = 0;
+    unsigned value = reader->blankNodes++;
+    do {
+        digits[count++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value);
+    while (count) label[n++] = digits[--count];
+
+    *out = RDFGraph_intern(reader->graph, label, n);
+    return *out == RDF_NO_TERM ? internFailure(reader->graph) : RDF_OK;
+}
+
+/* Nodes ---------------------------------------------------------------------*/
+
+// Fix the node's subject, a fresh blank node unless @id gave one, and
+// link the node to its parent
+static RDFStatus decideSubject(JSONLDReader *reader, JSONLDFrame *frame, RDFTermId subject)
+{
+    RDFStatus status = RDF_OK;
+    if (subject == RDF_NO_TERM) {
+        status = blankNode(reader, &subject);
+        if (status != RDF_OK) return status;
+    }
+    frame->subject = subject;
+    if (frame->parent != RDF_NO_TERM) {
+        JSONLDFrame *parent = frame - 1;
+        status = RDFGraph_addQuadIds(reader->graph, frame->parent, frame->parentProperty, subject, parent->graph);
+    }
+    return status;
+}
+
+static RDFStatus beginNode(JSONLDReader *reader)
+{
+    if (reader->depth >= JSONLD_MAX_DEPTH) {
+        return RDF_ERR_LIMIT;
+    }
+    JSONLDFrame *frame = &reader->frames[reader->depth];
+    frame->subject = RDF_NO_TERM;
+    frame->graph = RDF_NO_TERM;
+    frame->parent = RDF_NO_TERM;
+    frame->parentProperty = RDF_NO_TERM;
+    frame->property = RDF_NO_TERM;
+    frame->coercion = JSONLD_COERCE_NONE;
+    frame->expectId = 0;
+    frame->valueState = VALUE_NONE;
+    frame->nodes = 0;
+
+    if (reader->depth > 0) {
+        JSONLDFrame *parent = frame - 1;
+        frame->graph = parent->graph;
+        frame->parent = parent->subject;
+        frame->parentProperty = parent->property;
+        if (parent->coercion == JSONLD_COERCE_GRAPH) {
+            // The link points at the graph, which holds the node
+            RDFStatus status = blankNode(reader, &frame->graph);
+            if (status == RDF_OK) {
+                status = RDFGraph_addQuadIds(reader->graph, parent->subject, parent->property, frame->graph, parent->graph);
+            }
+            if (status != RDF_OK) return status;
+            frame->parent = RDF_NO_TERM;
+        }
+    }
+    reader->depth++;
+    return RDF_OK;
+}
+
+static int isKeyword(const JSONToken *token, const char *keyword)
+{
+    size_t len = strlen(keyword);
+    return token->length == len && memcmp(token->text, keyword, len) == 0;
+}
+
+// Keys of a value object: @value came first, @language or @type may follow
+static RDFStatus readValueKey(JSONLDFrame *frame, const JSONToken *token)
+{
+    if (frame->valueState != VALUE_READ) return RDF_ERR_INVALID;
+    if (isKeyword(token, "@language")) {
+        frame->valueState = VALUE_LANGUAGE;
+    } else if (isKeyword(token, "@type")) {
+        frame->valueState = VALUE_TYPE;
+    } else {
+        return RDF_ERR_INVALID;
+    }
+    return RDF_OK;
+}
+
+static RDFStatus readKey(JSONLDReader *reader, JSONLDFrame *frame, const JSONToken *token)
+{
+    RDFStatus status = RDF_OK;
+
+    if (frame->valueState != VALUE_NONE) {
+        return readValueKey(frame, token);
+    }
+    if (frame->nodes) {
+        return RDF_ERR_INVALID;  // @graph is the last key
+    }
+    if (isKeyword(token, "@value")) {
+        // Only as the first key of an object that is a property's value
+        if (frame->subject != RDF_NO_TERM || frame->parent == RDF_NO_TERM) return RDF_ERR_INVALID;
+        frame->valueState = VALUE_LEXICAL;
+        return RDF_OK;
+    }
+    if (isKeyword(token, "@id")
+        || (isKeyword(token, "id") && JSONLDActiveContext_aliases(&reader->context, JSONLD_ALIAS_ID))) {
+        if (frame->subject != RDF_NO_TERM) return RDF_ERR_INVALID;  // @id must come first
+        frame->expectId = 1;
+        return RDF_OK;
+    }
+    if (isKeyword(token, "@context")) {
+        // Keys read so far were expanded without it
+        if (reader->depth != 1 || frame->subject != RDF_NO_TERM) return RDF_ERR_INVALID;
+        reader->contextState = CONTEXT_VALUE;
+        return RDF_OK;
+    }
+    if (isKeyword(token, "@graph") && reader->depth == 1 && frame->subject == RDF_NO_TERM) {
+        // The document's nodes, each top-level, when there are several
+        frame->nodes = 1;
+        return RDF_OK;
+    }
+    if (frame->subject == RDF_NO_TERM) {
+        status = decideSubject(reader, frame, RDF_NO_TERM);
+        if (status != RDF_OK) return status;
+    }
+
+    if (isKeyword(token, "@type")) {
+        frame->coercion = JSONLD_COERCE_VOCAB;
+        return vocabTerm(reader, RDF_VOCAB_RDF_TYPE, &frame->property);
+    }
+    // Before expansion, which would make @vocab + "@graph" an IRI
+    if (token->length > 0 && token->text[0] == '@') {
+        return RDF_ERR_INVALID;  // @graph, @list, @reverse, @value out of place, ...
+    }
+    JSONLDExpansion expansion;
+    uint8_t coercion = token->escaped ? JSONLD_UNDEFINED
+                     : JSONLDActiveContext_expand(&reader->context, token->text, token->length, &expansion);
+    if (coercion == JSONLD_COERCE_UNSUPPORTED) {
+        return RDF_ERR_INVALID;
+    }
+    if (coercion != JSONLD_UNDEFINED) {
+        frame->coercion = coercion;
+        return expandedTerm(reader, &expansion, token, &frame->property);
+    }
+    if (memchr(token->text, ':', token->length)) {
+        frame->coercion = JSONLD_COERCE_NONE;
+        return iriTerm(reader, token, &frame->property);
+    }
+    reader->skipNext = 1;  // not in the context: JSON-LD drops it
+    return RDF_OK;
+}
+
+// BCP 47 as N-Quads has it: letters, then groups of letters and digits
+static int isLanguageTag(const JSONToken *token)
+{
+    size_t run = 0;
+    for (size_t i = 0; i < token->length; i++) {
+        char c = token->text[i];
+        int letter = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+        int digit = c >= '0' && c <= '9';
+        if (c == '-' && run > 0 && i + 1 < token->length) {
+            run = 0;
+        } else if (letter || (digit && i > run)) {
+            run++;
+        } else {
+            return 0;
+        }
+    }
+    return run > 0;
+}
+
+// A datatype IRI, absolute or expanded like @type values of nodes
+static RDFStatus appendDatatype(JSONLDReader *reader, const JSONToken *token)
+{
+    if (token->escaped || memchr(token->text, ':', token->length)) {
+        return appendString(reader, token, 0);
+    }
+    JSONLDExpansion expansion;
+    if (JSONLDActiveContext_expand(&reader->context, token->text, token->length, &expansion) == JSONLD_UNDEFINED) {
+        return RDF_ERR_INVALID;
+    }
+    if (expansion.term != RDF_VOCAB_NONE) {
+        return append(reader, RDFVocab_iri(expansion.term), RDFVocab_terms[expansion.term].length);
+    }
+    RDFStatus status = append(reader, expansion.iri, expansion.iriLength);
+    if (status == RDF_OK && expansion.vocabRelative) status = append(reader, token->text, token->length);
+    return status;
+}
+
+// The members of a value object, each a string
+static RDFStatus readValueMember(JSONLDReader *reader, JSONLDFrame *frame, JSONEvent event, const JSONToken *token)
+{
+    RDFStatus status = RDF_OK;
+    if (event != JSON_STRING) return RDF_ERR_INVALID;
+    switch (frame->valueState) {
+    case VALUE_LEXICAL:
+        reader->termLength = 0;
+        status = append(reader, "\"", 1);
+        if (status == RDF_OK) status = appendString(reader, token, 1);
+        if (status == RDF_OK) status = append(reader, "\"", 1);
+        frame->valueState = VALUE_READ;
+        return status;
+    case VALUE_LANGUAGE:
+        if (!isLanguageTag(token)) return RDF_ERR_INVALID;
+        status = append(reader, "@", 1);
+        if (status == RDF_OK) status = append(reader, token->text, token->length);
+        break;
+    case VALUE_TYPE:
+        status = append(reader, "^^<", 3);
+        if (status == RDF_OK) status = appendDatatype(reader, token);
+        if (status == RDF_OK) status = append(reader, ">", 1);
+        break;
+    default:
+        return RDF_ERR_INVALID;
+    }
+    frame->valueState = VALUE_ANNOTATED;
+    return status;
+}
+
+// The literal a value object stands for, as the value of its parent's property
+static RDFStatus endValueObject(JSONLDReader *reader, JSONLDFrame *frame)
+{
+    if (frame->valueState != VALUE_READ && frame->valueState != VALUE_ANNOTATED) return RDF_ERR_INVALID;
+    RDFTermId object = internScratch(reader);
+    if (object == RDF_NO_TERM) return internFailure(reader->graph);
+    return RDFGraph_addQuadIds(reader->graph, frame->parent, frame->parentProperty, object, (frame - 1)->graph);
+}
+
+static RDFStatus readValue(JSONLDReader *reader, JSONLDFrame *frame, JSONEvent event, const JSONToken *token)
+{
+    RDFTermId object = RDF_NO_TERM;
+    RDFStatus status = RDF_OK;
+
+    if (frame->valueState != VALUE_NONE) {
+        return readValueMember(reader, frame, event, token);
+    }
+    if (frame->expectId) {
+        frame->expectId = 0;
+        if (event != JSON_STRING) return RDF_ERR_INVALID;
+        status = iriTerm(reader, token, &object);
+        return status == RDF_OK ? decideSubject(reader, frame, object) : status;
+    }
+
+    switch (event) {
+    case JSON_STRING:
+        switch (frame->coercion) {
+        case JSONLD_COERCE_VOCAB: {
+            JSONLDExpansion expansion;
+            uint8_t coercion = token->escaped ? JSONLD_UNDEFINED
+                             : JSONLDActiveContext_expand(&reader->context, token->text, token->length, &expansion);
+            status = coercion != JSONLD_UNDEFINED ? expandedTerm(reader, &expansion, token, &object)
+                                                  : iriTerm(reader, token, &object);
+            break;
+        }
+        case JSONLD_COERCE_ID:
+        case JSONLD_COERCE_GRAPH:
+            status = iriTerm(reader, token, &object);
+            break;
+        case JSONLD_COERCE_DATETIME:
+            status = typedLiteral(reader, token, 1, RDF_VOCAB_XSD_DATE_TIME, &object);
+            break;
+        default:
+            status = literalTerm(reader, token, &object);
+            break;
+        }
+        break;
+    case JSON_NUMBER:
+        // The canonical xsd:double form needs floating-point formatting
+        if (memchr(token->text, '.', token->length) || memchr(token->text, 'e', token->length)
+            || memchr(token->text, 'E', token->length)) {
+            return RDF_ERR_INVALID;
+        }
+        status = typedLiteral(reader, token, 0, RDF_VOCAB_XSD_INTEGER, &object);
+        break;
+    case JSON_TRUE:
+    case JSON_FALSE:
+        status = typedLiteral(reader, token, 0, RDF_VOCAB_XSD_BOOLEAN, &object);
+        break;
+    default:
+        return RDF_OK;  // null
+    }
+    if (status != RDF_OK) return status;
+    return RDFGraph_addQuadIds(reader->graph, frame->subject, frame->property, object, frame->graph);
+}
+
+// The value of @context: a context URL, an array of them, or null
+static RDFStatus readContext(JSONLDReader *reader, JSONEvent event, const JSONToken *token)
+{
+    int single = reader->contextState == CONTEXT_VALUE;
+    switch (event) {
+    case JSON_STRING:
+        if (single) reader->contextState = CONTEXT_NONE;
+        if (token->escaped) return RDF_ERR_INVALID;
+        return JSONLDActiveContext_add(&reader->context, token->text, token->length);
+    case JSON_NULL:
+        if (single) reader->contextState = CONTEXT_NONE;
+        JSONLDActiveContext_init(&reader->context);
+        return RDF_OK;
+    case JSON_ARRAY_BEGIN:
+        if (!single) return RDF_ERR_INVALID;
+        reader->contextState = CONTEXT_ARRAY;
+        return RDF_OK;
+    case JSON_ARRAY_END:
+        reader->contextState = CONTEXT_NONE;
+        return RDF_OK;
+    default:
+        return RDF_ERR_INVALID;  // inline contexts are not compiled in
+    }
+}
+
+static RDFStatus handleEvent(void *ctx, JSONEvent event, const JSONToken *token)
+{
+    JSONLDReader *reader = (JSONLDReader *)ctx;
+    int begin = event == JSON_OBJECT_BEGIN || event == JSON_ARRAY_BEGIN;
+    int end = event == JSON_OBJECT_END || event == JSON_ARRAY_END;
+
+    if (reader->contextState != CONTEXT_NONE) {
+        return readContext(reader, event, token);
+    }
+    if (reader->skip > 0) {
+        reader->skip += begin - end;
+        return RDF_OK;
+    }
+    if (reader->skipNext) {
+        reader->skipNext = 0;
+        reader->skip = begin;
+        return RDF_OK;
+    }
+
+    JSONLDFrame *frame = reader->depth > 0 ? &reader->frames[reader->depth - 1] : NULL;
+    switch (event) {
+    case JSON_OBJECT_BEGIN:
+        if (frame && (frame->expectId || frame->valueState != VALUE_NONE)) return RDF_ERR_INVALID;
+        return beginNode(reader);
+    case JSON_OBJECT_END:
+        if (frame->valueState != VALUE_NONE) {
+            RDFStatus status = endValueObject(reader, frame);
+            if (status != RDF_OK) return status;
+        } else if (frame->subject == RDF_NO_TERM && !frame->nodes) {
+            RDFStatus status = decideSubject(reader, frame, RDF_NO_TERM);
+            if (status != RDF_OK) return status;
+        }
+        reader->depth--;
+        return RDF_OK;
+    case JSON_ARRAY_BEGIN:
+    case JSON_ARRAY_END:
+        // Arrays only repeat the property they are the value of
+        return frame && (frame->expectId || frame->valueState != VALUE_NONE) ? RDF_ERR_INVALID : RDF_OK;
+    case JSON_KEY:
+        return readKey(reader, frame, token);
+    default:
+        if (!frame || frame->nodes) return RDF_ERR_INVALID;  // a scalar in a top-level array or @graph
+        return readValue(reader, frame, event, token);
+    }
+}
@@ -0,0 +1,620 @@
+#include "jsonld_writer.h"
+#include "jsonld_context.h"
+#include "rdf_vocab.h"
+
+#include <string.h>
+
+// size counts the terminating NUL when there is no sink to flush to
+void JSONWriter_init(JSONWriter *writer, char *buffer, size_t size, RDFSinkFn sink, void *ctx)
+{
+    writer->buffer = buffer;
+    writer->capacity = buffer && !sink && size > 0 ? size - 1 : size;
+    writer->length = 0;
+    writer->total = 0;
+    writer->sink = sink;
+    writer->ctx = ctx;
+    writer->status = RDF_OK;
+}
+
+static void flush(JSONWriter *writer)
+{
+    if (writer->length > 0) {
+        writer->sink(writer->ctx, writer->buffer, writer->length);
+        writer->length = 0;
+    }
+}
+
+void JSONWriter_write(JSONWriter *writer, const char *data, size_t len)
+{
+    writer->total += len;
+    if (!writer->buffer || writer->status != RDF_OK) return;
+
+    while (len > writer->capacity - writer->length) {
+        if (!writer->sink || writer->capacity == 0) {
+            writer->status = RDF_ERR_OVERFLOW;
+            return;
+        }
+        size_t room = writer->capacity - writer->length;
+        memcpy(writer->buffer + writer->length, data, room);
+        writer->length += room;
+        data += room;
+        len -= room;
+        flush(writer);
+    }
+    memcpy(writer->buffer + writer->length, data, len);
+    writer->length += len;
+}
+
+void JSONWriter_puts(JSONWriter *writer, const char *str)
+{
+    JSONWriter_write(writer, str, strlen(str));
+}
+
+// Bytes JSON strings cannot hold as they are: control characters, '"', '\\'
+static int needsEscape(unsigned char ch)
+{
+    return ch < 0x20 || ch == '"' || ch == '\\';
+}
+
+#define BYTES_OF(b) (0x01010101u * (uint32_t)(b))
+
+// Length of the prefix of str that needs no escaping. Tests four bytes per
+// step: a lane of (v - 0x01..) & ~v has its top bit set where v is zero,
+// and likewise for bytes below 0x20; bytes >= 0x80 are masked out.
+static size_t plainPrefix(const char *str, size_t len)
+{
+    size_t i = 0;
+    for (; i + 4 <= len; i += 4) {
+        uint32_t x;
+        memcpy(&x, str + i, sizeof(x));
+        uint32_t quote = x ^ BYTES_OF('"');
+        uint32_t backslash = x ^ BYTES_OF('\\');
+        uint32_t found = ((quote - BYTES_OF(1)) & ~quote)
+                       | ((backslash - BYTES_OF(1)) & ~backslash)
+                       | (x - BYTES_OF(0x20));
+        if (found & ~x & BYTES_OF(0x80)) break;
+    }
+    while (i < len && !needsEscape((unsigned char)str[i])) i++;
+    return i;
+}
+
+// Write str as the inside of a JSON string, escaping what JSON requires
+void JSONWriter_escape(JSONWriter *writer, const char *str, size_t len)
+{
+    static const char hexDigits[] = "0123456789abcdef";
+    size_t run = 0;
+
+    for (size_t i = plainPrefix(str, len); i < len; i = run + plainPrefix(str + run, len - run)) {
+        unsigned char ch = (unsigned char)str[i];
+        JSONWriter_write(writer, str + run, i - run);
+        run = i + 1;
+        char escape[6] = { '\\', (char)ch, 0, 0, 0, 0 };
+        size_t escapeLen = 2;
+        switch (ch) {
+        case '"': case '\\': break;
+        case '\n': escape[1] = 'n'; break;
+        case '\r': escape[1] = 'r'; break;
+        case '\t': escape[1] = 't'; break;
+        case '\b': escape[1] = 'b'; break;
+        case '\f': escape[1] = 'f'; break;
+        default:
+            memcpy(escape + 1, "u00", 3);
+            escape[4] = hexDigits[ch >> 4];
+            escape[5] = hexDigits[ch & 0x0F];
+            escapeLen = 6;
+            break;
+        }
+        JSONWriter_write(writer, escape, escapeLen);
+    }
+    JSONWriter_write(writer, str + run, len - run);
+}
+
+void JSONWriter_string(JSONWriter *writer, const char *str, size_t len)
+{
+    JSONWriter_write(writer, "\"", 1);
+    JSONWriter_escape(writer, str, len);
+    JSONWriter_write(writer, "\"", 1);
+}
+
+// Push out what is left, or NUL-terminate a bounded string
+RDFStatus JSONWriter_finish(JSONWriter *writer)
+{
+    if (writer->buffer && writer->status == RDF_OK) {
+        if (writer->sink) {
+            flush(writer);
+        } else {
+            writer->buffer[writer->length] = '\0';
+        }
+    }
+    return writer->status;
+}
+
+/* Compaction ---------------------------------------------------------------*/
+
+#define LITERAL(str) str, sizeof(str) - 1
+
+#define NO_RUN ((RDFTriplePos)~(RDFTriplePos)0)
+
+// depth[] before it is known, and once a node has been written
+#define DEPTH_UNKNOWN  0xFF
+#define DEPTH_VISITING 0xFE
+#define DEPTH_WRITTEN  0xFD
+
+// Per term state of one compaction, carved out of the caller's scratch
+typedef struct {
+    const RDFGraph *graph;
+    const JSONLDActiveContext *context;
+    JSONWriter *writer;
+    RDFTriplePos *first;      // subject -> its first triple, NO_RUN if it has none
+    RDFTriplePos *seen;       // predicate -> run it was last seen in
+    RDFTermId *graphOf;       // subject -> graph its triples are in
+    RDFTermId *parent;        // node -> subject it is nested in, RDF_NO_TERM at the top
+    RDFTermId *graphNode;     // graph name -> first subject with triples in it
+    RDFTermId *topNode;       // graph name -> first of its top-level nodes
+    RDFTermId *next;          // nodes on a path, then next top-level node of the graph
+    uint8_t *refs;            // uses as an object, saturating at 2
+    uint8_t *depth;           // nesting depth of a node
+    char iri[256];            // an IRI being compacted, see termIri()
+} Compactor;
+
+static int isBlank(const Compactor *c, RDFTermId id)
+{
+    return RDFGraph_termKind(c->graph, id) == RDF_TERM_BLANK;
+}
+
+// Index the subject runs and check the grouping compaction relies on:
+// a subject's triples are contiguous and in one graph, and so are its
+// values of a predicate
+static RDFStatus indexRuns(Compactor *c)
+{
+    const RDFGraph *graph = c->graph;
+    RDFTriplePos run = 0;
+    const RDFTriple *prev = NULL;
+
+    for (int i = 0; i < graph->size; prev = RDFGraph_triple(graph, i++)) {
+        const RDFTriple *t = RDFGraph_triple(graph, i);
+        if (!prev || t->subject != prev->subject) {
+            if (c->first[t->subject] != NO_RUN) return RDF_ERR_INVALID;
+            c->first[t->subject] = (RDFTriplePos)i;
+            c->graphOf[t->subject] = t->graph;
+            run++;
+        } else if (t->graph != prev->graph
+                   || (t->predicate != prev->predicate && c->seen[t->predicate] == run)) {
+            return RDF_ERR_INVALID;
+        }
+        c->seen[t->predicate] = run;
+        if (c->refs[t->object] < 2) c->refs[t->object]++;
+        if (t->graph != RDF_NO_TERM && c->graphNode[t->graph] == RDF_NO_TERM) {
+            c->graphNode[t->graph] = t->subject;
+        }
+    }
+    return RDF_OK;
+}
+
+// Nest blank nodes used once as an object in the subject that uses them,
+// and the node of a blank graph name used once. Which graphs really nest
+// is only known once their top-level nodes are (see listTopNodes()).
+static void findParents(Compactor *c)
+{
+    const RDFGraph *graph = c->graph;
+    for (int i = 0; i < graph->size; i++) {
+        const RDFTriple *t = RDFGraph_triple(graph, i);
+        RDFTermId node = t->object;
+        if (!isBlank(c, node) || c->refs[node] != 1) continue;
+        if (c->first[node] != NO_RUN) {
+            if (c->graphOf[node] != t->graph) continue;
+        } else {
+            node = c->graphNode[node];
+            if (node == RDF_NO_TERM || (isBlank(c, node) && c->refs[node] != 0)) continue;
+        }
+        if (node != t->subject) c->parent[node] = t->subject;
+    }
+}
+
+// Depth of every node below its top-level ancestor, following parent
+// links. A cycle is cut by moving the node it was found at to the top
+// level, and so is a node nested deeper than JSONLD_MAX_DEPTH allows.
+static void resolveDepths(Compactor *c)
+{
+    const RDFGraph *graph = c->graph;
+    for (int i = 0; i < graph->size; i++) {
+        RDFTermId node = RDFGraph_triple(graph, i)->subject;
+        if (c->depth[node] != DEPTH_UNKNOWN) continue;
+
+        int length = 0;
+        while (c->parent[node] != RDF_NO_TERM && c->depth[node] == DEPTH_UNKNOWN) {
+            c->depth[node] = DEPTH_VISITING;
+            c->next[length++] = node;
+            node = c->parent[node];
+        }
+        if (c->depth[node] == DEPTH_VISITING) {
+            c->parent[node] = RDF_NO_TERM;
+            c->depth[node] = 0;
+        } else if (c->depth[node] == DEPTH_UNKNOWN) {
+            c->depth[node] = 0;  // top level
+        }
+        while (length > 0) {
+            node = c->next[--length];
+            if (c->depth[node] != DEPTH_VISITING) continue;
+            int depth = c->depth[c->parent[node]] + 1;
+            if (depth >= JSONLD_MAX_DEPTH) {
+                c->parent[node] = RDF_NO_TERM;
+                depth = 0;
+            }
+            c->depth[node] = (uint8_t)depth;
+        }
+    }
+}
+
+// A node at the top of its graph: not nested, or nested as a graph
+static int isTopNode(const Compactor *c, RDFTermId node)
+{
+    return c->parent[node] == RDF_NO_TERM || c->graphOf[c->parent[node]] != c->graphOf[node];
+}
+
+// Non-zero if graph name is written nested as the value of a graph link:
+// its graph has a single top-level node, and that one has a parent
+static int isNestedGraph(const Compactor *c, RDFTermId name)
+{
+    RDFTermId top = c->topNode[name];
+    return top != RDF_NO_TERM && c->next[top] == RDF_NO_TERM && c->parent[top] != RDF_NO_TERM;
+}
+
+// Chain the top-level nodes of every named graph in triple order. A
+// graph with several of them is written on its own (see writeGraph()),
+// so none of them nests.
+static void listTopNodes(Compactor *c)
+{
+    const RDFGraph *graph = c->graph;
+    for (int i = graph->size - 1; i >= 0; i--) {
+        RDFTermId node = RDFGraph_triple(graph, i)->subject;
+        RDFTermId name = c->graphOf[node];
+        if (c->first[node] != (RDFTriplePos)i || name == RDF_NO_TERM || !isTopNode(c, node)) continue;
+        c->next[node] = c->topNode[name];
+        c->topNode[name] = node;
+    }
+    for (int i = 0; i < graph->size; i++) {
+        RDFTermId node = RDFGraph_triple(graph, i)->subject;
+        RDFTermId name = c->graphOf[node];
+        if (c->first[node] != (RDFTriplePos)i || name == RDF_NO_TERM || c->topNode[name] == RDF_NO_TERM) continue;
+        if (c->next[c->topNode[name]] != RDF_NO_TERM && isTopNode(c, node)) c->parent[node] = RDF_NO_TERM;
+    }
+}
+
+static RDFStatus prepare(Compactor *c, RDFArena *scratch)
+{
+    size_t terms = (size_t)c->graph->termCount + 1;
+    size_t ids = terms * sizeof(RDFTermId), positions = terms * sizeof(RDFTriplePos);
+    c->first = (RDFTriplePos *)RDFArena_alloc(scratch, positions, sizeof(RDFTriplePos));
+    c->seen = (RDFTriplePos *)RDFArena_alloc(scratch, positions, sizeof(RDFTriplePos));
+    c->graphOf = (RDFTermId *)RDFArena_alloc(scratch, ids, sizeof(RDFTermId));
+    c->parent = (RDFTermId *)RDFArena_alloc(scratch, ids, sizeof(RDFTermId));
+    c->graphNode = (RDFTermId *)RDFArena_alloc(scratch, ids, sizeof(RDFTermId));
+    c->topNode = (RDFTermId *)RDFArena_alloc(scratch, ids, sizeof(RDFTermId));
+    c->next = (RDFTermId *)RDFArena_alloc(scratch, ids, sizeof(RDFTermId));
+    c->refs = (uint8_t *)RDFArena_alloc(scratch, terms, 1);
+    c->depth = (uint8_t *)RDFArena_alloc(scratch, terms, 1);
+    if (!c->first || !c->seen || !c->graphOf || !c->parent || !c->graphNode || !c->topNode || !c->next
+        || !c->refs || !c->depth) {
+        return RDF_ERR_ARENA_FULL;
+    }
+    memset(c->first, 0xFF, positions);
+    memset(c->seen, 0, positions);
+    memset(c->parent, 0xFF, ids);
+    memset(c->graphNode, 0xFF, ids);
+    memset(c->topNode, 0xFF, ids);
+    memset(c->refs, 0, terms);
+    memset(c->depth, DEPTH_UNKNOWN, terms);
+
+    RDFStatus status = indexRuns(c);
+    if (status != RDF_OK) return status;
+    findParents(c);
+    resolveDepths(c);
+    memset(c->next, 0xFF, ids);
+    listTopNodes(c);
+    return RDF_OK;
+}
+
+static void writeIndent(JSONWriter *writer, int level)
+{
+    static const char spaces[] = "                ";
+    for (int n = 2 * level; n > 0; n -= (int)sizeof(spaces) - 1) {
+        JSONWriter_write(writer, spaces, n < (int)sizeof(spaces) - 1 ? (size_t)n : sizeof(spaces) - 1);
+    }
+}
+
+static void writeTermString(JSONWriter *writer, const RDFGraph *graph, RDFTermId id)
+{
+    JSONWriter_write(writer, "\"", 1);
+    JSONWriter_escape(writer, RDFGraph_termPrefix(graph, id), RDFGraph_termPrefixLength(graph, id));
+    JSONWriter_escape(writer, RDFGraph_termSuffix(graph, id), RDFGraph_termSuffixLength(graph, id));
+    JSONWriter_write(writer, "\"", 1);
+}
+
+// An IRI in one piece for compaction: as stored if it has no prefix,
+// otherwise copied to c->iri. NULL if it is too long to compact.
+static const char *termIri(Compactor *c, RDFTermId id, size_t *len)
+{
+    *len = RDFGraph_termLength(c->graph, id);
+    if (RDFGraph_termPrefixLength(c->graph, id) == 0) return RDFGraph_termSuffix(c->graph, id);
+    if (*len >= sizeof(c->iri)) return NULL;
+    RDFGraph_copyTerm(c->graph, id, c->iri, sizeof(c->iri));
+    return c->iri;
+}
+
+// JSON number or boolean with the same lexical form
+static int isNativeLexical(const char *text, size_t len, RDFVocabTerm datatype)
+{
+    if (datatype == RDF_VOCAB_XSD_BOOLEAN) {
+        return (len == 4 && memcmp(text, "true", 4) == 0) || (len == 5 && memcmp(text, "false", 5) == 0);
+    }
+    if (datatype != RDF_VOCAB_XSD_INTEGER) return 0;
+    size_t i = len > 0 && text[0] == '-';
+    if (i == len || (text[i] == '0' && len > i + 1)) return 0;
+    for (; i < len; i++) {
+        if (text[i] < '0' || text[i] > '9') return 0;
+    }
+    return 1;
+}
+
+// A literal's lexical form is kept in its N-Quads escaped form, whose
+// escapes are valid JSON as they stand. It is written as a plain string
+// when the context coerces it, as a number or boolean for those types,
+// and as a value object otherwise.
+static void writeLiteral(Compactor *c, RDFTermId object, uint8_t coercion)
+{
+    const RDFGraph *graph = c->graph;
+    JSONWriter *writer = c->writer;
+    size_t lexicalLength, languageLength, len;
+    const char *lexical = RDFGraph_literalLexical(graph, object, &lexicalLength);
+    const char *language = RDFGraph_literalLanguage(graph, object, &languageLength);
+    RDFTermId type = RDFGraph_literalDatatype(graph, object);
+
+    RDFVocabTerm datatype = RDF_VOCAB_NONE;
+    const char *iri;
+    if (type != RDF_NO_TERM && (iri = termIri(c, type, &len)) != NULL) {
+        datatype = RDFVocab_lookupIRI(iri, len);
+    }
+    if (RDFGraph_termKind(graph, object) == RDF_TERM_LITERAL ? coercion == JSONLD_COERCE_NONE
+        : datatype == RDF_VOCAB_XSD_DATE_TIME && coercion == JSONLD_COERCE_DATETIME) {
+        JSONWriter_write(writer, lexical - 1, lexicalLength + 2);
+        return;
+    }
+    if (coercion == JSONLD_COERCE_NONE && isNativeLexical(lexical, lexicalLength, datatype)) {
+        JSONWriter_write(writer, lexical, lexicalLength);
+        return;
+    }
+
+    JSONWriter_write(writer, LITERAL("{\"@value\": "));
+    JSONWriter_write(writer, lexical - 1, lexicalLength + 2);
+    if (type != RDF_NO_TERM) {
+        JSONWriter_write(writer, LITERAL(", \"@type\": "));
+        writeTermString(writer, graph, type);
+    } else if (languageLength > 0) {
+        JSONWriter_write(writer, LITERAL(", \"@language\": "));
+        JSONWriter_string(writer, language, languageLength);
+    }
+    JSONWriter_write(writer, "}", 1);
+}
+
+// IRIs and blank nodes that are not nested: a string where the context
+// coerces the property to an IRI, a node reference otherwise
+static void writeReference(Compactor *c, RDFTermId object, uint8_t coercion)
+{
+    const RDFGraph *graph = c->graph;
+    JSONWriter *writer = c->writer;
+    size_t len;
+    const char *iri;
+    if (coercion == JSONLD_COERCE_VOCAB && RDFGraph_termKind(graph, object) == RDF_TERM_IRI
+        && (iri = termIri(c, object, &len)) != NULL) {
+        RDFVocabTerm term = RDFVocab_lookupIRI(iri, len);
+        size_t nameLength;
+        uint8_t kind;
+        const char *name = term == RDF_VOCAB_RDF_TYPE ? NULL  // compacts to the keyword
+                         : JSONLDActiveContext_compact(c->context, iri, len, term, &nameLength, &kind);
+        if (name) {
+            JSONWriter_string(writer, name, nameLength);
+            return;
+        }
+    }
+    if (coercion == JSONLD_COERCE_ID || coercion == JSONLD_COERCE_VOCAB || coercion == JSONLD_COERCE_GRAPH) {
+        writeTermString(writer, graph, object);
+        return;
+    }
+    JSONWriter_write(writer, LITERAL("{\"@id\": "));
+    writeTermString(writer, graph, object);
+    JSONWriter_write(writer, "}", 1);
+}
+
+// "@context": the URLs of the active contexts
+static void writeContext(JSONWriter *writer, const JSONLDActiveContext *context)
+{
+    JSONWriter_write(writer, LITERAL("\"@context\": "));
+    if (context->count > 1) JSONWriter_write(writer, "[", 1);
+    for (int i = 0; i < context->count; i++) {
+        const JSONLDContextEntry *entry = &JSONLD_contexts[context->ids[i]];
+        if (i > 0) JSONWriter_write(writer, LITERAL(", "));
+        JSONWriter_string(writer, entry->url, entry->urlLength);
+    }
+    if (context->count > 1) JSONWriter_write(writer, "]", 1);
+}
+
+static void writeNode(Compactor *c, RDFTermId node, int level, int top);
+
+// Node nested as the value of subject's triple with this object, if any
+static RDFTermId nestedNode(const Compactor *c, RDFTermId subject, RDFTermId object)
+{
+    RDFTermId node = object;
+    if (c->first[node] == NO_RUN) {
+        if (!isBlank(c, object) || !isNestedGraph(c, object)) return RDF_NO_TERM;
+        node = c->topNode[object];
+    }
+    return c->parent[node] == subject && c->depth[node] != DEPTH_WRITTEN ? node : RDF_NO_TERM;
+}
+
+// Members of one subject run, values of a predicate grouped in an array
+static void writeMembers(Compactor *c, RDFTermId node, int level, int members)
+{
+    const RDFGraph *graph = c->graph;
+    JSONWriter *writer = c->writer;
+    int i = c->first[node];
+
+    while (i < graph->size && RDFGraph_triple(graph, i)->subject == node) {
+        RDFTermId predicate = RDFGraph_triple(graph, i)->predicate;
+        int end = i + 1;
+        while (end < graph->size && RDFGraph_triple(graph, end)->subject == node
+               && RDFGraph_triple(graph, end)->predicate == predicate) {
+            end++;
+        }
+
+        // The key is the context's name for the predicate, or its IRI
+        size_t len, nameLength;
+        const char *iri = termIri(c, predicate, &len);
+        uint8_t coercion = JSONLD_COERCE_NONE;
+        const char *name = iri ? JSONLDActiveContext_compact(c->context, iri, len, RDFVocab_lookupIRI(iri, len),
+                                                             &nameLength, &coercion)
+                               : NULL;
+        if (members++ > 0) JSONWriter_write(writer, LITERAL(",\r\n"));
+        writeIndent(writer, level + 1);
+        if (name) {
+            JSONWriter_string(writer, name, nameLength);
+        } else {
+            writeTermString(writer, graph, predicate);
+        }
+        JSONWriter_write(writer, LITERAL(": "));
+        if (end - i > 1) JSONWriter_write(writer, "[", 1);
+
+        for (int k = i; k < end; k++) {
+            RDFTermId object = RDFGraph_triple(graph, k)->object;
+            RDFTermId nested = nestedNode(c, node, object);
+            if (k > i) JSONWriter_write(writer, LITERAL(", "));
+            if (nested != RDF_NO_TERM) {
+                writeNode(c, nested, level + 1, 0);
+            } else if (RDFGraph_isLiteral(graph, object)) {
+                writeLiteral(c, object, coercion);
+            } else {
+                writeReference(c, object, coercion);
+            }
+        }
+        if (end - i > 1) JSONWriter_write(writer, "]", 1);
+        i = end;
+    }
+}
+
+// Node object for node, with "@context" if it is the document; nested and
+// unreferenced blank nodes go without "@id"
+static void writeNode(Compactor *c, RDFTermId node, int level, int top)
+{
+    JSONWriter *writer = c->writer;
+    int members = 0;
+
+    c->depth[node] = DEPTH_WRITTEN;
+    JSONWriter_write(writer, LITERAL("{\r\n"));
+    if (top && c->context->count > 0) {
+        writeIndent(writer, level + 1);
+        writeContext(writer, c->context);
+        members++;
+    }
+    if (!isBlank(c, node) || (c->parent[node] == RDF_NO_TERM && c->refs[node] > 0)) {
+        if (members++ > 0) JSONWriter_write(writer, LITERAL(",\r\n"));
+        writeIndent(writer, level + 1);
+        JSONWriter_write(writer, LITERAL("\"@id\": "));
+        writeTermString(writer, c->graph, node);
+    }
+    writeMembers(c, node, level, members);
+    JSONWriter_write(writer, LITERAL("\r\n"));
+    writeIndent(writer, level);
+    JSONWriter_write(writer, "}", 1);
+}
+
+// A named graph that does not nest: {"@id": name, "@graph": [nodes]}
+static void writeGraph(Compactor *c, RDFTermId name, int level)
+{
+    JSONWriter *writer = c->writer;
+    JSONWriter_write(writer, LITERAL("{\r\n"));
+    writeIndent(writer, level + 1);
+    JSONWriter_write(writer, LITERAL("\"@id\": "));
+    writeTermString(writer, c->graph, name);
+    JSONWriter_write(writer, LITERAL(",\r\n"));
+    writeIndent(writer, level + 1);
+    JSONWriter_write(writer, LITERAL("\"@graph\": ["));
+    for (RDFTermId node = c->topNode[name]; node != RDF_NO_TERM; node = c->next[node]) {
+        if (node != c->topNode[name]) JSONWriter_write(writer, LITERAL(", "));
+        writeNode(c, node, level + 1, 0);
+    }
+    JSONWriter_write(writer, LITERAL("]\r\n"));
+    writeIndent(writer, level);
+    JSONWriter_write(writer, "}", 1);
+}
+
+// Top-level nodes of the default graph, and named graphs that do not
+// nest, are the roots of the document. Each is found at its first triple.
+static int isRoot(const Compactor *c, int i)
+{
+    RDFTermId node = RDFGraph_triple(c->graph, i)->subject;
+    RDFTermId name = c->graphOf[node];
+    if (c->first[node] != (RDFTriplePos)i) return 0;
+    if (name == RDF_NO_TERM) return c->parent[node] == RDF_NO_TERM;
+    return c->topNode[name] == node && !isNestedGraph(c, name);
+}
+
+RDFStatus JSONLD_writeDocument(const RDFGraph *graph, const JSONLDActiveContext *context, RDFArena *scratch,
+                               JSONWriter *writer)
+{
+    static const JSONLDActiveContext noContext = { { 0 }, 0 };
+    size_t mark = scratch->used;
+    Compactor c;
+    c.graph = graph;
+    c.context = context ? context : &noContext;
+    c.writer = writer;
+
+    RDFStatus status = prepare(&c, scratch);
+    if (status != RDF_OK) {
+        RDFArena_release(scratch, mark);
+        return status;
+    }
+
+    int roots = 0, root = 0;
+    for (int i = 0; i < graph->size; i++) {
+        if (isRoot(&c, i)) {
+            if (roots++ == 0) root = i;
+        }
+    }
+
+    // A single node is the document itself, anything else goes in "@graph"
+    RDFTermId node = roots > 0 ? RDFGraph_triple(graph, root)->subject : RDF_NO_TERM;
+    if (roots == 1 && c.graphOf[node] == RDF_NO_TERM) {
+        writeNode(&c, node, 0, 1);
+    } else {
+        JSONWriter_write(writer, LITERAL("{\r\n"));
+        if (c.context->count > 0) {
+            writeIndent(writer, 1);
+            writeContext(writer, c.context);
+            JSONWriter_write(writer, LITERAL(",\r\n"));
+        }
+        JSONWriter_write(writer, LITERAL("  \"@graph\": ["));
+        for (int i = root, n = 0; i < graph->size; i++) {
+            if (!isRoot(&c, i)) continue;
+            if (n++ > 0) JSONWriter_write(writer, LITERAL(", "));
+            node = RDFGraph_triple(graph, i)->subject;
+            if (c.graphOf[node] == RDF_NO_TERM) {
+                writeNode(&c, node, 1, 0);
+            } else {
+                writeGraph(&c, c.graphOf[node], 1);
+            }
+        }
+        JSONWriter_write(writer, LITERAL("]\r\n}"));
+    }
+    JSONWriter_write(writer, LITERAL("\r\n"));
+
+    RDFArena_release(scratch, mark);
+    return JSONWriter_finish(writer);
+}
+
+size_t JSONLD_documentSize(const RDFGraph *graph, const JSONLDActiveContext *context, RDFArena *scratch)
+{
+    JSONWriter writer;
+    JSONWriter_init(&writer, NULL, 0, NULL, NULL);
+    JSONLD_writeDocument(graph, context, scratch, &writer);
+    return writer.total;
+}
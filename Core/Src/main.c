@@ -3,6 +3,19 @@
 #include "main.h"
 #include "cmox_crypto.h"
 #include "monocypher.h"
+#include "rdf_graph.h"
+#include "rdf_canon.h"
+#include "rdf_index.h"
+#include "jsonld_reader.h"
+#include "jsonld_writer.h"
+#include "json_canon.h"
+#include "credential_template.h"
+#include "signer.h"
+#include "ed25519_signer.h"
+#include "multibase.h"
+#include "nquads_reader.h"
+#include "rdf_vocab.h"
+#include "bench.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <ctype.h>
@@ -10,179 +23,424 @@
 #include <stdbool.h>
 #include <stdarg.h>
 
-#define MAX_TRIPLES 100
 #define MAX_MESSAGE_SIZE 2048
 #define OUTPUT_FILE "rdf_output.json"
 #define hexSignature_MAX_SIZE 1024
 #define time_MAX_SIZE 25
+// Scratch for canonicalizing the proof graph while it is being hashed, and
+// for the per term tables of compacting it to JSON-LD
+#define CREDENTIAL_SCRATCH_SIZE 1536
+// Terms of a received credential point into output[]; the arena holds its
+// triple pages, blank node labels, typed literals and unescaped strings
+#define RECEIVED_ARENA_SIZE 1536
+// Claims received as N-Quads are copied in, terms and triple pages alike
+#define CLAIMS_ARENA_SIZE 1024
+
+// Signature suite of the credentials. By default ECDSA P-256, carried as
+// hex in jws, over the SHA-224 of two SHA-224 hashes: that of the
+// canonical proof options followed by that of the canonical document,
+// the credential without its proof. With CREDSIGN_EDDSA,
+// Ed25519Signature2020 as eddsa-rdfc-2022 signs: Ed25519 over the same
+// two hashes taken with SHA-256, carried as multibase in proofValue.
+#ifdef CREDSIGN_EDDSA
+#ifdef CREDSIGN_JCS
+#error "CREDSIGN_EDDSA signs the RDFC form and does not combine with CREDSIGN_JCS"
+#endif
+#define CREDENTIAL_SUITE_NAME "Ed25519Signature2020"
+#define CREDENTIAL_PROOF_TYPE RDF_IRI_SEC_ED25519_SIGNATURE2020
+#define CREDENTIAL_SIGNATURE_IRI RDF_IRI_SEC_PROOF_VALUE
+#define CREDENTIAL_HASH_SIZE SHA256_DIGEST_SIZE
+#define CREDENTIAL_DIGEST_SIZE (2 * SHA256_DIGEST_SIZE)
+#else
+#define CREDENTIAL_SUITE_NAME "ECDSA"
+#define CREDENTIAL_PROOF_TYPE RDF_IRI_SEC_ECDSA_SIGNATURE2018
+#define CREDENTIAL_SIGNATURE_IRI RDF_IRI_SEC_JWS
+#define CREDENTIAL_HASH_SIZE SHA224_DIGEST_SIZE
+#define CREDENTIAL_DIGEST_SIZE SHA224_DIGEST_SIZE
+#endif
 char output[MAX_MESSAGE_SIZE] = {0};
-char hexSignature[hexSignature_MAX_SIZE];
+char hexSignature[hexSignature_MAX_SIZE];   // the signature as the proof carries it
 char global_time[time_MAX_SIZE];
 char rx_buffer[1];         // Buffer for receiving input
 char tx_buffer[1024];       // Buffer for sending output
 
-// RDFTriple "class"
-typedef struct {
-    char *subject;
-    char *predicate;
-    char *object;
-} RDFTriple;
-
-// RDFGraph "class"
-typedef struct {
-    RDFTriple triples[MAX_TRIPLES];
-    int size;
-} RDFGraph;
-
 // RDFProcessor "class"
 typedef struct {
     RDFGraph *graph;
 } RDFProcessor;
 
-char *trimWhitespace(const char *str) {
-    if (!str) return NULL;
-    char *mutableStr = strdup(str);
-    if (!mutableStr) return NULL;
+// char hexSignature[]="4A19274429E40522234B8785DC25FC524F179DCC95FF09B3C9770FC71F54CA0D4259F0A9B3E9A1E9DB434EF0E3374B3084CA19416FE9F9265A796240E0B05DC1";
+static const JSONLDActiveContext credentialContext = {
+    { JSONLD_CONTEXT_SCHEMA_ORG, JSONLD_CONTEXT_SECURITY_V2 }, 2
+};
+static uint8_t canonScratch[CREDENTIAL_SCRATCH_SIZE];
+
+// Serialize the RDF graph to JSON-LD format into output[0..size); length,
+// unless NULL, receives the bytes written without the terminating NUL
+RDFStatus RDFGraph_serializeToJsonLD(RDFGraph *graph, char *output, size_t size, size_t *length) {
+    JSONWriter writer;
+    RDFArena scratch;
+    JSONWriter_init(&writer, output, size, NULL, NULL);
+    RDFArena_init(&scratch, canonScratch, sizeof(canonScratch));
+    RDFStatus status = JSONLD_writeDocument(graph, &credentialContext, &scratch, &writer);
+    if (length) *length = status == RDF_OK ? writer.total : 0;
+    return status;
+}
 
-    char *start = mutableStr;
-    char *end;
+// Process the RDF graph using RDFProcessor
+void RDFProcessor_process(RDFProcessor *processor, char *output) {
+    RDFGraph_canonicalize(processor->graph);
+    RDFGraph_serializeToJsonLD(processor->graph, output, MAX_MESSAGE_SIZE, NULL);
+}
 
-    while (isspace((unsigned char)*start)) start++;
+void RDFProcessor_free(RDFProcessor *processor) {
+    free(processor);
+}
 
-    if (*start == 0) {
-        *mutableStr = '\0';
-        return mutableStr;
-    }
+// The graph, its term arena and its canonical form are kept from one
+// credential to the next, so signing a stream of credentials never grows
+// the heap and only re-hashes what changed
+static RDFGraph credentialGraph;
+static uint8_t credentialArena[RDF_ARENA_SIZE];
+static RDFCanonCache credentialCache;
 
-    end = start + strlen(start) - 1;
-    while (end > start && isspace((unsigned char)*end)) end--;
+// Triples of the signed proof; created is the only one that changes
+enum { CREDENTIAL_CREATED = 1, CREDENTIAL_TRIPLES = 4 };
+#define CREATED_MAX_SIZE (time_MAX_SIZE + sizeof("\"\"^^<" RDF_IRI_XSD_DATE_TIME ">"))
+#define JWS_MAX_SIZE (hexSignature_MAX_SIZE + 2)
 
-    end[1] = '\0';
-    return strdup(start);
+static void formatCreated(char *created, size_t size)
+{
+    snprintf(created, size, "\"%s\"^^<" RDF_IRI_XSD_DATE_TIME ">", global_time);
 }
 
-// RDFGraph "constructor" to initialize the graph
-RDFGraph *RDFGraph_new() {
-    RDFGraph *graph = (RDFGraph *)malloc(sizeof(RDFGraph));
-    graph->size = 0;
-    return graph;
+// Build the signed part of the credential: every proof triple but jws. The
+// proof node is blank, as it is when a verifier reads the JSON-LD back.
+static RDFStatus buildCredentialGraph(RDFGraph *graph)
+{
+    char created[CREATED_MAX_SIZE];
+    RDFStatus status;
+
+    RDFGraph_init(graph, credentialArena, sizeof(credentialArena));
+    RDFCanonCache_init(&credentialCache, CREDENTIAL_HASH_SIZE);
+    formatCreated(created, sizeof(created));
+
+    status = RDFGraph_addTriple(graph, "_:proof", RDF_IRI_RDF_TYPE, CREDENTIAL_PROOF_TYPE);
+    if (status == RDF_OK) status = RDFGraph_addTriple(graph, "_:proof", RDF_IRI_DC_CREATED, created);
+    if (status == RDF_OK) status = RDFGraph_addTriple(graph, "_:proof", RDF_IRI_SEC_VERIFICATION_METHOD, "did:example:123456789abcdefghi#key1");
+    if (status == RDF_OK) status = RDFGraph_addTriple(graph, "_:proof", RDF_IRI_SEC_PROOF_PURPOSE, RDF_IRI_SEC_ASSERTION_METHOD);
+    return status;
 }
 
-// Add a triple to the RDF graph
-void RDFGraph_addTriple(RDFGraph *graph, const char *subject, const char *predicate, const char *object) {
-    if (graph->size < MAX_TRIPLES) {
-        graph->triples[graph->size].subject = strdup(trimWhitespace(subject));
-        graph->triples[graph->size].predicate = strdup(trimWhitespace(predicate));
-        graph->triples[graph->size].object = strdup(trimWhitespace(object));
-        graph->size++;
+// Bring the credential graph up to date with global_time by replacing the
+// created object. Replaced terms stay in the arena, so the graph is built
+// afresh once it could not take another created and jws.
+static RDFStatus updateCredentialGraph(RDFGraph *graph)
+{
+    char created[CREATED_MAX_SIZE];
+    RDFStatus status = RDF_ERR_INVALID;
+
+    if (graph->size == CREDENTIAL_TRIPLES && graph->termCount + 2 <= RDF_MAX_TERMS
+        && graph->arena.capacity - graph->arena.used >= CREATED_MAX_SIZE + JWS_MAX_SIZE) {
+        formatCreated(created, sizeof(created));
+        status = RDFGraph_setObject(graph, CREDENTIAL_CREATED, created);
     }
+    if (status != RDF_OK) status = buildCredentialGraph(graph);
+    return status;
 }
 
-// Sorting triples
-int compareTriples(const void *a, const void *b) {
-    RDFTriple *tripleA = (RDFTriple *)a;
-    RDFTriple *tripleB = (RDFTriple *)b;
-    int subjectCmp = strcmp(tripleA->subject, tripleB->subject);
-    if (subjectCmp != 0) return subjectCmp;
-    int predicateCmp = strcmp(tripleA->predicate, tripleB->predicate);
-    if (predicateCmp != 0) return predicateCmp;
-    return strcmp(tripleA->object, tripleB->object);
+// Claims the unsigned credential makes, received over USART2; when there
+// are none it says "Hello World!"
+static RDFGraph claimsGraph;
+static uint8_t claimsArena[CLAIMS_ARENA_SIZE];
+
+// Blank nodes of the claims other than _:credential are renamed _:claim-*,
+// which the credential's own blank nodes, _:credential and _:proof, are not
+#define CLAIM_LABEL "_:claim-"
+#define CLAIM_LABEL_SKIP (sizeof(CLAIM_LABEL) - sizeof("_:"))
+
+// Copy claims [from, to) into the credential graph
+static RDFStatus copyClaims(RDFGraph *graph, RDFTermId credential, int from, int to)
+{
+    static char term[CLAIM_LABEL_SKIP + NQUADS_TERM_SCRATCH + 1];
+
+    for (int i = from; i < to; i++) {
+        const RDFTriple *claim = RDFGraph_triple(&claimsGraph, i);
+        RDFTermId ids[4] = { claim->subject, claim->predicate, claim->object, claim->graph };
+        RDFTermId copies[4] = { RDF_NO_TERM, RDF_NO_TERM, RDF_NO_TERM, RDF_NO_TERM };
+        for (int k = 0; k < 4 && ids[k] != RDF_NO_TERM; k++) {
+            char *text = term + CLAIM_LABEL_SKIP;
+            size_t length = RDFGraph_copyTerm(&claimsGraph, ids[k], text, sizeof(term) - CLAIM_LABEL_SKIP);
+            if (RDFGraph_termKind(&claimsGraph, ids[k]) == RDF_TERM_BLANK && ids[k] != credential) {
+                // "_:label" becomes "_:claim-label" in place
+                memcpy(term, CLAIM_LABEL, sizeof(CLAIM_LABEL) - 1);
+                text = term;
+                length += CLAIM_LABEL_SKIP;
+            }
+            copies[k] = RDFGraph_intern(graph, text, length);
+            if (copies[k] == RDF_NO_TERM) {
+                return graph->termCount >= RDF_MAX_TERMS ? RDF_ERR_TERMS_FULL : RDF_ERR_ARENA_FULL;
+            }
+        }
+        RDFStatus status = RDFGraph_addQuadIds(graph, copies[0], copies[1], copies[2], copies[3]);
+        if (status != RDF_OK) {
+            return status;
+        }
+    }
+    return RDF_OK;
 }
 
-// Canonicalize the RDF graph
-void RDFGraph_canonicalize(RDFGraph *graph) {
-    qsort(graph->triples, graph->size, sizeof(RDFTriple), compareTriples);
+// Copy the claims into the credential graph, with the link to the proof.
+// _:credential names the credential itself; their other blank nodes are
+// kept apart from the proof's. receiveClaims() sorted them, so each subject's claims
+// are one run, as the JSON-LD writer takes them; the link goes in
+// _:credential's.
+static RDFStatus addClaims(RDFGraph *graph)
+{
+    RDFStatus status;
+
+    if (claimsGraph.size == 0) {
+        status = RDFGraph_addTriple(graph, "_:credential", RDF_IRI_SCHEMA_DESCRIPTION, "\"Hello World!\"");
+        if (status == RDF_OK) status = RDFGraph_addTriple(graph, "_:credential", RDF_IRI_SEC_PROOF, "_:proof");
+        return status;
+    }
+    RDFTermId credential = RDFGraph_find(&claimsGraph, "_:credential", sizeof("_:credential") - 1);
+    int at = 0;
+    while (at < claimsGraph.size && RDFGraph_triple(&claimsGraph, at)->subject != credential) {
+        at++;
+    }
+    status = copyClaims(graph, credential, 0, at);
+    if (status == RDF_OK) status = RDFGraph_addTriple(graph, "_:credential", RDF_IRI_SEC_PROOF, "_:proof");
+    if (status == RDF_OK) status = copyClaims(graph, credential, at, claimsGraph.size);
+    return status;
 }
-// char hexSignature[]="4A19274429E40522234B8785DC25FC524F179DCC95FF09B3C9770FC71F54CA0D4259F0A9B3E9A1E9DB434EF0E3374B3084CA19416FE9F9265A796240E0B05DC1";
-// Serialize the RDF graph to JSON-LD format
-void RDFGraph_serializeToJsonLD(RDFGraph *graph, char *output) {
-    char context[] = "[\"http://schema.org/\", \"https://w3id.org/security/v2\"]";
-    char description[] = "\"description\": \"Hello World!\"";
-    int offset = 0;
 
-    // Manually construct the JSON string
-    strcpy(output, "{\r\n");
-    strcat(output, "  \"@context\": ");
-    strcat(output, context);
-    strcat(output, ",\r\n");
-    strcat(output, "  ");
-    strcat(output, description);
-    strcat(output, ",\r\n");
-    strcat(output, "  \"proof\": {\r\n");
-
-    // Add proof properties
-    for (int i = 0; i < graph->size; i++) {
-        if (strcmp(graph->triples[i].predicate, "ProofCreated") == 0) {
-            strcat(output, "    \"created\": \"");
-            strcat(output, global_time); // Replace with actual value
-            strcat(output, "\",\r\n");
-        } else if (strcmp(graph->triples[i].predicate, "ProofType") == 0) {
-            strcat(output, "    \"type\": \"");
-            strcat(output, graph->triples[i].object);
-            strcat(output, "\",\r\n");
-        } else if (strcmp(graph->triples[i].predicate, "VerificationMethod") == 0) {
-            strcat(output, "    \"verificationMethod\": \"");
-            strcat(output, graph->triples[i].object);
-            strcat(output, "\",\r\n");
-        } else if (strcmp(graph->triples[i].predicate, "ProofPurpose") == 0) {
-            strcat(output, "    \"proofPurpose\": \"");
-            strcat(output, graph->triples[i].object);
-            strcat(output, "\",\r\n");
-        } else if (strcmp(graph->triples[i].predicate, "jws") == 0) {
-            strcat(output, "    \"jws\": \"");
-            strcat(output, hexSignature); // Replace with actual value
-            strcat(output, "\"\r\n");
+// Write the credential as JSON-LD to output[0..*length); jws, the
+// signature value of either suite, NULL leaves it out, as the JCS signing
+// input has it
+static RDFStatus writeCredential(char *output, const char *jws, size_t *length)
+{
+    RDFGraph *graph = &credentialGraph;
+
+    // Add RDF triples to the graph
+    RDFStatus status = updateCredentialGraph(graph);
+    if (status == RDF_OK && jws) status = RDFGraph_addTriple(graph, "_:proof", CREDENTIAL_SIGNATURE_IRI, jws); // Add the signature value
+    // The unsigned credential around the proof
+    if (status == RDF_OK) status = addClaims(graph);
+
+    // Serialize the RDF graph to JSON-LD format and store in output
+    if (status == RDF_OK) status = RDFGraph_serializeToJsonLD(graph, output, MAX_MESSAGE_SIZE, length);
+
+    // Back to the signed triples for the next credential
+    RDFGraph_truncate(graph, CREDENTIAL_TRIPLES);
+    return status;
+}
+
+// Function to process the RDF graph and store it in the output variable;
+// length receives its size, which is what gets hashed, not sizeof(output)
+RDFStatus processRDF(char *output, size_t *length) {
+    static char jws[JWS_MAX_SIZE];
+
+#ifndef CREDSIGN_EDDSA
+    // The "Hello World!" credential is compiled in: copy it and patch created
+    // and the signature in. Received claims still take the graph walk. The
+    // template is the ECDSA proof's.
+    if (claimsGraph.size == 0) {
+        const char *values[CREDENTIAL_HOLE_COUNT] = {
+            [CREDENTIAL_HOLE_CREATED] = global_time,
+            [CREDENTIAL_HOLE_JWS] = hexSignature,
+        };
+        if (CredentialTemplate_write(output, MAX_MESSAGE_SIZE, values) == RDF_OK) {
+            *length = CREDENTIAL_TEMPLATE_SIZE;
+            return RDF_OK;
         }
     }
+#endif
+    snprintf(jws, sizeof(jws), "\"%s\"", hexSignature);
+    return writeCredential(output, jws, length);
+}
 
-    // Close the JSON object
-    strcat(output, "  }\r\n");
-    strcat(output, "}\r\n");
+typedef struct {
+    cmox_hash_handle_t *hash;
+    cmox_hash_retval_t status;
+} DigestSink;
+
+static void DigestSink_write(void *ctx, const char *data, size_t len)
+{
+    DigestSink *sink = (DigestSink *)ctx;
+    if (sink->status == CMOX_HASH_SUCCESS) {
+        sink->status = cmox_hash_append(sink->hash, (const uint8_t *)data, len);
+    }
 }
 
-// Process the RDF graph using RDFProcessor
-void RDFProcessor_process(RDFProcessor *processor, char *output) {
-    RDFGraph_canonicalize(processor->graph);
-    RDFGraph_serializeToJsonLD(processor->graph, output);
+static void DigestSink_init(DigestSink *sink, cmox_sha224_handle_t *sha224)
+{
+    sink->hash = cmox_sha224_construct(sha224);
+    sink->status = cmox_hash_init(sink->hash);
+    if (sink->status == CMOX_HASH_SUCCESS) {
+        sink->status = cmox_hash_setTagLen(sink->hash, CMOX_SHA224_SIZE);
+    }
 }
 
-void RDFGraph_free(RDFGraph *graph) {
-    for (int i = 0; i < graph->size; i++) {
-        free(graph->triples[i].subject);
-        free(graph->triples[i].predicate);
-        free(graph->triples[i].object);
+// Produce the digest unless writing failed with status
+static cmox_hash_retval_t DigestSink_finish(DigestSink *sink, RDFStatus status, uint8_t *digest, size_t *digestSize)
+{
+    if (status != RDF_OK && sink->status == CMOX_HASH_SUCCESS) {
+        sink->status = CMOX_HASH_ERR_INTERNAL;
+    }
+    if (sink->status == CMOX_HASH_SUCCESS) {
+        sink->status = cmox_hash_generateTag(sink->hash, digest, digestSize);
     }
-    free(graph);
+    cmox_hash_cleanup(sink->hash);
+    return sink->status;
 }
 
-void RDFProcessor_free(RDFProcessor *processor) {
-    free(processor);
+// Compute the SHA-224 digest of the JCS (RFC 8785) form of json[0..length)
+// without its omit members, the signing input of verifiers that check the
+// JSON rather than its RDF. The canonical text reaches the hash through a
+// 64-byte chunk, never as a second document.
+static cmox_hash_retval_t hashJCS(const char *json, size_t length, const char *omit, uint8_t *digest, size_t *digestSize)
+{
+    cmox_sha224_handle_t sha224;
+    DigestSink sink;
+    RDFArena scratch;
+    JSONWriter writer;
+    char chunk[64];
+
+    DigestSink_init(&sink, &sha224);
+    RDFArena_init(&scratch, canonScratch, sizeof(canonScratch));
+    JSONWriter_init(&writer, chunk, sizeof(chunk), DigestSink_write, &sink);
+    RDFStatus status = JSONCanon_write(json, length, omit, &scratch, &writer);
+    return DigestSink_finish(&sink, status, digest, digestSize);
 }
 
-// Function to process the RDF graph and store it in the output variable
-void processRDF(char *output) {
-    // Create a new RDF graph
-    RDFGraph *graph = RDFGraph_new();
+#ifndef CREDSIGN_JCS
+static void SHA256Sink_write(void *ctx, const char *data, size_t len)
+{
+    SHA256_update((SHA256Context *)ctx, data, len);
+}
 
-    // Add RDF triples to the graph
-    RDFGraph_addTriple(graph, "credential1", "ProofType", "EcdsaSignature2018");
-    RDFGraph_addTriple(graph, "credential1", "ProofCreated", "2025-10-23T05:50:16Z");
-    RDFGraph_addTriple(graph, "credential1", "VerificationMethod", "did:example:123456789abcdefghi#key1");
-    RDFGraph_addTriple(graph, "credential1", "ProofPurpose", "assertionMethod");
-    RDFGraph_addTriple(graph, "credential1", "jws", hexSignature); // Add the signature value
+// Compute the CREDENTIAL_HASH_SIZE digest of a graph's canonical N-Quads,
+// the hash the suite takes of the document and of the proof options alike.
+// The serializer feeds the hash context directly, the document is never
+// assembled in a buffer.
+static RDFStatus hashCanonical(const RDFGraph *graph, uint8_t digest[CREDENTIAL_HASH_SIZE])
+{
+    SHA256Context md;
+    RDFArena scratch;
+
+#ifdef CREDSIGN_EDDSA
+    SHA256_init(&md);
+#else
+    SHA224_init(&md);
+#endif
+    RDFArena_init(&scratch, canonScratch, sizeof(canonScratch));
+    RDFStatus status = RDFCanon_serialize(graph, &scratch, NULL, SHA256Sink_write, &md);
+    SHA256_final(&md, digest);
+    return status;
+}
 
-    // Serialize the RDF graph to JSON-LD format and store in output
-    RDFGraph_serializeToJsonLD(graph, output);
+// Hash the credential without its proof: the claims, or when none were
+// received the default claim, which writeCredential() adds in the same
+// way. That one never changes, so it is hashed once, in claimsGraph,
+// which is emptied again.
+static RDFStatus hashDocument(uint8_t digest[CREDENTIAL_HASH_SIZE])
+{
+    static uint8_t defaultDigest[CREDENTIAL_HASH_SIZE];
+    static int defaultHashed;
 
-    // Free the RDF graph resources
-    RDFGraph_free(graph);
+    if (claimsGraph.size != 0) {
+        return hashCanonical(&claimsGraph, digest);
+    }
+    if (!defaultHashed) {
+        RDFGraph_init(&claimsGraph, claimsArena, sizeof(claimsArena));
+        RDFStatus status = RDFGraph_addTriple(&claimsGraph, "_:credential", RDF_IRI_SCHEMA_DESCRIPTION, "\"Hello World!\"");
+        if (status == RDF_OK) status = hashCanonical(&claimsGraph, defaultDigest);
+        RDFGraph_init(&claimsGraph, claimsArena, sizeof(claimsArena));
+        if (status != RDF_OK) {
+            return status;
+        }
+        defaultHashed = 1;
+    }
+    memcpy(digest, defaultDigest, sizeof(defaultDigest));
+    return RDF_OK;
+}
+
+// The signing input from the two hashes, proof options then document, in
+// hashes[0..2 * CREDENTIAL_HASH_SIZE). EdDSA signs them as they are; ECDSA
+// signs one SHA-224 digest, so they are hashed once more.
+static void signingInput(const uint8_t *hashes, uint8_t digest[CREDENTIAL_DIGEST_SIZE])
+{
+#ifdef CREDSIGN_EDDSA
+    memmove(digest, hashes, CREDENTIAL_DIGEST_SIZE);
+#else
+    SHA256Context md;
+    SHA224_init(&md);
+    SHA256_update(&md, hashes, 2 * CREDENTIAL_HASH_SIZE);
+    SHA256_final(&md, digest);
+#endif
+}
+#endif
+
+// Compute the signing input of the credential: the hash of its canonical
+// proof options, then that of its canonical document, combined by
+// signingInput(). For the proof options the cache keeps the canonical
+// lines and digest state of the last credential, so only the lines from
+// the new created timestamp on are hashed again and RDFC runs only when
+// the graph had to be rebuilt.
+//
+// With CREDSIGN_JCS the whole credential but its jws is signed instead, in
+// JCS form, as JSON-only verifiers check it. It is written to output[],
+// which the signed credential overwrites afterwards, unless it is the
+// default credential, whose signing input is compiled in.
+cmox_hash_retval_t hashCredential(uint8_t *digest, size_t *digestSize)
+{
+#ifdef CREDSIGN_JCS
+    // The "Hello World!" credential's signing input is compiled in; its
+    // constant prefix is hashed once and resumed from after that
+    static SHA256Midstate signingPrefix;
+    if (claimsGraph.size == 0) {
+        const char *values[CREDENTIAL_HOLE_COUNT] = { [CREDENTIAL_HOLE_CREATED] = global_time };
+        if (signingPrefix.digestSize == 0) {
+            CredentialTemplate_signingPrefix(&signingPrefix);
+        }
+        if (CredentialTemplate_signingDigest(&signingPrefix, values, digest) == RDF_OK) {
+            *digestSize = SHA224_DIGEST_SIZE;
+            return CMOX_HASH_SUCCESS;
+        }
+    }
+    size_t length;
+    if (writeCredential(output, NULL, &length) != RDF_OK) {
+        return CMOX_HASH_ERR_INTERNAL;
+    }
+    return hashJCS(output, length, NULL, digest, digestSize);
+#else
+    RDFGraph *graph = &credentialGraph;
+    RDFArena scratch;
+    uint8_t hashes[2 * CREDENTIAL_HASH_SIZE];
+
+    RDFArena_init(&scratch, canonScratch, sizeof(canonScratch));
+    RDFStatus status = updateCredentialGraph(graph);
+    if (status == RDF_OK) status = RDFCanonCache_digest(&credentialCache, graph, &scratch, NULL, hashes);
+    if (status == RDF_OK) status = hashDocument(hashes + CREDENTIAL_HASH_SIZE);
+    if (status != RDF_OK) {
+        return CMOX_HASH_ERR_INTERNAL;
+    }
+    signingInput(hashes, digest);
+    *digestSize = CREDENTIAL_DIGEST_SIZE;
+    return CMOX_HASH_SUCCESS;
+#endif
 }
 
 
 /* Global Variables ----------------------------------------------------------*/
 cmox_ecc_handle_t Ecc_Ctx;           // ECC context
-#define Working_Buffer_Size 2000
-uint8_t Working_Buffer[Working_Buffer_Size];         // ECC working buffer
+// The credential key pair and its ECC context, set up once at boot
+static Signer signer;
+#ifdef CREDSIGN_EDDSA
+// The Ed25519 key pair credentials are signed with instead
+static Ed25519Signer edSigner;
+#endif
 uint32_t Computed_Random[8];          // Random data buffer
 
 RTC_HandleTypeDef hrtc;
@@ -210,18 +468,328 @@ void Print_Computed_Signature(const uint8_t *pSignature, size_t length);
 void Print_Computed_Keys(const uint8_t *data, size_t length);
 void UART_PrintSignature(const uint8_t *data, size_t length);
 void print_time(void);
+void Bench_UARTPrint(const char *line);
 
+// Set once the moment of a key press is in the nonce DRBG
+static int keyPressMixed;
+
+// Wait for a key press, filling the signer's pre-signature pool meanwhile.
+// The core clock (HSI) and the RTC (LSI) drift apart, so sampling both
+// feeds the nonce DRBG a little entropy per pre-signature; so does the
+// moment the key arrives. Nonces are only drawn ahead once one has.
 void UART_ReceiveChar(void)
 {
-    HAL_UART_Receive(&huart2, (uint8_t *)rx_buffer, 1, HAL_MAX_DELAY);
+    while (HAL_UART_Receive(&huart2, (uint8_t *)rx_buffer, 1, 1) != HAL_OK) {
+        if (keyPressMixed && Signer_presignCount(&signer) < SIGNER_PRESIGN_POOL) {
+            uint32_t jitter[2] = { DWT->CYCCNT, RTC->SSR };
+            Signer_addEntropy(&signer, jitter, sizeof(jitter));
+            Signer_presign(&signer);
+        }
+    }
+    uint32_t arrival = DWT->CYCCNT;
+    Signer_addEntropy(&signer, &arrival, sizeof(arrival));
+    keyPressMixed = 1;
     HAL_UART_Transmit(&huart2, (uint8_t *)rx_buffer, 1, HAL_MAX_DELAY); // Echo received character
 }
 
+// The last flash sector, 128 KB, holds the boot counter: one word per
+// boot, each the previous plus one, kept out of FLASH by the linker script
+#define BOOT_COUNTER_SECTOR FLASH_SECTOR_7
+#define BOOT_COUNTER_START ((const volatile uint32_t *)0x08060000)
+#define BOOT_COUNTER_WORDS (0x20000 / sizeof(uint32_t))
+
+// Count this boot and return the count. The UID, the RTC and the cycle
+// counter read the same after every power-up, so this is what keeps the
+// nonce DRBG from starting over. The word is programmed before the count
+// is used. Once the sector is full it is erased and the count goes on in
+// its first word; a power loss between the two restarts it, which the
+// clock drift sampled as well still covers.
+static uint32_t BootCounter_next(void)
+{
+    // The words in use come first, the erased ones read 0xFFFFFFFF
+    uint32_t used = 0, unused = BOOT_COUNTER_WORDS;
+    while (used < unused) {
+        uint32_t middle = used + (unused - used) / 2;
+        if (BOOT_COUNTER_START[middle] != 0xFFFFFFFFu) {
+            used = middle + 1;
+        } else {
+            unused = middle;
+        }
+    }
+    uint32_t count = (used ? BOOT_COUNTER_START[used - 1] : 0) + 1;
+
+    HAL_FLASH_Unlock();
+    if (used == BOOT_COUNTER_WORDS) {
+        FLASH_EraseInitTypeDef erase = {
+            .TypeErase = FLASH_TYPEERASE_SECTORS,
+            .Sector = BOOT_COUNTER_SECTOR,
+            .NbSectors = 1,
+            .VoltageRange = FLASH_VOLTAGE_RANGE_3,
+        };
+        uint32_t failedSector;
+        if (HAL_FLASHEx_Erase(&erase, &failedSector) != HAL_OK) {
+            Error_Handler();
+        }
+        used = 0;
+    }
+    if (HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, (uint32_t)&BOOT_COUNTER_START[used], count) != HAL_OK) {
+        Error_Handler();
+    }
+    HAL_FLASH_Lock();
+    return count;
+}
+
+// Time RTC subsecond ticks, LSI / 128, with the cycle counter, HSI: both
+// are RC oscillators, and the low bits of each interval vary with their
+// noise and drift. Takes about 4 ms a sample; DWT->CYCCNT has to run.
+static void sampleClockDrift(uint32_t *samples, int count)
+{
+    for (int i = 0; i < count; i++) {
+        uint32_t ssr = RTC->SSR, start = HAL_GetTick();
+        while (RTC->SSR == ssr && HAL_GetTick() - start < 10) {
+        }
+        samples[i] = DWT->CYCCNT;
+    }
+}
+
 void UART_SendString(char *str)
 {
     HAL_UART_Transmit(&huart2, (uint8_t *)str, strlen(str), HAL_MAX_DELAY);
 }
 
+/* Credential verification ---------------------------------------------------*/
+
+// Read a JSON-LD credential from USART2 into output[0..*received), parsing
+// each byte as it arrives. The graph's terms point into output[], which
+// must not change while the graph is in use.
+static RDFStatus receiveCredential(RDFGraph *graph, size_t *received)
+{
+    static uint8_t receivedArena[RECEIVED_ARENA_SIZE];
+    static JSONLDReader reader;
+    size_t length = 0;
+    RDFStatus status = RDF_OK;
+
+    RDFGraph_init(graph, receivedArena, sizeof(receivedArena));
+    JSONLDReader_init(&reader, graph, output);
+    while (status == RDF_OK && !JSONLDReader_done(&reader)) {
+        if (length == sizeof(output) - 1) {
+            status = RDF_ERR_OVERFLOW;
+        } else if (HAL_UART_Receive(&huart2, (uint8_t *)&output[length], 1, HAL_MAX_DELAY) != HAL_OK) {
+            status = RDF_ERR_INVALID;
+        } else {
+            status = JSONLDReader_feed(&reader, ++length);
+        }
+    }
+    output[length] = '\0';
+    *received = length;
+    return status;
+}
+
+// Claims the credential can make: statements of the default graph, which
+// the JSON-LD writer groups with the credential's, and no sec:proof, which
+// links the proof the verifier sets aside. Checked as they are read,
+// before anything is signed.
+static RDFStatus checkClaim(const RDFGraph *graph, const RDFTriple *claim)
+{
+    RDFTermId proof = RDFGraph_find(graph, RDF_IRI_SEC_PROOF, sizeof(RDF_IRI_SEC_PROOF) - 1);
+    return claim->graph == RDF_NO_TERM && claim->predicate != proof ? RDF_OK : RDF_ERR_INVALID;
+}
+
+// Read the credential's claims from USART2 as N-Quads, up to an empty
+// line. Each byte is parsed as it arrives; only the term being read is
+// buffered. line is where reading stopped.
+static RDFStatus receiveClaims(RDFGraph *graph, unsigned long *line)
+{
+    static NQuadsReader reader;
+    int checked = 0;
+    size_t lineLength = 0;
+    uint8_t c, previous = 0;
+    RDFStatus status = RDF_OK;
+
+    RDFGraph_init(graph, claimsArena, sizeof(claimsArena));
+    NQuadsReader_init(&reader, graph);
+    while (status == RDF_OK) {
+        if (HAL_UART_Receive(&huart2, &c, 1, HAL_MAX_DELAY) != HAL_OK) {
+            status = RDF_ERR_INVALID;
+            break;
+        }
+        if (c == '\r' || c == '\n') {
+            // "\r\n" is one line break
+            if (lineLength == 0 && !(previous == '\r' && c == '\n')) {
+                status = NQuadsReader_finish(&reader);
+                break;
+            }
+            lineLength = 0;
+        } else {
+            lineLength++;
+        }
+        previous = c;
+        status = NQuadsReader_feed(&reader, (const char *)&c, 1);
+        while (status == RDF_OK && checked < graph->size) {
+            status = checkClaim(graph, RDFGraph_triple(graph, checked++));
+        }
+    }
+    *line = reader.line;
+    // Grouped by subject and predicate once, for every credential
+    if (status == RDF_OK) RDFGraph_canonicalize(graph);
+    return status;
+}
+
+typedef struct {
+    RDFTermId graph;  // the proof graph
+    RDFTermId value;  // the signature property, jws or proofValue
+} ProofOptions;
+
+// Keep the proof graph's statements but the signature, moved to the
+// default graph
+static int keepProofOptions(void *ctx, RDFTriple *quad)
+{
+    const ProofOptions *proof = (const ProofOptions *)ctx;
+    if (quad->graph != proof->graph || quad->predicate == proof->value) {
+        return 0;
+    }
+    quad->graph = RDF_NO_TERM;
+    return 1;
+}
+
+#ifndef CREDSIGN_EDDSA
+static int hexNibble(char c)
+{
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+#endif
+
+#ifndef CREDSIGN_JCS
+// Proof statements a received credential may have besides its signature
+#define PROOF_MAX_QUADS 8
+
+// Keep the credential without its proof: the default graph but the link
+// to the proof, the only sec:proof statement receiveClaims() lets through
+static int keepDocument(void *ctx, RDFTriple *quad)
+{
+    RDFTermId proofProperty = *(const RDFTermId *)ctx;
+    return quad->graph == RDF_NO_TERM && quad->predicate != proofProperty;
+}
+
+// The signing input of a received credential, as hashCredential() makes
+// it. The proof options are set aside while the graph is cut down to the
+// document and hashed, then they replace it and are hashed in turn.
+static RDFStatus hashReceivedCredential(RDFGraph *graph, ProofOptions *proof, RDFTermId proofProperty,
+                                        uint8_t digest[CREDENTIAL_DIGEST_SIZE])
+{
+    uint8_t hashes[2 * CREDENTIAL_HASH_SIZE];
+    RDFTriple options[PROOF_MAX_QUADS];
+    int count = 0;
+
+    for (int i = 0; i < graph->size; i++) {
+        RDFTriple quad = *RDFGraph_triple(graph, i);
+        if (keepProofOptions(proof, &quad)) {
+            if (count == PROOF_MAX_QUADS) {
+                return RDF_ERR_LIMIT;
+            }
+            options[count++] = quad;
+        }
+    }
+    RDFGraph_filter(graph, keepDocument, &proofProperty);
+    RDFStatus status = hashCanonical(graph, hashes + CREDENTIAL_HASH_SIZE);
+    RDFGraph_truncate(graph, 0);
+    for (int i = 0; i < count && status == RDF_OK; i++) {
+        status = RDFGraph_addQuadIds(graph, options[i].subject, options[i].predicate, options[i].object, RDF_NO_TERM);
+    }
+    if (status == RDF_OK) status = hashCanonical(graph, hashes);
+    if (status == RDF_OK) signingInput(hashes, digest);
+    return status;
+}
+#endif
+
+// Check a received credential's signature against the public key of the
+// suite. The digest covers the same statements hashCredential() signs: the
+// proof without its signature value and the document, or with CREDSIGN_JCS
+// the received document, output[0..length), without jws.
+static cmox_ecc_retval_t verifyCredential(RDFGraph *graph, size_t length, const uint8_t *publicKey)
+{
+    uint8_t signature[CMOX_ECC_SECP256R1_SIG_LEN];
+    uint8_t digest[CREDENTIAL_DIGEST_SIZE];
+    size_t digestSize;
+    RDFTermId proofProperty = RDFGraph_find(graph, RDF_IRI_SEC_PROOF, sizeof(RDF_IRI_SEC_PROOF) - 1);
+    RDFTermId signatureValue = RDF_NO_TERM;
+    ProofOptions proof;
+    RDFTripleRange range;
+    static RDFIndex index;
+
+    // Credentials may carry many claims; the proof statements are looked
+    // up by predicate instead of scanning them all
+    RDFIndex_init(&index, graph);
+    proof.graph = RDF_NO_TERM;
+    proof.value = RDFGraph_find(graph, CREDENTIAL_SIGNATURE_IRI, sizeof(CREDENTIAL_SIGNATURE_IRI) - 1);
+    if (proofProperty == RDF_NO_TERM || proof.value == RDF_NO_TERM) {
+        return CMOX_ECC_AUTH_FAIL;
+    }
+    range = RDFIndex_match(&index, RDF_NO_TERM, proofProperty, RDF_NO_TERM);
+    for (int i = 0; i < range.count; i++) {
+        const RDFTriple *quad = RDFGraph_triple(graph, range.pos[i]);
+        if (quad->graph == RDF_NO_TERM) {
+            proof.graph = quad->object;
+        }
+    }
+    range = RDFIndex_match(&index, RDF_NO_TERM, proof.value, RDF_NO_TERM);
+    for (int i = 0; i < range.count; i++) {
+        const RDFTriple *quad = RDFGraph_triple(graph, range.pos[i]);
+        if (quad->graph == proof.graph && proof.graph != RDF_NO_TERM) {
+            signatureValue = quad->object;
+        }
+    }
+
+    // jws holds the hex signature as a plain literal, "<hex>"; proofValue
+    // the multibase one, "z<base58>"
+    if (signatureValue == RDF_NO_TERM || RDFGraph_termKind(graph, signatureValue) != RDF_TERM_LITERAL) {
+        return CMOX_ECC_AUTH_FAIL;
+    }
+    size_t textLength;
+    const char *text = RDFGraph_literalLexical(graph, signatureValue, &textLength);
+#ifdef CREDSIGN_EDDSA
+    if (!Multibase_decode(text, textLength, signature, sizeof(signature))) {
+        return CMOX_ECC_AUTH_FAIL;
+    }
+#else
+    if (textLength != 2 * sizeof(signature)) {
+        return CMOX_ECC_AUTH_FAIL;
+    }
+    for (size_t i = 0; i < sizeof(signature); i++) {
+        int high = hexNibble(text[2 * i]), low = hexNibble(text[2 * i + 1]);
+        if (high < 0 || low < 0) return CMOX_ECC_AUTH_FAIL;
+        signature[i] = (uint8_t)(high << 4 | low);
+    }
+#endif
+
+#if defined(CREDSIGN_EDDSA)
+    (void)length;
+    (void)digestSize;
+    if (hashReceivedCredential(graph, &proof, proofProperty, digest) != RDF_OK) {
+        return CMOX_ECC_AUTH_FAIL;
+    }
+    return Ed25519Signer_verify(&edSigner, publicKey, digest, sizeof(digest), signature)
+           ? CMOX_ECC_AUTH_SUCCESS : CMOX_ECC_AUTH_FAIL;
+#elif defined(CREDSIGN_JCS)
+    // The received document is still in output[]
+    if (hashJCS(output, length, "jws", digest, &digestSize) != CMOX_HASH_SUCCESS
+        || digestSize != sizeof(digest)) {
+        return CMOX_ECC_AUTH_FAIL;
+    }
+    return Signer_verify(&signer, publicKey, digest, sizeof(digest), signature);
+#else
+    (void)length;
+    (void)digestSize;
+    if (hashReceivedCredential(graph, &proof, proofProperty, digest) != RDF_OK) {
+        return CMOX_ECC_AUTH_FAIL;
+    }
+    return Signer_verify(&signer, publicKey, digest, sizeof(digest), signature);
+#endif
+}
+
 
 /* Data Buffers --------------------------------------------------------------*/
 //const uint8_t Message[] = {"This is a test message"};
@@ -256,7 +824,7 @@ const uint8_t your_sk[] = {
 //    0x25, 0x9e, 0x76, 0x0f, 0x0f, 0x71, 0x8b, 0xa9, 0x33, 0xfd, 0x09, 0x8f, 0x6f, 0x75, 0xd4, 0xb7
 //};
 
-uint8_t Computed_Hash[CMOX_SHA224_SIZE];                 // Computed hash buffer
+uint8_t Computed_Hash[2 * CMOX_SHA256_SIZE];             // Computed hash buffer, fits either suite's signing input
 uint8_t Computed_Signature[CMOX_ECC_SECP256R1_SIG_LEN];  // Computed signature buffer
 
 /* Functions Definition ------------------------------------------------------*/
@@ -279,7 +847,7 @@ int main(void)
     cmox_hash_retval_t hretval;
     cmox_ecc_retval_t retval;
     size_t computed_size;
-    uint32_t fault_check = CMOX_ECC_AUTH_FAIL;
+    size_t outputLength = 0;   // bytes of output[] in use, not its size
 
     HAL_Init();               // STM32 HAL initialization
     SystemClock_Config();      // System clock configuration
@@ -294,10 +862,6 @@ int main(void)
 
     uint32_t start_time = 0;
 
-    char Message[MAX_MESSAGE_SIZE] = {0};
-    // Call the RDF processing function and pass the Message variable
-    processRDF(Message);
-
     uint8_t private_key[32];
     uint8_t private_key_len = sizeof(private_key);
     uint8_t public_key[32];
@@ -306,31 +870,37 @@ int main(void)
     size_t shared_secret_len;
     uint8_t aes_key[32];
 
-    uint8_t privKey[32];
-    size_t privKeyLen = sizeof(privKey);
-    uint8_t pubKey[64];
-    size_t pubKeyLen = sizeof(pubKey);
-
     UART_SendString("\r\nWelcome credentials signing application!\r\n");
     UART_SendString("\r\nPress 1 to generate verifiable credentials or 2 to verify your credentials:\r\n");
+#ifdef CREDSIGN_BENCH
+    UART_SendString("(Press 3 to run the benchmarks)\r\n");
+#endif
 
-	const cmox_ecc_impl_t curveParams = CMOX_ECC_SECP256R1_HIGHMEM;
-
-	    cmox_ecc_construct(&Ecc_Ctx, CMOX_MATH_FUNCS_FAST, Working_Buffer, Working_Buffer_Size);
-
-	    retval = cmox_ecdsa_keyGen(&Ecc_Ctx, curveParams, Known_Random, sizeof(Known_Random), privKey, &privKeyLen, pubKey, &pubKeyLen);
+	    // The ECC context and key pair live as long as the firmware runs
+	    retval = Signer_init(&signer, Known_Random, sizeof(Known_Random));
 	    if (retval != CMOX_ECC_SUCCESS) {
 	        UART_Print("Key generation failed");
 	        return -1;
 	    }
+	    // What tells this boot from the last one, for the nonces, before
+	    // any is drawn: the boot count, then the clock drift
+	    uint32_t bootEntropy[4] = { HAL_GetUIDw0(), HAL_GetUIDw1(), HAL_GetUIDw2(), BootCounter_next() };
+	    uint32_t drift[16];
+	    Signer_addEntropy(&signer, bootEntropy, sizeof(bootEntropy));
+	    sampleClockDrift(drift, sizeof(drift) / sizeof(drift[0]));
+	    Signer_addEntropy(&signer, drift, sizeof(drift));
+	    Signer_addEntropy(&signer, global_time, strlen(global_time));
+#ifdef CREDSIGN_EDDSA
+	    Ed25519Signer_init(&edSigner, Known_Random, sizeof(Known_Random));
+#endif
 
 
 //	    UART_Print("Private key: ");
-//	    Print_Computed_Keys(privKey, privKeyLen);
+//	    Print_Computed_Keys(signer.privateKey, sizeof(signer.privateKey));
 //	    UART_Print("\r\n");
 //
 //	    UART_Print("Public key: ");
-//	    Print_Computed_Keys(pubKey, pubKeyLen);
+//	    Print_Computed_Keys(signer.publicKey, sizeof(signer.publicKey));
 //	    UART_Print("\r\n");
 
     UART_ReceiveChar(); // Wait for user input
@@ -339,133 +909,130 @@ int main(void)
     if (rx_buffer[0] == '1')
     {
 	    UART_Print("\r\n");
-	    UART_Print("Generating ECDSA verifiable credentials...\r\n");
+	    UART_Print("Paste the credential's claims (N-Quads) and end them with an empty line,\r\n");
+	    UART_Print("or press Enter to keep the default claim:\r\n");
+	    unsigned long claimsLine;
+	    if (receiveClaims(&claimsGraph, &claimsLine) != RDF_OK)
+	    {
+	        snprintf(tx_buffer, sizeof(tx_buffer), "The claims could not be read (line %lu); using the default claim.\r\n", claimsLine);
+	        UART_Print(tx_buffer);
+	        RDFGraph_truncate(&claimsGraph, 0);
+	    }
+	    UART_Print("\r\n");
+	    UART_Print("Generating " CREDENTIAL_SUITE_NAME " verifiable credentials...\r\n");
 	    UART_Print("\r\n");
         /* Generate an interrupt every 1ms */
         HAL_SYSTICK_Config(HAL_RCC_GetHCLKFreq() / 1000);
         start_time = HAL_GetTick();
 
-    	    // Compute the SHA-224 digest
-    	    hretval = cmox_hash_compute(CMOX_SHA224_ALGO,
-    	                                Message, sizeof(Message),
-    	                                Computed_Hash, CMOX_SHA224_SIZE,
-    	                                &computed_size);
+    	    // Compute the signing input of the canonical credential
+    	    hretval = hashCredential(Computed_Hash, &computed_size);
 
     	    // Check if hash computation was successful
-    	    if (hretval != CMOX_HASH_SUCCESS || computed_size != CMOX_SHA224_SIZE)
+    	    if (hretval != CMOX_HASH_SUCCESS || computed_size != CREDENTIAL_DIGEST_SIZE)
     	    {
     	        UART_Print("Hash computation failed.\r\n");
     	        Error_Handler();
     	    }
 
 
-    	    // Construct ECC context
-    	    cmox_ecc_construct(&Ecc_Ctx, CMOX_ECC256_MATH_FUNCS, Working_Buffer, sizeof(Working_Buffer));
+#ifdef CREDSIGN_EDDSA
+    	    // Compute the Ed25519 signature; EdDSA derives its nonce, no pool
+    	    Ed25519Signer_sign(&edSigner, Computed_Hash, computed_size, Computed_Signature);
+    	    uint32_t signCycles = edSigner.cycles;
+    	    Multibase_encode(Computed_Signature, ED25519_SIGNATURE_SIZE, hexSignature, sizeof(hexSignature));
 
-    	    // Compute the ECDSA signature
-    	    retval = cmox_ecdsa_sign(&Ecc_Ctx,
-    	                             CMOX_ECC_CURVE_SECP256R1,
-    	                             Known_Random, sizeof(Known_Random),
-    								 privKey, sizeof(privKey),
-    	                             Computed_Hash, CMOX_SHA224_SIZE,
-    	                             Computed_Signature, &computed_size);
+    	    // Check it against the public key before handing it out
+    	    if (!Ed25519Signer_verify(&edSigner, NULL, Computed_Hash, computed_size, Computed_Signature))
+    	    {
+    	        UART_Print("Signature verification failed.\r\n");
+    	        Error_Handler();
+    	    }
+    	    snprintf(tx_buffer, sizeof(tx_buffer), "Signed in %lu cycles, verified in %lu cycles.\r\n",
+    	             (unsigned long)signCycles, (unsigned long)edSigner.cycles);
+    	    UART_Print(tx_buffer);
+#else
+    	    // Compute the ECDSA signature, from a pre-signature when the pool has one
+    	    int presigned = Signer_presignCount(&signer);
+    	    retval = Signer_sign(&signer, Computed_Hash, CMOX_SHA224_SIZE, Computed_Signature);
+    	    uint32_t signCycles = signer.cycles;
 
     	    // Verify the signature computation
-    	    if (retval != CMOX_ECC_SUCCESS || computed_size != sizeof(Computed_Signature))
+    	    if (retval != CMOX_ECC_SUCCESS)
     	    {
-    	        Print_Computed_Signature(Computed_Signature, computed_size);
+    	        Print_Computed_Signature(Computed_Signature, sizeof(Computed_Signature));
     	        Error_Handler();
     	    }
-    	    UART_PrintSignature(Computed_Signature, computed_size);
-
-    	    cmox_ecc_cleanup(&Ecc_Ctx);  // Clean up ECC context
+    	    UART_PrintSignature(Computed_Signature, sizeof(Computed_Signature));
 
-    	    cmox_ecc_construct(&Ecc_Ctx, CMOX_ECC256_MATH_FUNCS, Working_Buffer, sizeof(Working_Buffer));
-    	    retval = cmox_ecdsa_verify(&Ecc_Ctx,                                  /* ECC context */
-    	                               CMOX_ECC_CURVE_SECP256R1,                  /* SECP256R1 ECC curve selected */
-    								   pubKey, sizeof(pubKey),            /* Public key for verification */
-    	                               Computed_Hash, CMOX_SHA224_SIZE,           /* Digest to verify */
-    								   Computed_Signature, sizeof(Computed_Signature),  /* Data buffer to receive signature */
-    	                               &fault_check);                             /* Fault check variable:*/
+    	    // Check it against the public key before handing it out
+    	    if (Signer_verify(&signer, NULL, Computed_Hash, CMOX_SHA224_SIZE, Computed_Signature) != CMOX_ECC_AUTH_SUCCESS)
+    	    {
+    	        UART_Print("Signature verification failed.\r\n");
+    	        Error_Handler();
+    	    }
+    	    snprintf(tx_buffer, sizeof(tx_buffer), "Signed in %lu cycles (%d pre-signatures ready), verified in %lu cycles.\r\n",
+    	             (unsigned long)signCycles, presigned, (unsigned long)signer.cycles);
+    	    UART_Print(tx_buffer);
+#endif
 
-    	    processRDF(Message);
+    	    if (processRDF(output, &outputLength) != RDF_OK)
+    	    {
+    	        UART_Print("Credential does not fit the output buffer.\r\n");
+    	    }
 
-    	    // Print the Message variable
-    	    UART_Print(Message);
+    	    // Print the signed credential
+    	    UART_Print(output);
     	    UART_Print("\r\n");
-
-
-    	    /* Cleanup context */
-    	    cmox_ecc_cleanup(&Ecc_Ctx);
     }
     else if (rx_buffer[0] == '2')
         {
     	HAL_SYSTICK_Config(HAL_RCC_GetHCLKFreq() / 1000);
+    	UART_Print("\r\n");
+    	UART_Print("Paste the signed credential (JSON-LD):\r\n");
+
+    	static RDFGraph receivedGraph;
+    	RDFStatus status = receiveCredential(&receivedGraph, &outputLength);
     	start_time = HAL_GetTick();
-    	char json_message[] =
-    	    "{\r\n"
-    	    "  \"@context\": [\"http://schema.org/\", \"https://w3id.org/security/v2\"],\r\n"
-    	    "  \"description\": \"Hello World!\",\r\n"
-    	    "  \"proof\": {\r\n"
-    		"    \"type\": \"EcdsaSignature2018\",\r\n"
-    	    "    \"created\": \"2000-01-01T00:00:00Z\",\r\n"
-    		"    \"verificationMethod\": \"did:example:123456789abcdefghi#key1\",\r\n"
-    	    "    \"proofPurpose\": \"assertionMethod\",\r\n"
-    	    "    \"jws\": \"4A19274429E40522234B8785DC25FC524F179DCC95FF09B3C9770FC71F54CA0DF807B5A408D092F725CC8C650B241AB2B3EAF436C9E1D064A069B1F51B9A6052\"\r\n"
-    	    "  }\r\n"
-    	    "}\r\n";
-
-    	//processRDF(json_message);
-
-//        if (strcmp(json_message, Message) == 0) {
-//        	UART_Print("The strings are equal.\n");
-//        } else {
-//        	UART_Print("The strings are NOT equal.\n");
-//        }
-        //UART_Print(Message);
-        //UART_Print(json_message);
     	UART_Print("\r\n");
     	UART_Print("Verifying  credentials, Please wait...\r\n");
     	UART_Print("\r\n");
 
-    	strcpy(Message, json_message);
-//    	processRDF(Message);
-    	UART_Print(Message);
-    	UART_Print("\r\n");
-//            UART_SendString("\r\nEnter a string: ");
-//
-//            char user_input[9999] = {0};
-//            int index = 0;
-//
-//            while (1)
-//            {
-//                UART_ReceiveChar();
-//
-//                if (rx_buffer[0] == '\r') // Check for Enter key (Carriage Return)
-//                {
-//                    user_input[index] = '\0'; // Null-terminate the string
-//                    break;
-//                }
-//
-//                user_input[index++] = rx_buffer[0];
-//                if (index >= 1023)
-//                {
-//                    UART_SendString("\r\nInput too long!\r\n");
-//                    break;
-//                }
-//            }
-//
-//            snprintf(tx_buffer, sizeof(tx_buffer), "\r\nYou entered: %s\r\n", user_input);
-//            UART_SendString(tx_buffer);
+    	if (status != RDF_OK)
+    	{
+    	    UART_Print("The credential could not be read.\r\n");
+    	}
+#ifdef CREDSIGN_EDDSA
+    	else if (verifyCredential(&receivedGraph, outputLength, edSigner.publicKey) == CMOX_ECC_AUTH_SUCCESS)
+#else
+    	else if (verifyCredential(&receivedGraph, outputLength, signer.publicKey) == CMOX_ECC_AUTH_SUCCESS)
+#endif
+    	{
+    	    UART_Print("Credential signature verified.\r\n");
+    	}
+    	else
+    	{
+    	    UART_Print("Credential signature is NOT valid.\r\n");
+    	}
+    	RDFGraph_free(&receivedGraph);
         }
+#ifdef CREDSIGN_BENCH
+        else if (rx_buffer[0] == '3')
+        {
+            UART_Print("\r\nRunning benchmarks...\r\n");
+            Bench_init();
+            Bench_runAll(Bench_UARTPrint);
+        }
+#endif
         else
         {
             UART_SendString("\r\nInvalid input. Press 1 or 2.\r\n");
         }
 
-    // Compute the SHA-224 digest
+    // Compute the SHA-224 digest of the credential output[] holds, not of
+    // the padding after it
     hretval = cmox_hash_compute(CMOX_SHA224_ALGO,
-                                Message, sizeof(Message),
+                                (const uint8_t *)output, outputLength,
                                 Computed_Hash, CMOX_SHA224_SIZE,
                                 &computed_size);
 
@@ -477,44 +1044,26 @@ int main(void)
     }
 
 
-    // Construct ECC context
-    cmox_ecc_construct(&Ecc_Ctx, CMOX_ECC256_MATH_FUNCS, Working_Buffer, sizeof(Working_Buffer));
-
     // Compute the ECDSA signature
-    retval = cmox_ecdsa_sign(&Ecc_Ctx,
-                             CMOX_ECC_CURVE_SECP256R1,
-                             Known_Random, sizeof(Known_Random),
-							 privKey, sizeof(privKey),
-                             Computed_Hash, CMOX_SHA224_SIZE,
-                             Computed_Signature, &computed_size);
+    retval = Signer_sign(&signer, Computed_Hash, CMOX_SHA224_SIZE, Computed_Signature);
 
     // Verify the signature computation
-    if (retval != CMOX_ECC_SUCCESS || computed_size != sizeof(Computed_Signature))
+    if (retval != CMOX_ECC_SUCCESS)
     {
         UART_Print("Signature computation failed.\r\n");
-        Print_Computed_Signature(Computed_Signature, computed_size);
+        Print_Computed_Signature(Computed_Signature, sizeof(Computed_Signature));
         Error_Handler();
     }
 
     UART_Print("Signature computed successfully.\r\n");
 
     UART_Print("Computed Signature: ");
-    Print_Computed_Signature(Computed_Signature, computed_size);
+    Print_Computed_Signature(Computed_Signature, sizeof(Computed_Signature));
     //Print_Computed_Signature(Computed_Signature, computed_size);
     UART_Print("\r\n");
 
-    cmox_ecc_cleanup(&Ecc_Ctx);  // Clean up ECC context
-
-    cmox_ecc_construct(&Ecc_Ctx, CMOX_ECC256_MATH_FUNCS, Working_Buffer, sizeof(Working_Buffer));
-    retval = cmox_ecdsa_verify(&Ecc_Ctx,                                  /* ECC context */
-                               CMOX_ECC_CURVE_SECP256R1,                  /* SECP256R1 ECC curve selected */
-							   pubKey, sizeof(pubKey),            /* Public key for verification */
-                               Computed_Hash, CMOX_SHA224_SIZE,           /* Digest to verify */
-							   Computed_Signature, sizeof(Computed_Signature),  /* Data buffer to receive signature */
-                               &fault_check);                             /* Fault check variable:*/
-
     // Check if the verification succeeded
-    if (retval != CMOX_ECC_AUTH_SUCCESS || fault_check != CMOX_ECC_AUTH_SUCCESS)
+    if (Signer_verify(&signer, NULL, Computed_Hash, CMOX_SHA224_SIZE, Computed_Signature) != CMOX_ECC_AUTH_SUCCESS)
     {
         UART_Print("Signature verification failed.\r\n");
         Error_Handler();
@@ -526,7 +1075,6 @@ int main(void)
 
     uint32_t end_time = HAL_GetTick();
     print_execution_time(start_time, end_time);
-    cmox_ecc_cleanup(&Ecc_Ctx);
 
     //processRDF(Message);
 
@@ -682,6 +1230,15 @@ void Print_Computed_Keys(const uint8_t *data, size_t length)
     UART_Print(keysHex);
 }
 
+/**
+  * @brief Print one benchmark report line over UART
+  */
+void Bench_UARTPrint(const char *line)
+{
+    UART_Print((char *)line);
+    UART_Print("\r\n");
+}
+
 /**
   * @brief Print string over UART
   */
@@ -2032,6 +2032,104 @@ int crypto_eddsa_check_equation(const u8 signature[64], const u8 public_key[32],
 	return crypto_verify32(check, zero_point);
 }
 
+// Batch verification (local addition, not part of upstream Monocypher)
+//
+// For weights z_i, checks the sum of the individual equations
+//   [8](sum(z_i * ([s_i]B - R_i - [h_i]A_i))) == 0
+// as one multi-scalar multiplication (Straus): every point gets its own
+// sliding window table, and all of them share a single chain of 253
+// doublings.  The base point takes the summed scalar sum(z_i * s_i).
+// With random, secret 128-bit weights, a batch that holds a forgery
+// passes with probability about 2^-128.
+//
+// Batches are capped at CRYPTO_EDDSA_BATCH_MAX.  Straus only shares the
+// doublings; each point still pays about 60 additions of its own.  At 16
+// items the shared doublings are already under a tenth of the work, so
+// larger batches barely gain, while the tables cost stack for every item.
+// Pippenger or Bos-Coster would keep gaining, but only overtake Straus
+// at hundreds of signatures, and would need heap-sized scratch.  Callers
+// with large batches check them in runs of CRYPTO_EDDSA_BATCH_MAX.
+#define BATCH_W_WIDTH 4 // Affects the size of the stack
+#define BATCH_W_SIZE  (1<<(BATCH_W_WIDTH-2))
+
+static void batch_lut(ge_cached lut[BATCH_W_SIZE], const ge *p)
+{
+	ge p2, tmp;
+	ge_double(&p2, p, &tmp);
+	ge_cache(&lut[0], p);
+	FOR (i, 1, BATCH_W_SIZE) {
+		ge_add(&tmp, &p2, &lut[i-1]);
+		ge_cache(&lut[i], &tmp);
+	}
+}
+
+int crypto_eddsa_check_batch_equation(const u8 *const signatures[],
+                                      const u8 *const public_keys[],
+                                      const u8 h_rams[][32],
+                                      const u8 weights[][16],
+                                      size_t count)
+{
+	if (count > CRYPTO_EDDSA_BATCH_MAX) {
+		return -1;
+	}
+
+	// Points -A_i and -R_i with their scalars z_i * h_i and z_i
+	static const u8 zero[32] = {0};
+	ge_cached  lut    [2 * CRYPTO_EDDSA_BATCH_MAX][BATCH_W_SIZE];
+	u8         scalar [2 * CRYPTO_EDDSA_BATCH_MAX][32];
+	slide_ctx  slide  [2 * CRYPTO_EDDSA_BATCH_MAX];
+	u8         b_scalar[32] = {0};
+	FOR (i, 0, count) {
+		ge minus_A, minus_R;
+		u32 s32[8];
+		u8  z[32] = {0};
+		load32_le_buf(s32, signatures[i] + 32, 8);
+		if (ge_frombytes_neg_vartime(&minus_A, public_keys[i]) ||
+		    ge_frombytes_neg_vartime(&minus_R, signatures[i])  ||
+		    is_above_l(s32)) {
+			return -1;
+		}
+		COPY(z, weights[i], 16);
+		crypto_eddsa_mul_add(scalar[2*i], z, h_rams[i], zero);
+		COPY(scalar[2*i + 1], z, 32);
+		crypto_eddsa_mul_add(b_scalar, z, signatures[i] + 32, b_scalar);
+		batch_lut(lut[2*i    ], &minus_A);
+		batch_lut(lut[2*i + 1], &minus_R);
+	}
+
+	size_t nb_points = 2 * count;
+	slide_ctx b_slide;  slide_init(&b_slide, b_scalar);
+	int i = b_slide.next_check;
+	FOR (j, 0, nb_points) {
+		slide_init(&slide[j], scalar[j]);
+		i = MAX(i, slide[j].next_check);
+	}
+
+	ge sum, tmp;
+	ge_zero(&sum);
+	while (i >= 0) {
+		ge_double(&sum, &sum, &tmp);
+		FOR (j, 0, nb_points) {
+			int digit = slide_step(&slide[j], BATCH_W_WIDTH, i, scalar[j]);
+			if (digit > 0) { ge_add(&sum, &sum, &lut[j][ digit / 2]); }
+			if (digit < 0) { ge_sub(&sum, &sum, &lut[j][-digit / 2]); }
+		}
+		int b_digit = slide_step(&b_slide, B_W_WIDTH, i, b_scalar);
+		fe t1, t2;
+		if (b_digit > 0) { ge_madd(&sum, &sum, b_window +  b_digit/2, t1, t2); }
+		if (b_digit < 0) { ge_msub(&sum, &sum, b_window + -b_digit/2, t1, t2); }
+		i--;
+	}
+
+	u8 check[32];
+	static const u8 zero_point[32] = {1}; // Point of order 1
+	ge_double(&sum, &sum, &tmp);
+	ge_double(&sum, &sum, &tmp);
+	ge_double(&sum, &sum, &tmp);
+	ge_tobytes(check, &sum);
+	return crypto_verify32(check, zero_point);
+}
+
 // 5-bit signed comb in cached format (Niels coordinates, Z=1)
 static const ge_precomp b_comb_low[8] = {
 	{{-6816601,-2324159,-22559413,124364,18015490,
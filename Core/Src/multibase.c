@@ -0,0 +1,82 @@
+#include "multibase.h"
+
+#include <string.h>
+
+static const char base58Digits[] = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+
+static int base58Value(char c)
+{
+    const char *digit = c ? strchr(base58Digits, c) : NULL;
+    return digit ? (int)(digit - base58Digits) : -1;
+}
+
+// Each leading zero byte is a '1'; the rest is the number in base 58,
+// worked out digit by digit in out itself
+size_t Multibase_encode(const uint8_t *data, size_t length, char *out, size_t size)
+{
+    size_t zeros = 0;
+    while (zeros < length && data[zeros] == 0) zeros++;
+    size_t digits = (length - zeros) * 138 / 100 + 1;   // log(256) / log(58)
+    if (size < 2 + zeros + digits) {
+        return 0;
+    }
+
+    uint8_t *number = (uint8_t *)out + 1 + zeros;
+    size_t high = digits;     // first digit written so far
+    memset(number, 0, digits);
+    for (size_t i = zeros; i < length; i++) {
+        unsigned carry = data[i];
+        size_t j = digits;
+        while (j > high || carry) {
+            j--;
+            carry += 256u * number[j];
+            number[j] = (uint8_t)(carry % 58);
+            carry /= 58;
+        }
+        high = j;
+    }
+
+    size_t skip = 0;
+    while (skip < digits && number[skip] == 0) skip++;
+    memmove(number, number + skip, digits - skip);
+    out[0] = 'z';
+    memset(out + 1, '1', zeros);
+    for (size_t i = 0; i < digits - skip; i++) {
+        out[1 + zeros + i] = base58Digits[number[i]];
+    }
+    size_t written = 1 + zeros + digits - skip;
+    out[written] = '\0';
+    return written;
+}
+
+int Multibase_decode(const char *text, size_t textLength, uint8_t *out, size_t outLength)
+{
+    if (textLength < 1 || text[0] != 'z') {
+        return 0;
+    }
+    size_t ones = 1;
+    while (ones < textLength && text[ones] == '1') ones++;
+    ones--;
+
+    memset(out, 0, outLength);
+    for (size_t i = 1 + ones; i < textLength; i++) {
+        int value = base58Value(text[i]);
+        if (value < 0) {
+            return 0;
+        }
+        unsigned carry = (unsigned)value;
+        for (size_t j = outLength; j-- > 0;) {
+            carry += 58u * out[j];
+            out[j] = (uint8_t)carry;
+            carry >>= 8;
+        }
+        if (carry) {
+            return 0;   // more than outLength bytes
+        }
+    }
+
+    // Exactly outLength bytes: the zero bytes in front are the '1's
+    size_t zeros = 0;
+    while (zeros < outLength && out[zeros] == 0) zeros++;
+    return zeros == ones;
+}
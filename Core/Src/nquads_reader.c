@@ -0,0 +1,393 @@
+#include "nquads_reader.h"
+
+#include <string.h>
+
+static const char xsdString[] = "http://www.w3.org/2001/XMLSchema#string";
+
+// state: what the byte at hand continues
+enum {
+    STATE_LINE,             // between terms
+    STATE_END,              // after the '.' of a statement
+    STATE_COMMENT,
+    STATE_IRI,
+    STATE_BLANK_COLON,      // read "_"
+    STATE_BLANK_START,      // read "_:"
+    STATE_BLANK,
+    STATE_LITERAL,
+    STATE_AFTER_LITERAL,    // read the closing quote
+    STATE_LANG_START,
+    STATE_LANG,
+    STATE_CARET,            // read the first '^'
+    STATE_DATATYPE,         // read "^^"
+    STATE_ESCAPE,           // read a backslash
+    STATE_HEX
+};
+
+void NQuadsReader_init(NQuadsReader *reader, RDFGraph *graph)
+{
+    reader->graph = graph;
+    reader->count = 0;
+    reader->state = STATE_LINE;
+    reader->resume = STATE_LINE;
+    reader->digits = 0;
+    reader->dots = 0;
+    reader->codePoint = 0;
+    reader->datatype = 0;
+    reader->line = 1;
+    reader->termLength = 0;
+}
+
+/* Terms ---------------------------------------------------------------------*/
+
+static RDFStatus internFailure(const RDFGraph *graph)
+{
+    return graph->termCount >= RDF_MAX_TERMS ? RDF_ERR_TERMS_FULL : RDF_ERR_ARENA_FULL;
+}
+
+static RDFStatus append(NQuadsReader *reader, const char *data, size_t len)
+{
+    if (len > sizeof(reader->term) - reader->termLength) {
+        return RDF_ERR_LIMIT;
+    }
+    memcpy(reader->term + reader->termLength, data, len);
+    reader->termLength += len;
+    return RDF_OK;
+}
+
+static RDFStatus appendUtf8(NQuadsReader *reader, uint32_t cp)
+{
+    char out[4];
+    size_t n;
+    if (cp < 0x80) {
+        out[0] = (char)cp;
+        n = 1;
+    } else if (cp < 0x800) {
+        out[0] = (char)(0xC0 | (cp >> 6));
+        out[1] = (char)(0x80 | (cp & 0x3F));
+        n = 2;
+    } else if (cp < 0x10000) {
+        out[0] = (char)(0xE0 | (cp >> 12));
+        out[1] = (char)(0x80 | ((cp >> 6) & 0x3F));
+        out[2] = (char)(0x80 | (cp & 0x3F));
+        n = 3;
+    } else {
+        out[0] = (char)(0xF0 | (cp >> 18));
+        out[1] = (char)(0x80 | ((cp >> 12) & 0x3F));
+        out[2] = (char)(0x80 | ((cp >> 6) & 0x3F));
+        out[3] = (char)(0x80 | (cp & 0x3F));
+        n = 4;
+    }
+    return append(reader, out, n);
+}
+
+// Append a character of a literal's lexical form with the canonical
+// N-Quads escapes: ECHAR where one exists, \u00XX for other controls
+static RDFStatus appendLexical(NQuadsReader *reader, uint32_t ch)
+{
+    static const char hexDigits[] = "0123456789ABCDEF";
+    char escape[6] = { '\\', 0, '0', '0', 0, 0 };
+    switch (ch) {
+    case '"': escape[1] = '"'; break;
+    case '\\': escape[1] = '\\'; break;
+    case '\n': escape[1] = 'n'; break;
+    case '\r': escape[1] = 'r'; break;
+    case '\b': escape[1] = 'b'; break;
+    case '\t': escape[1] = 't'; break;
+    case '\f': escape[1] = 'f'; break;
+    default:
+        if (ch >= 0x20 && ch != 0x7F) {
+            return appendUtf8(reader, ch);
+        }
+        escape[1] = 'u';
+        escape[4] = hexDigits[ch >> 4];
+        escape[5] = hexDigits[ch & 0x0F];
+        return append(reader, escape, 6);
+    }
+    return append(reader, escape, 2);
+}
+
+static int isLetter(unsigned char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+static int isDigit(unsigned char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+static int hexValue(unsigned char c)
+{
+    if (isDigit(c)) return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+// Characters of a blank node label after its first; bytes of non-ASCII
+// characters are taken as they come
+static int isLabelChar(unsigned char c)
+{
+    return isLetter(c) || isDigit(c) || c == '_' || c == ':' || c == '-' || c >= 0x80;
+}
+
+// Characters an IRI may hold, whether written out or escaped
+static int isIriChar(uint32_t c)
+{
+    return c > 0x20 && c != '<' && c != '>' && c != '"' && c != '{' && c != '}' && c != '|' && c != '^'
+           && c != '`' && c != '\\';
+}
+
+// An IRI in N-Quads has to be absolute: it starts with a scheme
+static int isAbsolute(const char *iri, size_t len)
+{
+    size_t i = 0;
+    while (i < len && (isLetter((unsigned char)iri[i])
+                       || (i > 0 && (isDigit((unsigned char)iri[i]) || iri[i] == '+' || iri[i] == '-'
+                                     || iri[i] == '.')))) {
+        i++;
+    }
+    return i > 0 && i < len && iri[i] == ':';
+}
+
+// Subjects are IRIs or blank nodes, predicates IRIs, objects anything and
+// graph names IRIs or blank nodes again
+static RDFStatus startTerm(NQuadsReader *reader, uint8_t state, const char *first)
+{
+    int position = reader->count;
+    if (position == 4 || (state == STATE_LITERAL && position != 2)
+        || (state == STATE_BLANK_COLON && position == 1)) {
+        return RDF_ERR_INVALID;
+    }
+    reader->state = state;
+    reader->termLength = 0;
+    return first ? append(reader, first, 1) : RDF_OK;
+}
+
+static RDFStatus endTerm(NQuadsReader *reader)
+{
+    RDFTermId id = RDFGraph_intern(reader->graph, reader->term, reader->termLength);
+    if (id == RDF_NO_TERM) {
+        return internFailure(reader->graph);
+    }
+    reader->terms[reader->count++] = id;
+    reader->state = STATE_LINE;
+    return RDF_OK;
+}
+
+static RDFStatus endIri(NQuadsReader *reader)
+{
+    size_t start = reader->datatype;
+    if (!isAbsolute(reader->term + start, reader->termLength - start)) {
+        return RDF_ERR_INVALID;
+    }
+    if (start) {
+        // "lexical"^^xsd:string is the plain "lexical"
+        reader->datatype = 0;
+        if (reader->termLength - start == sizeof(xsdString) - 1
+            && memcmp(reader->term + start, xsdString, sizeof(xsdString) - 1) == 0) {
+            reader->termLength = start - 3;
+        } else {
+            RDFStatus status = append(reader, ">", 1);
+            if (status != RDF_OK) return status;
+        }
+    }
+    return endTerm(reader);
+}
+
+static RDFStatus endStatement(NQuadsReader *reader)
+{
+    if (reader->count < 3) {
+        return RDF_ERR_INVALID;
+    }
+    RDFStatus status = RDFGraph_addQuadIds(reader->graph, reader->terms[0], reader->terms[1], reader->terms[2],
+                                           reader->count == 4 ? reader->terms[3] : RDF_NO_TERM);
+    reader->count = 0;
+    reader->state = STATE_END;
+    return status;
+}
+
+/* Bytes ---------------------------------------------------------------------*/
+
+// A byte that ends a term is read again in the state the term ended in
+static RDFStatus step(NQuadsReader *reader, unsigned char c)
+{
+    RDFStatus status;
+    switch (reader->state) {
+    case STATE_LINE:
+        switch (c) {
+        case ' ': case '\t': return RDF_OK;
+        case '\n': reader->line++; // fall through
+        case '\r': return reader->count == 0 ? RDF_OK : RDF_ERR_INVALID;
+        case '#': reader->state = STATE_COMMENT; return RDF_OK;
+        case '.': return endStatement(reader);
+        case '<': return startTerm(reader, STATE_IRI, NULL);
+        case '_': return startTerm(reader, STATE_BLANK_COLON, "_");
+        case '"': return startTerm(reader, STATE_LITERAL, "\"");
+        default: return RDF_ERR_INVALID;
+        }
+
+    case STATE_END:
+        if (c == ' ' || c == '\t') return RDF_OK;
+        if (c == '#') {
+            reader->state = STATE_COMMENT;
+            return RDF_OK;
+        }
+        if (c != '\n' && c != '\r') return RDF_ERR_INVALID;
+        reader->state = STATE_LINE;
+        return step(reader, c);
+
+    case STATE_COMMENT:
+        if (c != '\n' && c != '\r') return RDF_OK;
+        reader->state = STATE_LINE;
+        return step(reader, c);
+
+    case STATE_IRI:
+        if (c == '>') return endIri(reader);
+        if (c == '\\') {
+            reader->resume = STATE_IRI;
+            reader->state = STATE_ESCAPE;
+            return RDF_OK;
+        }
+        if (!isIriChar(c)) {
+            return RDF_ERR_INVALID;
+        }
+        return append(reader, (const char *)&c, 1);
+
+    case STATE_BLANK_COLON:
+        if (c != ':') return RDF_ERR_INVALID;
+        reader->state = STATE_BLANK_START;
+        return append(reader, ":", 1);
+
+    case STATE_BLANK_START:
+        if (!isLabelChar(c) || c == '-') return RDF_ERR_INVALID;
+        reader->state = STATE_BLANK;
+        return append(reader, (const char *)&c, 1);
+
+    case STATE_BLANK:
+        // A label may contain dots but not end with one: "_:b0." ends
+        // the statement, which only the byte after the dot tells
+        if (c == '.') {
+            reader->dots++;
+            return RDF_OK;
+        }
+        if (isLabelChar(c)) {
+            for (; reader->dots; reader->dots--) {
+                status = append(reader, ".", 1);
+                if (status != RDF_OK) return status;
+            }
+            return append(reader, (const char *)&c, 1);
+        }
+        status = endTerm(reader);
+        if (status == RDF_OK && reader->dots) {
+            status = reader->dots == 1 ? endStatement(reader) : RDF_ERR_INVALID;
+            reader->dots = 0;
+        }
+        return status != RDF_OK ? status : step(reader, c);
+
+    case STATE_LITERAL:
+        if (c == '"') {
+            reader->state = STATE_AFTER_LITERAL;
+            return append(reader, "\"", 1);
+        }
+        if (c == '\\') {
+            reader->resume = STATE_LITERAL;
+            reader->state = STATE_ESCAPE;
+            return RDF_OK;
+        }
+        if (c == '\n' || c == '\r') return RDF_ERR_INVALID;
+        return c < 0x80 ? appendLexical(reader, c) : append(reader, (const char *)&c, 1);
+
+    case STATE_AFTER_LITERAL:
+        if (c == '@') {
+            reader->state = STATE_LANG_START;
+            return append(reader, "@", 1);
+        }
+        if (c == '^') {
+            reader->state = STATE_CARET;
+            return RDF_OK;
+        }
+        status = endTerm(reader);
+        return status != RDF_OK ? status : step(reader, c);
+
+    case STATE_LANG_START:
+        if (!isLetter(c)) return RDF_ERR_INVALID;
+        reader->state = STATE_LANG;
+        return append(reader, (const char *)&c, 1);
+
+    case STATE_LANG:
+        if (isLetter(c) || isDigit(c) || c == '-') {
+            return append(reader, (const char *)&c, 1);
+        }
+        if (reader->term[reader->termLength - 1] == '-') return RDF_ERR_INVALID;
+        status = endTerm(reader);
+        return status != RDF_OK ? status : step(reader, c);
+
+    case STATE_CARET:
+        if (c != '^') return RDF_ERR_INVALID;
+        reader->state = STATE_DATATYPE;
+        return RDF_OK;
+
+    case STATE_DATATYPE:
+        if (c != '<') return RDF_ERR_INVALID;
+        status = append(reader, "^^<", 3);
+        reader->datatype = reader->termLength;
+        reader->state = STATE_IRI;
+        return status;
+
+    case STATE_ESCAPE:
+        if (c == 'u' || c == 'U') {
+            reader->digits = c == 'u' ? 4 : 8;
+            reader->codePoint = 0;
+            reader->state = STATE_HEX;
+            return RDF_OK;
+        }
+        // IRIs take \u and \U escapes only
+        if (reader->resume != STATE_LITERAL) return RDF_ERR_INVALID;
+        reader->state = STATE_LITERAL;
+        switch (c) {
+        case 't': return appendLexical(reader, '\t');
+        case 'b': return appendLexical(reader, '\b');
+        case 'n': return appendLexical(reader, '\n');
+        case 'r': return appendLexical(reader, '\r');
+        case 'f': return appendLexical(reader, '\f');
+        case '"': case '\'': case '\\': return appendLexical(reader, c);
+        default: return RDF_ERR_INVALID;
+        }
+
+    case STATE_HEX: {
+        int value = hexValue(c);
+        if (value < 0) return RDF_ERR_INVALID;
+        reader->codePoint = (reader->codePoint << 4) | (uint32_t)value;
+        if (--reader->digits) return RDF_OK;
+        uint32_t cp = reader->codePoint;
+        if (cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) return RDF_ERR_INVALID;
+        reader->state = reader->resume;
+        if (reader->resume == STATE_LITERAL) {
+            return appendLexical(reader, cp);
+        }
+        return isIriChar(cp) ? appendUtf8(reader, cp) : RDF_ERR_INVALID;
+    }
+
+    default:
+        return RDF_ERR_INVALID;
+    }
+}
+
+RDFStatus NQuadsReader_feed(NQuadsReader *reader, const char *data, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        RDFStatus status = step(reader, (unsigned char)data[i]);
+        if (status != RDF_OK) {
+            return status;
+        }
+    }
+    return RDF_OK;
+}
+
+RDFStatus NQuadsReader_finish(NQuadsReader *reader)
+{
+    // A line break ends whatever term is open and checks the statement is
+    // complete
+    return step(reader, '\n');
+}
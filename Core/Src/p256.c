@@ -0,0 +1,326 @@
+#include "p256.h"
+
+#include <string.h>
+
+// A modulus with its Montgomery constants: -m^-1 mod 2^32 and R^2 mod m
+// for R = 2^256
+typedef struct {
+    uint32_t m[8];
+    uint32_t m0;
+    uint32_t r2[8];
+} Modulus;
+
+static const Modulus fieldP = {
+    { 0xffffffff, 0xffffffff, 0xffffffff, 0x00000000, 0x00000000, 0x00000000, 0x00000001, 0xffffffff },
+    0x00000001,
+    { 0x00000003, 0x00000000, 0xffffffff, 0xfffffffb, 0xfffffffe, 0xffffffff, 0xfffffffd, 0x00000004 }
+};
+
+static const Modulus orderN = {
+    { 0xfc632551, 0xf3b9cac2, 0xa7179e84, 0xbce6faad, 0xffffffff, 0xffffffff, 0x00000000, 0xffffffff },
+    0xee00bc4f,
+    { 0xbe79eea2, 0x83244c95, 0x49bd6fa6, 0x4699799c, 0x2b6bec59, 0x2845b239, 0xf3d95620, 0x66e12d94 }
+};
+
+// The generator and 1 in Montgomery form mod p
+static const uint32_t baseX[8] = {
+    0x18a9143c, 0x79e730d4, 0x5fedb601, 0x75ba95fc, 0x77622510, 0x79fb732b, 0xa53755c6, 0x18905f76
+};
+static const uint32_t baseY[8] = {
+    0xce95560a, 0xddf25357, 0xba19e45c, 0x8b4ab8e4, 0xdd21f325, 0xd2e88688, 0x25885d85, 0x8571ff18
+};
+static const uint32_t montOne[8] = {
+    0x00000001, 0x00000000, 0x00000000, 0xffffffff, 0xffffffff, 0xffffffff, 0xfffffffe, 0x00000000
+};
+
+/* Arithmetic mod m ---------------------------------------------------------*/
+
+// r = t - m when the top word is set or t >= m, else t; t < 2m
+static void reduceOnce(uint32_t r[8], const uint32_t t[8], uint32_t top, const uint32_t m[8])
+{
+    uint32_t d[8];
+    uint64_t borrow = 0;
+    for (int i = 0; i < 8; i++) {
+        uint64_t x = (uint64_t)t[i] - m[i] - borrow;
+        d[i] = (uint32_t)x;
+        borrow = (x >> 32) & 1;
+    }
+    uint32_t useD = 0u - ((top | (uint32_t)(borrow ^ 1)) & 1);
+    for (int i = 0; i < 8; i++) {
+        r[i] = (d[i] & useD) | (t[i] & ~useD);
+    }
+}
+
+static void modAdd(uint32_t r[8], const uint32_t a[8], const uint32_t b[8], const uint32_t m[8])
+{
+    uint32_t s[8];
+    uint64_t carry = 0;
+    for (int i = 0; i < 8; i++) {
+        carry += (uint64_t)a[i] + b[i];
+        s[i] = (uint32_t)carry;
+        carry >>= 32;
+    }
+    reduceOnce(r, s, (uint32_t)carry, m);
+}
+
+static void modSub(uint32_t r[8], const uint32_t a[8], const uint32_t b[8], const uint32_t m[8])
+{
+    uint64_t borrow = 0;
+    for (int i = 0; i < 8; i++) {
+        uint64_t x = (uint64_t)a[i] - b[i] - borrow;
+        r[i] = (uint32_t)x;
+        borrow = (x >> 32) & 1;
+    }
+    uint32_t mask = 0u - (uint32_t)borrow;
+    uint64_t carry = 0;
+    for (int i = 0; i < 8; i++) {
+        carry += (uint64_t)r[i] + (m[i] & mask);
+        r[i] = (uint32_t)carry;
+        carry >>= 32;
+    }
+}
+
+// r = a·b/R mod m, word by word (CIOS); r may alias a or b
+static void montMul(uint32_t r[8], const uint32_t a[8], const uint32_t b[8], const Modulus *mod)
+{
+    uint32_t t[10] = { 0 };
+    for (int i = 0; i < 8; i++) {
+        uint64_t c = 0;
+        for (int j = 0; j < 8; j++) {
+            c += (uint64_t)a[j] * b[i] + t[j];
+            t[j] = (uint32_t)c;
+            c >>= 32;
+        }
+        c += t[8];
+        t[8] = (uint32_t)c;
+        t[9] = (uint32_t)(c >> 32);
+
+        uint32_t q = t[0] * mod->m0;
+        c = ((uint64_t)q * mod->m[0] + t[0]) >> 32;
+        for (int j = 1; j < 8; j++) {
+            c += (uint64_t)q * mod->m[j] + t[j];
+            t[j - 1] = (uint32_t)c;
+            c >>= 32;
+        }
+        c += t[8];
+        t[7] = (uint32_t)c;
+        t[8] = t[9] + (uint32_t)(c >> 32);
+    }
+    reduceOnce(r, t, t[8], mod->m);
+}
+
+// r = a^(m-2), the inverse of a nonzero a, both in Montgomery form. The
+// exponent is public, so branching on its bits leaks nothing.
+static void montInvert(uint32_t r[8], const uint32_t a[8], const Modulus *mod)
+{
+    uint32_t e[8], acc[8];
+    uint64_t borrow = 2;
+    for (int i = 0; i < 8; i++) {
+        uint64_t x = (uint64_t)mod->m[i] - borrow;
+        e[i] = (uint32_t)x;
+        borrow = (x >> 32) & 1;
+    }
+    memcpy(acc, a, sizeof(acc));
+    int top = 255;
+    while (!((e[top / 32] >> (top % 32)) & 1)) top--;
+    for (int i = top - 1; i >= 0; i--) {
+        montMul(acc, acc, acc, mod);
+        if ((e[i / 32] >> (i % 32)) & 1) {
+            montMul(acc, acc, a, mod);
+        }
+    }
+    memcpy(r, acc, sizeof(acc));
+}
+
+/* Integers ----------------------------------------------------------------*/
+
+void P256Int_fromBytes(P256Int *a, const uint8_t bytes[P256_BYTES])
+{
+    for (int i = 0; i < 8; i++) {
+        const uint8_t *b = bytes + 4 * (7 - i);
+        a->limb[i] = (uint32_t)b[0] << 24 | (uint32_t)b[1] << 16 | (uint32_t)b[2] << 8 | b[3];
+    }
+}
+
+void P256Int_toBytes(uint8_t bytes[P256_BYTES], const P256Int *a)
+{
+    for (int i = 0; i < 8; i++) {
+        uint8_t *b = bytes + 4 * (7 - i);
+        b[0] = (uint8_t)(a->limb[i] >> 24);
+        b[1] = (uint8_t)(a->limb[i] >> 16);
+        b[2] = (uint8_t)(a->limb[i] >> 8);
+        b[3] = (uint8_t)a->limb[i];
+    }
+}
+
+int P256Int_isZero(const P256Int *a)
+{
+    uint32_t bits = 0;
+    for (int i = 0; i < 8; i++) bits |= a->limb[i];
+    return bits == 0;
+}
+
+/* Scalars mod n -----------------------------------------------------------*/
+
+int P256_scalarIsValid(const P256Int *k)
+{
+    uint64_t borrow = 0;
+    for (int i = 0; i < 8; i++) {
+        uint64_t x = (uint64_t)k->limb[i] - orderN.m[i] - borrow;
+        borrow = (x >> 32) & 1;
+    }
+    return borrow && !P256Int_isZero(k);
+}
+
+// 2^256 < 2n, so one subtraction reduces any 256-bit value
+void P256_scalarReduce(P256Int *a)
+{
+    reduceOnce(a->limb, a->limb, 0, orderN.m);
+}
+
+void P256_scalarAdd(P256Int *r, const P256Int *a, const P256Int *b)
+{
+    modAdd(r->limb, a->limb, b->limb, orderN.m);
+}
+
+// a·b/R·R^2/R = a·b
+void P256_scalarMul(P256Int *r, const P256Int *a, const P256Int *b)
+{
+    montMul(r->limb, a->limb, b->limb, &orderN);
+    montMul(r->limb, r->limb, orderN.r2, &orderN);
+}
+
+void P256_scalarInvert(P256Int *r, const P256Int *a)
+{
+    static const uint32_t one[8] = { 1 };
+    uint32_t t[8];
+    montMul(t, a->limb, orderN.r2, &orderN);
+    montInvert(t, t, &orderN);
+    montMul(r->limb, t, one, &orderN);
+}
+
+/* Points ------------------------------------------------------------------*/
+
+// Jacobian coordinates (X/Z^2, Y/Z^3), Montgomery form mod p; Z = 0 is
+// the point at infinity
+typedef struct {
+    uint32_t x[8], y[8], z[8];
+} Point;
+
+// dbl-2001-b for a = -3; doubling infinity gives infinity
+static void pointDouble(Point *r, const Point *p)
+{
+    const uint32_t *m = fieldP.m;
+    uint32_t delta[8], gamma[8], beta[8], alpha[8], t[8], u[8];
+
+    montMul(delta, p->z, p->z, &fieldP);
+    montMul(gamma, p->y, p->y, &fieldP);
+    montMul(beta, p->x, gamma, &fieldP);
+    modSub(t, p->x, delta, m);
+    modAdd(u, p->x, delta, m);
+    montMul(alpha, t, u, &fieldP);
+    modAdd(t, alpha, alpha, m);
+    modAdd(alpha, alpha, t, m);
+
+    modAdd(r->z, p->y, p->z, m);
+    montMul(r->z, r->z, r->z, &fieldP);
+    modSub(r->z, r->z, gamma, m);
+    modSub(r->z, r->z, delta, m);
+
+    modAdd(beta, beta, beta, m);
+    modAdd(beta, beta, beta, m);            // 4·beta
+    montMul(r->x, alpha, alpha, &fieldP);
+    modAdd(t, beta, beta, m);
+    modSub(r->x, r->x, t, m);
+
+    montMul(gamma, gamma, gamma, &fieldP);
+    modAdd(gamma, gamma, gamma, m);
+    modAdd(gamma, gamma, gamma, m);
+    modAdd(gamma, gamma, gamma, m);         // 8·gamma^2
+    modSub(t, beta, r->x, m);
+    montMul(r->y, alpha, t, &fieldP);
+    modSub(r->y, r->y, gamma, m);
+}
+
+// madd-2007-bl: p plus the affine generator. Wrong when p is infinity,
+// G or -G; the ladder below selects around the first and never meets
+// the others for a valid scalar.
+static void pointAddBase(Point *r, const Point *p)
+{
+    const uint32_t *m = fieldP.m;
+    uint32_t z1z1[8], h[8], hh[8], i4[8], j[8], rr[8], v[8], t[8];
+
+    montMul(z1z1, p->z, p->z, &fieldP);
+    montMul(h, baseX, z1z1, &fieldP);
+    modSub(h, h, p->x, m);                  // U2 - X1
+    montMul(t, baseY, p->z, &fieldP);
+    montMul(t, t, z1z1, &fieldP);           // S2
+    modSub(rr, t, p->y, m);
+    modAdd(rr, rr, rr, m);
+    montMul(hh, h, h, &fieldP);
+    modAdd(i4, hh, hh, m);
+    modAdd(i4, i4, i4, m);
+    montMul(j, h, i4, &fieldP);
+    montMul(v, p->x, i4, &fieldP);
+
+    Point out;
+    montMul(out.x, rr, rr, &fieldP);
+    modSub(out.x, out.x, j, m);
+    modSub(out.x, out.x, v, m);
+    modSub(out.x, out.x, v, m);
+
+    modSub(t, v, out.x, m);
+    montMul(out.y, rr, t, &fieldP);
+    montMul(t, p->y, j, &fieldP);
+    modAdd(t, t, t, m);
+    modSub(out.y, out.y, t, m);
+
+    modAdd(out.z, p->z, h, m);
+    montMul(out.z, out.z, out.z, &fieldP);
+    modSub(out.z, out.z, z1z1, m);
+    modSub(out.z, out.z, hh, m);
+    *r = out;
+}
+
+// r = a where mask is all ones, unchanged where it is zero
+static void conditionalCopy(uint32_t r[8], const uint32_t a[8], uint32_t mask)
+{
+    for (int i = 0; i < 8; i++) {
+        r[i] = (a[i] & mask) | (r[i] & ~mask);
+    }
+}
+
+void P256_baseMultiplyX(P256Int *x, const P256Int *k)
+{
+    static const uint32_t one[8] = { 1 };
+    Point acc, sum;
+    memset(&acc, 0, sizeof(acc));
+    memcpy(acc.x, montOne, sizeof(acc.x));
+    memcpy(acc.y, montOne, sizeof(acc.y));
+
+    // Double and always add, keeping the sum by mask
+    for (int i = 255; i >= 0; i--) {
+        pointDouble(&acc, &acc);
+        pointAddBase(&sum, &acc);
+
+        uint32_t z = 0;
+        for (int w = 0; w < 8; w++) z |= acc.z[w];
+        uint32_t infinity = ((z | (0u - z)) >> 31) - 1;
+        conditionalCopy(sum.x, baseX, infinity);
+        conditionalCopy(sum.y, baseY, infinity);
+        conditionalCopy(sum.z, montOne, infinity);
+
+        uint32_t bit = 0u - ((k->limb[i / 32] >> (i % 32)) & 1);
+        conditionalCopy(acc.x, sum.x, bit);
+        conditionalCopy(acc.y, sum.y, bit);
+        conditionalCopy(acc.z, sum.z, bit);
+    }
+
+    // Affine x = X/Z^2, out of Montgomery form, then mod n
+    uint32_t zInverse[8];
+    montInvert(zInverse, acc.z, &fieldP);
+    montMul(zInverse, zInverse, zInverse, &fieldP);
+    montMul(x->limb, acc.x, zInverse, &fieldP);
+    montMul(x->limb, x->limb, one, &fieldP);
+    P256_scalarReduce(x);
+}
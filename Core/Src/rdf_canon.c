@@ -0,0 +1,1002 @@
+#include "rdf_canon.h"
+#include "sha256.h"
+
+#include <string.h>
+
+// Implements https://www.w3.org/TR/rdf-canon/ on top of RDFGraph. Quads are
+// never serialized into strings: term text is compared in place and fed
+// straight into SHA-256 contexts. All working memory is carved out of the
+// caller's scratch arena.
+
+#define NO_BLANK 0xFFFFu
+#define HASH_HEX_SIZE (2 * SHA256_DIGEST_SIZE)
+
+// Path bytes one related blank node can contribute: an "_:c14n" or "_:b"
+// label of up to five digits, plus label and "<hash>" if it is recursed on
+#define PATH_ENTRY_MAX (2 * 11 + 2 + HASH_HEX_SIZE)
+
+// Blank node identifier issuer ("_:c14n" or "_:b" prefixed)
+typedef struct {
+    uint16_t *label;          // blank index -> issued number, NO_BLANK if none
+    uint16_t *order;          // blank indexes in issue order
+    int count;
+} Issuer;
+
+typedef struct {
+    const RDFGraph *graph;
+    RDFArena *scratch;
+    const RDFCanonOptions *options;
+    size_t peak;
+    uint32_t nDegreeCalls;
+
+    const RDFTriple *quads;   // input quads, duplicates removed
+    int quadCount;
+
+    uint16_t *blankOf;        // term id -> blank index, NO_BLANK otherwise
+    int blankCount;
+    uint32_t *mentionStart;   // quads of blank b: mentions[mentionStart[b] .. mentionStart[b + 1])
+    uint32_t *mentions;
+    uint8_t (*firstHash)[SHA256_DIGEST_SIZE];
+
+    Issuer canonical;
+} Canon;
+
+// Serialized form of one term as up to four byte runs: "<", the prefix
+// and the suffix of an IRI, ">"
+#define TERM_PARTS 4
+
+typedef struct {
+    const char *part[TERM_PARTS];
+    size_t len[TERM_PARTS];
+    char label[16];
+} TermText;
+
+// How blank nodes are written: as the canonical label for ids at or above
+// labelBase, as _:a / _:z relative to reference during first degree
+// hashing, or verbatim otherwise
+typedef struct {
+    const RDFGraph *graph;
+    RDFTermId labelBase;
+    const uint16_t *blankOf;
+    int reference;
+} TermView;
+
+static void *canonAlloc(Canon *c, size_t size, size_t align)
+{
+    void *p = RDFArena_alloc(c->scratch, size, align);
+    if (c->scratch->used > c->peak) c->peak = c->scratch->used;
+    return p;
+}
+
+static size_t formatNumber(char *out, unsigned value)
+{
+    char digits[10];
+    size_t n = 0;
+    do {
+        digits[n++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value);
+    for (size_t i = 0; i < n; i++) out[i] = digits[n - 1 - i];
+    return n;
+}
+
+static size_t formatLabel(char *out, const char *prefix, unsigned number)
+{
+    size_t n = strlen(prefix);
+    memcpy(out, prefix, n);
+    return n + formatNumber(out + n, number);
+}
+
+static void describeTerm(const TermView *view, RDFTermId id, TermText *t)
+{
+    t->len[0] = t->len[1] = t->len[3] = 0;
+    t->part[0] = t->part[1] = t->part[3] = "";
+
+    if (id >= view->labelBase) {
+        t->part[2] = t->label;
+        t->len[2] = formatLabel(t->label, "_:c14n", (unsigned)(id - view->labelBase));
+        return;
+    }
+
+    const RDFGraph *graph = view->graph;
+    switch (RDFGraph_termKind(graph, id)) {
+    case RDF_TERM_IRI:
+        t->part[0] = "<";
+        t->len[0] = 1;
+        t->part[1] = RDFGraph_termPrefix(graph, id);
+        t->len[1] = RDFGraph_termPrefixLength(graph, id);
+        t->part[2] = RDFGraph_termSuffix(graph, id);
+        t->len[2] = RDFGraph_termSuffixLength(graph, id);
+        t->part[3] = ">";
+        t->len[3] = 1;
+        break;
+    case RDF_TERM_BLANK:
+        if (view->reference >= 0) {
+            t->part[2] = (int)view->blankOf[id] == view->reference ? "_:a" : "_:z";
+            t->len[2] = 3;
+            break;
+        }
+        /* fall through */
+    case RDF_TERM_LITERAL:
+    case RDF_TERM_TYPED_LITERAL:
+    case RDF_TERM_LANG_LITERAL:
+        t->part[2] = RDFGraph_termSuffix(graph, id);
+        t->len[2] = RDFGraph_termSuffixLength(graph, id);
+        break;
+    }
+}
+
+// Code point order of two serialized terms (UTF-8 byte order is the same)
+static int compareText(const TermText *a, const TermText *b)
+{
+    int ia = 0, ib = 0;
+    size_t oa = 0, ob = 0;
+    for (;;) {
+        while (ia < TERM_PARTS && oa == a->len[ia]) { ia++; oa = 0; }
+        while (ib < TERM_PARTS && ob == b->len[ib]) { ib++; ob = 0; }
+        if (ia == TERM_PARTS || ib == TERM_PARTS) return (ia != TERM_PARTS) - (ib != TERM_PARTS);
+
+        size_t n = a->len[ia] - oa < b->len[ib] - ob ? a->len[ia] - oa : b->len[ib] - ob;
+        int cmp = memcmp(a->part[ia] + oa, b->part[ib] + ob, n);
+        if (cmp != 0) return cmp;
+        oa += n;
+        ob += n;
+    }
+}
+
+static int compareViewTerms(const TermView *view, RDFTermId a, RDFTermId b)
+{
+    TermText ta, tb;
+    describeTerm(view, a, &ta);
+    describeTerm(view, b, &tb);
+    return compareText(&ta, &tb);
+}
+
+// N-Quads lines compare like their (s, p, o, g) terms taken in turn: terms
+// never contain a raw space or control character, and a missing graph name
+// (" ." follows the object) sorts before any named graph
+static int compareQuadLines(const TermView *view, const RDFTriple *a, const RDFTriple *b)
+{
+    int cmp = compareViewTerms(view, a->subject, b->subject);
+    if (cmp == 0) cmp = compareViewTerms(view, a->predicate, b->predicate);
+    if (cmp == 0) cmp = compareViewTerms(view, a->object, b->object);
+    if (cmp == 0 && a->graph != b->graph) {
+        if (a->graph == RDF_NO_TERM) return -1;
+        if (b->graph == RDF_NO_TERM) return 1;
+        cmp = compareViewTerms(view, a->graph, b->graph);
+    }
+    return cmp;
+}
+
+static void writeTerm(const TermView *view, RDFTermId id, RDFSinkFn write, void *ctx)
+{
+    TermText t;
+    describeTerm(view, id, &t);
+    for (int i = 0; i < TERM_PARTS; i++) {
+        if (t.len[i]) write(ctx, t.part[i], t.len[i]);
+    }
+}
+
+static void writeQuad(const TermView *view, const RDFTriple *q, RDFSinkFn write, void *ctx)
+{
+    writeTerm(view, q->subject, write, ctx);
+    write(ctx, " ", 1);
+    writeTerm(view, q->predicate, write, ctx);
+    write(ctx, " ", 1);
+    writeTerm(view, q->object, write, ctx);
+    if (q->graph != RDF_NO_TERM) {
+        write(ctx, " ", 1);
+        writeTerm(view, q->graph, write, ctx);
+    }
+    write(ctx, " .\n", 3);
+}
+
+static void hashWrite(void *ctx, const char *data, size_t len)
+{
+    SHA256_update((SHA256Context *)ctx, data, len);
+}
+
+static void toHex(char out[HASH_HEX_SIZE], const uint8_t hash[SHA256_DIGEST_SIZE])
+{
+    static const char hexDigits[] = "0123456789abcdef";
+    for (int i = 0; i < SHA256_DIGEST_SIZE; i++) {
+        out[2 * i] = hexDigits[hash[i] >> 4];
+        out[2 * i + 1] = hexDigits[hash[i] & 0x0F];
+    }
+}
+
+/* Sorting helpers -----------------------------------------------------------*/
+
+typedef int (*IndexCompare)(const void *ctx, uint32_t a, uint32_t b);
+
+// Stable bottom-up merge sort of an index array
+static void sortIndexes(uint32_t *idx, uint32_t *tmp, int count, IndexCompare compare, const void *ctx)
+{
+    for (int width = 1; width < count; width *= 2) {
+        for (int lo = 0; lo < count; lo += 2 * width) {
+            int mid = lo + width < count ? lo + width : count;
+            int hi = lo + 2 * width < count ? lo + 2 * width : count;
+            int i = lo, j = mid, k = lo;
+            while (i < mid && j < hi) {
+                tmp[k++] = compare(ctx, idx[j], idx[i]) < 0 ? idx[j++] : idx[i++];
+            }
+            while (i < mid) tmp[k++] = idx[i++];
+            while (j < hi) tmp[k++] = idx[j++];
+        }
+        memcpy(idx, tmp, (size_t)count * sizeof(uint32_t));
+    }
+}
+
+// Next lexicographic permutation; returns 0 after the last one. Repeated
+// entries are only permuted once.
+static int nextPermutation(uint16_t *p, int n)
+{
+    int i = n - 2;
+    while (i >= 0 && p[i] >= p[i + 1]) i--;
+    if (i < 0) return 0;
+    int j = n - 1;
+    while (p[j] <= p[i]) j--;
+    uint16_t t = p[i]; p[i] = p[j]; p[j] = t;
+    for (int a = i + 1, b = n - 1; a < b; a++, b--) {
+        t = p[a]; p[a] = p[b]; p[b] = t;
+    }
+    return 1;
+}
+
+static int compareIds(const void *ctx, RDFTermId a, RDFTermId b)
+{
+    (void)ctx;
+    return (a > b) - (a < b);
+}
+
+/* Identifier issuers --------------------------------------------------------*/
+
+static int issuerAlloc(Canon *c, Issuer *issuer)
+{
+    size_t n = (size_t)c->blankCount;
+    issuer->label = (uint16_t *)canonAlloc(c, n * sizeof(uint16_t), sizeof(uint16_t));
+    issuer->order = (uint16_t *)canonAlloc(c, n * sizeof(uint16_t), sizeof(uint16_t));
+    issuer->count = 0;
+    if (!issuer->label || !issuer->order) return 0;
+    memset(issuer->label, 0xFF, n * sizeof(uint16_t));
+    return 1;
+}
+
+static void issuerCopy(const Canon *c, Issuer *dst, const Issuer *src)
+{
+    memcpy(dst->label, src->label, (size_t)c->blankCount * sizeof(uint16_t));
+    memcpy(dst->order, src->order, (size_t)src->count * sizeof(uint16_t));
+    dst->count = src->count;
+}
+
+static uint16_t issue(Issuer *issuer, int blank)
+{
+    if (issuer->label[blank] == NO_BLANK) {
+        issuer->order[issuer->count] = (uint16_t)blank;
+        issuer->label[blank] = (uint16_t)issuer->count++;
+    }
+    return issuer->label[blank];
+}
+
+/* Hash First Degree Quads ---------------------------------------------------*/
+
+typedef struct {
+    const Canon *c;
+    TermView view;
+} QuadOrder;
+
+static int compareMentionedQuads(const void *ctx, uint32_t a, uint32_t b)
+{
+    const QuadOrder *order = (const QuadOrder *)ctx;
+    return compareQuadLines(&order->view, &order->c->quads[a], &order->c->quads[b]);
+}
+
+static RDFStatus hashFirstDegree(Canon *c, int blank)
+{
+    uint32_t start = c->mentionStart[blank];
+    int count = (int)(c->mentionStart[blank + 1] - start);
+    size_t mark = c->scratch->used;
+
+    uint32_t *idx = (uint32_t *)canonAlloc(c, (size_t)count * sizeof(uint32_t), sizeof(uint32_t));
+    uint32_t *tmp = (uint32_t *)canonAlloc(c, (size_t)count * sizeof(uint32_t), sizeof(uint32_t));
+    if (!idx || !tmp) return RDF_ERR_ARENA_FULL;
+    memcpy(idx, c->mentions + start, (size_t)count * sizeof(uint32_t));
+
+    QuadOrder order = { c, { c->graph, RDF_NO_TERM, c->blankOf, blank } };
+    sortIndexes(idx, tmp, count, compareMentionedQuads, &order);
+
+    SHA256Context md;
+    SHA256_init(&md);
+    for (int i = 0; i < count; i++) {
+        writeQuad(&order.view, &c->quads[idx[i]], hashWrite, &md);
+    }
+    SHA256_final(&md, c->firstHash[blank]);
+
+    RDFArena_release(c->scratch, mark);
+    return RDF_OK;
+}
+
+/* Hash Related Blank Node / Hash N-Degree Quads -----------------------------*/
+
+typedef struct {
+    uint8_t hash[SHA256_DIGEST_SIZE];
+    uint16_t blank;
+} Related;
+
+static int compareRelated(const void *ctx, uint32_t a, uint32_t b)
+{
+    const Related *related = (const Related *)ctx;
+    int cmp = memcmp(related[a].hash, related[b].hash, SHA256_DIGEST_SIZE);
+    if (cmp != 0) return cmp;
+    return (related[a].blank > related[b].blank) - (related[a].blank < related[b].blank);
+}
+
+// Identifier of a related blank node: its canonical label, else the one
+// issuer gave it, else its first degree hash
+static size_t relatedIdentifier(const Canon *c, int blank, const Issuer *issuer, char *out)
+{
+    if (c->canonical.label[blank] != NO_BLANK) {
+        return formatLabel(out, "_:c14n", c->canonical.label[blank]);
+    }
+    if (issuer->label[blank] != NO_BLANK) {
+        return formatLabel(out, "_:b", issuer->label[blank]);
+    }
+    toHex(out, c->firstHash[blank]);
+    return HASH_HEX_SIZE;
+}
+
+static void hashRelated(const Canon *c, int related, const RDFTriple *q, const Issuer *issuer,
+                        char position, uint8_t out[SHA256_DIGEST_SIZE])
+{
+    char identifier[HASH_HEX_SIZE];
+    SHA256Context md;
+
+    SHA256_init(&md);
+    SHA256_update(&md, &position, 1);
+    if (position != 'g') {
+        SHA256_update(&md, "<", 1);
+        SHA256_update(&md, RDFGraph_termPrefix(c->graph, q->predicate), RDFGraph_termPrefixLength(c->graph, q->predicate));
+        SHA256_update(&md, RDFGraph_termSuffix(c->graph, q->predicate), RDFGraph_termSuffixLength(c->graph, q->predicate));
+        SHA256_update(&md, ">", 1);
+    }
+    SHA256_update(&md, identifier, relatedIdentifier(c, related, issuer, identifier));
+    SHA256_final(&md, out);
+}
+
+static int blankIndex(const Canon *c, RDFTermId id)
+{
+    return id == RDF_NO_TERM ? (int)NO_BLANK : c->blankOf[id];
+}
+
+static int isRelated(const Canon *c, RDFTermId id, int node)
+{
+    int blank = blankIndex(c, id);
+    return blank != (int)NO_BLANK && blank != node;
+}
+
+static int comparePath(const char *path, size_t len, const char *chosen, size_t chosenLen)
+{
+    int cmp = memcmp(path, chosen, len < chosenLen ? len : chosenLen);
+    if (cmp != 0) return cmp;
+    return (len > chosenLen) - (len < chosenLen);
+}
+
+// Hash N-Degree Quads. On return *issuer has been replaced by the issuer
+// of the chosen path, which is what the specification hands back.
+static RDFStatus hashNDegree(Canon *c, int node, Issuer *issuer, uint8_t result[SHA256_DIGEST_SIZE])
+{
+    c->nDegreeCalls++;
+    if (c->options && c->options->maxNDegreeCalls && c->nDegreeCalls > c->options->maxNDegreeCalls) {
+        return RDF_ERR_LIMIT;
+    }
+
+    RDFStatus status = RDF_ERR_ARENA_FULL;
+    size_t mark = c->scratch->used;
+    uint32_t start = c->mentionStart[node];
+    int quadCount = (int)(c->mentionStart[node + 1] - start);
+
+    // Hash every blank node related to node through one of its quads
+    int relatedCount = 0;
+    for (int i = 0; i < quadCount; i++) {
+        const RDFTriple *q = &c->quads[c->mentions[start + i]];
+        relatedCount += isRelated(c, q->subject, node) + isRelated(c, q->object, node) + isRelated(c, q->graph, node);
+    }
+    Related *related = (Related *)canonAlloc(c, (size_t)relatedCount * sizeof(Related) + 1, sizeof(uint16_t));
+    uint32_t *idx = (uint32_t *)canonAlloc(c, (size_t)relatedCount * sizeof(uint32_t) + 1, sizeof(uint32_t));
+    size_t sortMark = c->scratch->used;
+    uint32_t *tmp = (uint32_t *)canonAlloc(c, (size_t)relatedCount * sizeof(uint32_t) + 1, sizeof(uint32_t));
+    if (!related || !idx || !tmp) goto done;
+
+    relatedCount = 0;
+    for (int i = 0; i < quadCount; i++) {
+        const RDFTriple *q = &c->quads[c->mentions[start + i]];
+        const RDFTermId components[3] = { q->subject, q->object, q->graph };
+        static const char positions[3] = { 's', 'o', 'g' };
+        for (int k = 0; k < 3; k++) {
+            if (!isRelated(c, components[k], node)) continue;
+            int blank = blankIndex(c, components[k]);
+            hashRelated(c, blank, q, issuer, positions[k], related[relatedCount].hash);
+            related[relatedCount].blank = (uint16_t)blank;
+            idx[relatedCount] = (uint32_t)relatedCount;
+            relatedCount++;
+        }
+    }
+    sortIndexes(idx, tmp, relatedCount, compareRelated, related);
+    RDFArena_release(c->scratch, sortMark);
+
+    Issuer copy, chosenIssuer;
+    if (!issuerAlloc(c, &copy) || !issuerAlloc(c, &chosenIssuer)) goto done;
+
+    SHA256Context md;
+    SHA256_init(&md);
+
+    for (int groupStart = 0; groupStart < relatedCount; ) {
+        int groupEnd = groupStart + 1;
+        while (groupEnd < relatedCount
+               && memcmp(related[idx[groupEnd]].hash, related[idx[groupStart]].hash, SHA256_DIGEST_SIZE) == 0) {
+            groupEnd++;
+        }
+        int k = groupEnd - groupStart;
+        size_t groupMark = c->scratch->used;
+
+        char hex[HASH_HEX_SIZE];
+        toHex(hex, related[idx[groupStart]].hash);
+        SHA256_update(&md, hex, HASH_HEX_SIZE);
+
+        uint16_t *perm = (uint16_t *)canonAlloc(c, (size_t)k * sizeof(uint16_t), sizeof(uint16_t));
+        uint16_t *recursion = (uint16_t *)canonAlloc(c, (size_t)k * sizeof(uint16_t), sizeof(uint16_t));
+        char *path = (char *)canonAlloc(c, (size_t)k * PATH_ENTRY_MAX, 1);
+        char *chosenPath = (char *)canonAlloc(c, (size_t)k * PATH_ENTRY_MAX, 1);
+        if (!perm || !recursion || !path || !chosenPath) goto done;
+        for (int i = 0; i < k; i++) perm[i] = related[idx[groupStart + i]].blank;
+
+        size_t chosenLen = 0;
+        int haveChosen = 0;
+        do {
+            issuerCopy(c, &copy, issuer);
+            size_t pathLen = 0;
+            int recursionCount = 0;
+            int skip = 0;
+
+            for (int i = 0; i < k && !skip; i++) {
+                int blank = perm[i];
+                if (c->canonical.label[blank] != NO_BLANK) {
+                    pathLen += formatLabel(path + pathLen, "_:c14n", c->canonical.label[blank]);
+                } else {
+                    if (copy.label[blank] == NO_BLANK) recursion[recursionCount++] = (uint16_t)blank;
+                    pathLen += formatLabel(path + pathLen, "_:b", issue(&copy, blank));
+                }
+                skip = haveChosen && comparePath(path, pathLen, chosenPath, chosenLen) > 0;
+            }
+
+            for (int i = 0; i < recursionCount && !skip; i++) {
+                uint8_t hash[SHA256_DIGEST_SIZE];
+                status = hashNDegree(c, recursion[i], &copy, hash);
+                if (status != RDF_OK) goto done;
+                status = RDF_ERR_ARENA_FULL;
+                pathLen += formatLabel(path + pathLen, "_:b", issue(&copy, recursion[i]));
+                path[pathLen++] = '<';
+                toHex(path + pathLen, hash);
+                pathLen += HASH_HEX_SIZE;
+                path[pathLen++] = '>';
+                skip = haveChosen && comparePath(path, pathLen, chosenPath, chosenLen) > 0;
+            }
+
+            if (!skip && (!haveChosen || comparePath(path, pathLen, chosenPath, chosenLen) < 0)) {
+                memcpy(chosenPath, path, pathLen);
+                chosenLen = pathLen;
+                issuerCopy(c, &chosenIssuer, &copy);
+                haveChosen = 1;
+            }
+        } while (nextPermutation(perm, k));
+
+        SHA256_update(&md, chosenPath, chosenLen);
+        issuerCopy(c, issuer, &chosenIssuer);
+        RDFArena_release(c->scratch, groupMark);
+        groupStart = groupEnd;
+    }
+
+    SHA256_final(&md, result);
+    status = RDF_OK;
+
+done:
+    RDFArena_release(c->scratch, mark);
+    return status;
+}
+
+/* Canonicalization algorithm ------------------------------------------------*/
+
+static int compareFirstHash(const void *ctx, uint32_t a, uint32_t b)
+{
+    const Canon *c = (const Canon *)ctx;
+    return memcmp(c->firstHash[a], c->firstHash[b], SHA256_DIGEST_SIZE);
+}
+
+// Result of Hash N-Degree Quads; only the issue order of the returned
+// issuer is kept, so a large group costs O(issued) rather than O(blank nodes)
+typedef struct {
+    uint8_t hash[SHA256_DIGEST_SIZE];
+    uint16_t *order;
+    int count;
+} HashPath;
+
+static int compareHashPaths(const void *ctx, uint32_t a, uint32_t b)
+{
+    const HashPath *paths = (const HashPath *)ctx;
+    return memcmp(paths[a].hash, paths[b].hash, SHA256_DIGEST_SIZE);
+}
+
+static int compareCanonicalTerms(const void *ctx, RDFTermId a, RDFTermId b)
+{
+    return compareViewTerms((const TermView *)ctx, a, b);
+}
+
+static uint32_t now(const Canon *c)
+{
+    return c->options && c->options->clock ? c->options->clock() : 0;
+}
+
+// Group blank nodes by term id and index the quads each one occurs in
+static RDFStatus mapBlankNodes(Canon *c)
+{
+    const RDFGraph *graph = c->graph;
+    int termCount = graph->termCount;
+
+    c->blankOf = (uint16_t *)canonAlloc(c, (size_t)termCount * sizeof(uint16_t), sizeof(uint16_t));
+    if (!c->blankOf) return RDF_ERR_ARENA_FULL;
+    memset(c->blankOf, 0xFF, (size_t)termCount * sizeof(uint16_t));
+
+    c->blankCount = 0;
+    for (int i = 0; i < c->quadCount; i++) {
+        const RDFTermId components[3] = { c->quads[i].subject, c->quads[i].object, c->quads[i].graph };
+        for (int k = 0; k < 3; k++) {
+            RDFTermId id = components[k];
+            if (id == RDF_NO_TERM || c->blankOf[id] != NO_BLANK) continue;
+            if (RDFGraph_termKind(graph, id) != RDF_TERM_BLANK) continue;
+            if (c->blankCount >= (int)NO_BLANK) return RDF_ERR_TERMS_FULL;
+            c->blankOf[id] = (uint16_t)c->blankCount++;
+        }
+    }
+
+    c->mentionStart = (uint32_t *)canonAlloc(c, (size_t)(c->blankCount + 1) * sizeof(uint32_t), sizeof(uint32_t));
+    if (!c->mentionStart) return RDF_ERR_ARENA_FULL;
+    memset(c->mentionStart, 0, (size_t)(c->blankCount + 1) * sizeof(uint32_t));
+
+    // Two passes: count mentions per blank node, then fill the index. A
+    // quad naming the same blank node twice is listed once.
+    for (int pass = 0; pass < 2; pass++) {
+        for (int i = 0; i < c->quadCount; i++) {
+            const RDFTriple *q = &c->quads[i];
+            int s = blankIndex(c, q->subject);
+            int o = blankIndex(c, q->object);
+            int g = blankIndex(c, q->graph);
+            const int blanks[3] = { s, o != s ? o : (int)NO_BLANK, g != s && g != o ? g : (int)NO_BLANK };
+            for (int k = 0; k < 3; k++) {
+                if (blanks[k] == (int)NO_BLANK) continue;
+                if (pass == 0) c->mentionStart[blanks[k] + 1]++;
+                else c->mentions[c->mentionStart[blanks[k]]++] = (uint32_t)i;
+            }
+        }
+        if (pass == 0) {
+            for (int b = 0; b < c->blankCount; b++) c->mentionStart[b + 1] += c->mentionStart[b];
+            c->mentions = (uint32_t *)canonAlloc(c, (size_t)c->mentionStart[c->blankCount] * sizeof(uint32_t) + 1, sizeof(uint32_t));
+            if (!c->mentions) return RDF_ERR_ARENA_FULL;
+        } else {
+            // The fill pass advanced every start to the next blank's start
+            for (int b = c->blankCount; b > 0; b--) c->mentionStart[b] = c->mentionStart[b - 1];
+            c->mentionStart[0] = 0;
+        }
+    }
+    return RDF_OK;
+}
+
+// Issue canonical labels for blank nodes sharing a first degree hash,
+// ordered by their N-degree hashes
+static RDFStatus labelSharedHash(Canon *c, const uint32_t *members, int count)
+{
+    size_t mark = c->scratch->used;
+    RDFStatus status = RDF_ERR_ARENA_FULL;
+
+    HashPath *paths = (HashPath *)canonAlloc(c, (size_t)count * sizeof(HashPath), sizeof(void *));
+    uint32_t *idx = (uint32_t *)canonAlloc(c, (size_t)count * sizeof(uint32_t), sizeof(uint32_t));
+    uint32_t *tmp = (uint32_t *)canonAlloc(c, (size_t)count * sizeof(uint32_t), sizeof(uint32_t));
+    Issuer issuer;
+    if (!paths || !idx || !tmp || !issuerAlloc(c, &issuer)) goto done;
+
+    int pathCount = 0;
+    for (int i = 0; i < count; i++) {
+        int blank = (int)members[i];
+        if (c->canonical.label[blank] != NO_BLANK) continue;
+
+        // Reset the working issuer by undoing what the last member issued
+        for (int k = 0; k < issuer.count; k++) issuer.label[issuer.order[k]] = NO_BLANK;
+        issuer.count = 0;
+        issue(&issuer, blank);
+
+        HashPath *path = &paths[pathCount];
+        status = hashNDegree(c, blank, &issuer, path->hash);
+        if (status != RDF_OK) goto done;
+        status = RDF_ERR_ARENA_FULL;
+        path->order = (uint16_t *)canonAlloc(c, (size_t)issuer.count * sizeof(uint16_t), sizeof(uint16_t));
+        if (!path->order) goto done;
+        memcpy(path->order, issuer.order, (size_t)issuer.count * sizeof(uint16_t));
+        path->count = issuer.count;
+        idx[pathCount] = (uint32_t)pathCount;
+        pathCount++;
+    }
+
+    sortIndexes(idx, tmp, pathCount, compareHashPaths, paths);
+    for (int i = 0; i < pathCount; i++) {
+        const HashPath *path = &paths[idx[i]];
+        for (int k = 0; k < path->count; k++) {
+            issue(&c->canonical, path->order[k]);
+        }
+    }
+    status = RDF_OK;
+
+done:
+    RDFArena_release(c->scratch, mark);
+    return status;
+}
+
+// RDFCanon_run(), also reporting in labelled[n] the graph term that became
+// _:c14n<n> for the first maxLabelled labels
+static RDFStatus canonRun(const RDFGraph *graph, RDFArena *scratch, const RDFCanonOptions *options,
+                          RDFCanonDataset *out, RDFCanonStats *stats, RDFTermId *labelled, int maxLabelled)
+{
+    Canon c;
+    memset(&c, 0, sizeof(c));
+    c.graph = graph;
+    c.scratch = scratch;
+    c.options = options;
+    c.peak = scratch->used;
+
+    RDFStatus status = RDF_ERR_ARENA_FULL;
+    size_t start = scratch->used;
+    uint32_t phaseTicks[RDFC_PHASE_COUNT] = {0};
+    uint32_t t0 = now(&c);
+
+    // The quads are allocated first so the working set above them can be
+    // released in one step; they are relabelled in place at the end
+    int count = graph->size;
+    RDFTriple *quads = (RDFTriple *)canonAlloc(&c, (size_t)count * sizeof(RDFTriple) + 1, sizeof(RDFTermId));
+    if (!quads) goto fail;
+    size_t work = scratch->used;
+
+    // 1-2. Blank node to quads map over the de-duplicated input
+    for (int i = 0; i < count; i++) quads[i] = *RDFGraph_triple(graph, i);
+    c.quads = quads;
+    c.quadCount = RDFGraph_sortQuads(quads, count, graph->termCount, compareIds, NULL, scratch, 1);
+    status = mapBlankNodes(&c);
+    if (status != RDF_OK) goto fail;
+    if ((long)graph->termCount + c.blankCount >= (long)RDF_NO_TERM) {
+        status = RDF_ERR_TERMS_FULL;
+        goto fail;
+    }
+    phaseTicks[RDFC_PHASE_MAP] = now(&c) - t0;
+    t0 = now(&c);
+
+    // 3. First degree hashes
+    status = RDF_ERR_ARENA_FULL;
+    c.firstHash = (uint8_t (*)[SHA256_DIGEST_SIZE])canonAlloc(&c, (size_t)c.blankCount * SHA256_DIGEST_SIZE + 1, 1);
+    uint32_t *byHash = (uint32_t *)canonAlloc(&c, (size_t)c.blankCount * sizeof(uint32_t) + 1, sizeof(uint32_t));
+    uint32_t *tmp = (uint32_t *)canonAlloc(&c, (size_t)c.blankCount * sizeof(uint32_t) + 1, sizeof(uint32_t));
+    if (!c.firstHash || !byHash || !tmp || !issuerAlloc(&c, &c.canonical)) goto fail;
+    for (int b = 0; b < c.blankCount; b++) {
+        status = hashFirstDegree(&c, b);
+        if (status != RDF_OK) goto fail;
+        byHash[b] = (uint32_t)b;
+    }
+    sortIndexes(byHash, tmp, c.blankCount, compareFirstHash, &c);
+    phaseTicks[RDFC_PHASE_FIRST_DEGREE] = now(&c) - t0;
+    t0 = now(&c);
+
+    // 4. Blank nodes with a unique first degree hash are labelled in hash order
+    for (int i = 0; i < c.blankCount; ) {
+        int j = i + 1;
+        while (j < c.blankCount && compareFirstHash(&c, byHash[i], byHash[j]) == 0) j++;
+        if (j - i == 1) issue(&c.canonical, (int)byHash[i]);
+        i = j;
+    }
+    phaseTicks[RDFC_PHASE_UNIQUE] = now(&c) - t0;
+    t0 = now(&c);
+
+    // 5. The others are told apart by Hash N-Degree Quads
+    for (int i = 0; i < c.blankCount; ) {
+        int j = i + 1;
+        while (j < c.blankCount && compareFirstHash(&c, byHash[i], byHash[j]) == 0) j++;
+        if (j - i > 1) {
+            status = labelSharedHash(&c, byHash + i, j - i);
+            if (status != RDF_OK) goto fail;
+        }
+        i = j;
+    }
+    phaseTicks[RDFC_PHASE_N_DEGREE] = now(&c) - t0;
+    t0 = now(&c);
+
+    // 6. Replace blank nodes by their canonical labels and sort the lines
+    RDFTermId labelBase = (RDFTermId)graph->termCount;
+    for (int i = 0; i < c.quadCount; i++) {
+        RDFTriple *q = &quads[i];
+        int s = blankIndex(&c, q->subject), o = blankIndex(&c, q->object), g = blankIndex(&c, q->graph);
+        if (labelled) {
+            const RDFTermId components[3] = { q->subject, q->object, q->graph };
+            const int blanks[3] = { s, o, g };
+            for (int k = 0; k < 3; k++) {
+                if (blanks[k] == (int)NO_BLANK || c.canonical.label[blanks[k]] >= maxLabelled) continue;
+                labelled[c.canonical.label[blanks[k]]] = components[k];
+            }
+        }
+        if (s != (int)NO_BLANK) q->subject = (RDFTermId)(labelBase + c.canonical.label[s]);
+        if (o != (int)NO_BLANK) q->object = (RDFTermId)(labelBase + c.canonical.label[o]);
+        if (g != (int)NO_BLANK) q->graph = (RDFTermId)(labelBase + c.canonical.label[g]);
+    }
+    TermView view = { graph, labelBase, NULL, -1 };
+    RDFArena_release(scratch, work);
+    RDFGraph_sortQuads(quads, c.quadCount, graph->termCount + c.blankCount,
+                       compareCanonicalTerms, &view, scratch, 0);
+    phaseTicks[RDFC_PHASE_OUTPUT] = now(&c) - t0;
+
+    out->graph = graph;
+    out->quads = quads;
+    out->count = c.quadCount;
+    out->labelBase = labelBase;
+    if (stats) {
+        memcpy(stats->phaseTicks, phaseTicks, sizeof(phaseTicks));
+        stats->blankNodes = (uint32_t)c.blankCount;
+        stats->nDegreeCalls = c.nDegreeCalls;
+        stats->scratchPeak = c.peak;
+    }
+    RDFArena_release(scratch, work);
+    return RDF_OK;
+
+fail:
+    RDFArena_release(scratch, start);
+    return status;
+}
+
+RDFStatus RDFCanon_run(const RDFGraph *graph, RDFArena *scratch, const RDFCanonOptions *options,
+                       RDFCanonDataset *out, RDFCanonStats *stats)
+{
+    return canonRun(graph, scratch, options, out, stats, NULL, 0);
+}
+
+void RDFCanon_writeNQuads(const RDFCanonDataset *dataset, RDFSinkFn sink, void *ctx)
+{
+    TermView view = { dataset->graph, dataset->labelBase, NULL, -1 };
+    for (int i = 0; i < dataset->count; i++) {
+        writeQuad(&view, &dataset->quads[i], sink, ctx);
+    }
+}
+
+RDFStatus RDFCanon_serialize(const RDFGraph *graph, RDFArena *scratch, const RDFCanonOptions *options,
+                             RDFSinkFn sink, void *ctx)
+{
+    size_t mark = scratch->used;
+    RDFCanonDataset canonical;
+    RDFStatus status = RDFCanon_run(graph, scratch, options, &canonical, NULL);
+    if (status == RDF_OK) {
+        RDFCanon_writeNQuads(&canonical, sink, ctx);
+    }
+    RDFArena_release(scratch, mark);
+    return status;
+}
+
+/* Incremental re-canonicalization -------------------------------------------*/
+
+// Cached lines name canonical blank node n as CACHE_LABEL_BASE + n, above
+// every graph term id
+#define CACHE_LABEL_BASE ((RDFTermId)RDF_MAX_TERMS)
+
+static int isLabel(RDFTermId id)
+{
+    return id != RDF_NO_TERM && id >= CACHE_LABEL_BASE;
+}
+
+static int hasLabel(const RDFTriple *q)
+{
+    return isLabel(q->subject) || isLabel(q->object) || isLabel(q->graph);
+}
+
+// Cached form of a graph quad; returns 0 when it names a blank node the
+// cache has no label for
+static int relabel(const RDFCanonCache *cache, const RDFGraph *graph, RDFTriple *q)
+{
+    RDFTermId *components[3] = { &q->subject, &q->object, &q->graph };
+    for (int k = 0; k < 3; k++) {
+        RDFTermId id = *components[k];
+        if (id == RDF_NO_TERM || RDFGraph_termKind(graph, id) != RDF_TERM_BLANK) continue;
+        int n = 0;
+        while (n < cache->blankCount && cache->blank[n] != id) n++;
+        if (n == cache->blankCount) return 0;
+        *components[k] = (RDFTermId)(CACHE_LABEL_BASE + n);
+    }
+    return 1;
+}
+
+typedef struct {
+    TermView view;
+    const RDFTriple *quads;
+} LineOrder;
+
+static int compareLines(const void *ctx, uint32_t a, uint32_t b)
+{
+    const LineOrder *order = (const LineOrder *)ctx;
+    return compareQuadLines(&order->view, &order->quads[a], &order->quads[b]);
+}
+
+void RDFCanonCache_init(RDFCanonCache *cache, size_t digestSize)
+{
+    memset(cache, 0, sizeof(*cache));
+    if (digestSize == SHA224_DIGEST_SIZE) {
+        SHA224_init(&cache->checkpoints[0].hash);
+    } else {
+        SHA256_init(&cache->checkpoints[0].hash);
+    }
+    cache->checkpointCount = 1;
+}
+
+// Canonicalize from scratch and find the graph triple behind every line
+static RDFStatus fullRun(RDFCanonCache *cache, const RDFGraph *graph, RDFArena *scratch,
+                         const RDFCanonOptions *options)
+{
+    size_t mark = scratch->used;
+    RDFCanonDataset canonical;
+    RDFCanonStats stats;
+    cache->valid = 0;
+    if (graph->size > MAX_TRIPLES) return RDF_ERR_GRAPH_FULL;
+    RDFStatus status = canonRun(graph, scratch, options, &canonical, &stats, cache->blank, RDFC_CACHE_BLANKS);
+    if (status != RDF_OK) return status;
+
+    for (int i = 0; i < canonical.count; i++) {
+        RDFTriple q = canonical.quads[i];
+        if (q.subject >= canonical.labelBase) q.subject = (RDFTermId)(q.subject - canonical.labelBase + CACHE_LABEL_BASE);
+        if (q.object >= canonical.labelBase) q.object = (RDFTermId)(q.object - canonical.labelBase + CACHE_LABEL_BASE);
+        if (q.graph != RDF_NO_TERM && q.graph >= canonical.labelBase) q.graph = (RDFTermId)(q.graph - canonical.labelBase + CACHE_LABEL_BASE);
+        cache->quads[i] = q;
+    }
+    RDFArena_release(scratch, mark);
+    cache->count = canonical.count;
+    cache->blankCount = (int)stats.blankNodes;
+    cache->reusable = stats.blankNodes <= RDFC_CACHE_BLANKS && canonical.count == graph->size;
+    cache->valid = 1;
+
+    if (cache->reusable) {
+        TermView view = { graph, CACHE_LABEL_BASE, NULL, -1 };
+        for (int t = 0; t < graph->size; t++) {
+            RDFTriple q = *RDFGraph_triple(graph, t);
+            relabel(cache, graph, &q);
+            int lo = 0, hi = cache->count - 1;
+            while (lo < hi) {
+                int mid = (lo + hi) / 2;
+                if (compareQuadLines(&view, &cache->quads[mid], &q) < 0) lo = mid + 1;
+                else hi = mid;
+            }
+            cache->source[lo] = (uint32_t)t;
+        }
+    }
+    return RDF_OK;
+}
+
+static int isChanged(const RDFGraph *graph, uint32_t index)
+{
+    return index >= (uint32_t)graph->size || RDFGraph_isDirty(graph, (int)index);
+}
+
+// Merge the graph's changes into the cached lines. Returns the first line
+// that differs from before, or -1 when labels could move and RDFC has to
+// run again.
+static int updateLines(RDFCanonCache *cache, const RDFGraph *graph, RDFArena *scratch)
+{
+    if (!cache->valid || !cache->reusable || graph->reordered) return -1;
+
+    // Labels only stay put when no more than one blank node is involved
+    int stable = cache->blankCount <= 1;
+    int removed = 0;
+    for (int i = 0; i < cache->count; i++) {
+        if (!isChanged(graph, cache->source[i])) continue;
+        if (!stable && hasLabel(&cache->quads[i])) return -1;
+        removed++;
+    }
+    int added = 0;
+    for (int t = 0; t < graph->size; t++) {
+        added += RDFGraph_isDirty(graph, t);
+    }
+    int result = -1;
+    size_t mark = scratch->used;
+    int count = cache->count - removed + added;
+    RDFTriple *quads = (RDFTriple *)RDFArena_alloc(scratch, (size_t)(added + count) * sizeof(RDFTriple) + 1, sizeof(RDFTermId));
+    uint32_t *source = (uint32_t *)RDFArena_alloc(scratch, (size_t)(2 * added + count) * sizeof(uint32_t) + 1, sizeof(uint32_t));
+    uint32_t *tmp = (uint32_t *)RDFArena_alloc(scratch, (size_t)added * sizeof(uint32_t) + 1, sizeof(uint32_t));
+    if (!quads || !source || !tmp || count > MAX_TRIPLES) goto done;
+
+    // The changed triples in cached form and line order
+    RDFTriple *changed = quads + count;
+    uint32_t *order = source + count;
+    uint32_t *changedSource = order + added;
+    int n = 0;
+    for (int t = 0; t < graph->size; t++) {
+        if (!RDFGraph_isDirty(graph, t)) continue;
+        changed[n] = *RDFGraph_triple(graph, t);
+        if (!relabel(cache, graph, &changed[n]) || (!stable && hasLabel(&changed[n]))) goto done;
+        changedSource[n] = (uint32_t)t;
+        order[n] = (uint32_t)n;
+        n++;
+    }
+    LineOrder lines = { { graph, CACHE_LABEL_BASE, NULL, -1 }, changed };
+    sortIndexes(order, tmp, added, compareLines, &lines);
+
+    // Merge; an equal pair means duplicate triples, which RDFC drops
+    for (int a = 1; a < added; a++) {
+        if (compareLines(&lines, order[a - 1], order[a]) == 0) goto done;
+    }
+    int first = -1;
+    int i = 0, j = 0, k = 0;
+    while (i < cache->count || j < added) {
+        if (i < cache->count && isChanged(graph, cache->source[i])) {
+            if (first < 0) first = k;
+            i++;
+            continue;
+        }
+        int cmp = i == cache->count ? 1 : j == added ? -1
+                : compareQuadLines(&lines.view, &cache->quads[i], &changed[order[j]]);
+        if (cmp == 0) goto done;
+        if (cmp < 0) {
+            quads[k] = cache->quads[i];
+            source[k++] = cache->source[i++];
+        } else {
+            if (first < 0) first = k;
+            quads[k] = changed[order[j]];
+            source[k++] = changedSource[order[j++]];
+        }
+    }
+
+    memcpy(cache->quads, quads, (size_t)count * sizeof(RDFTriple));
+    memcpy(cache->source, source, (size_t)count * sizeof(uint32_t));
+    cache->count = count;
+    result = first < 0 ? count : first;
+
+done:
+    RDFArena_release(scratch, mark);
+    return result;
+}
+
+// Absorb the lines from first on, resuming at the last checkpoint before
+// it and placing new checkpoints evenly over the rest
+static void hashLines(RDFCanonCache *cache, const RDFGraph *graph, int first, uint8_t *digest)
+{
+    int c = cache->checkpointCount;
+    while (c > 1 && cache->checkpoints[c - 1].line > first) c--;
+    SHA256Context md = cache->checkpoints[c - 1].hash;
+    int line = cache->checkpoints[c - 1].line;
+    int stride = (cache->count + RDFC_CACHE_CHECKPOINTS - 1) / RDFC_CACHE_CHECKPOINTS;
+    if (stride < 1) stride = 1;
+
+    TermView view = { graph, CACHE_LABEL_BASE, NULL, -1 };
+    cache->linesHashed = (uint32_t)(cache->count - line);
+    for (; line < cache->count; line++) {
+        if (line % stride == 0 && line > cache->checkpoints[c - 1].line && c < RDFC_CACHE_CHECKPOINTS) {
+            cache->checkpoints[c].hash = md;
+            cache->checkpoints[c].line = line;
+            c++;
+        }
+        writeQuad(&view, &cache->quads[line], hashWrite, &md);
+    }
+    cache->checkpointCount = c;
+    SHA256_final(&md, digest);
+}
+
+RDFStatus RDFCanonCache_digest(RDFCanonCache *cache, RDFGraph *graph, RDFArena *scratch,
+                               const RDFCanonOptions *options, uint8_t *digest)
+{
+    int first = updateLines(cache, graph, scratch);
+    cache->fullRun = first < 0;
+    if (first < 0) {
+        RDFStatus status = fullRun(cache, graph, scratch, options);
+        if (status != RDF_OK) return status;
+        first = 0;
+    }
+    hashLines(cache, graph, first, digest);
+    RDFGraph_clearChanges(graph);
+    return RDF_OK;
+}
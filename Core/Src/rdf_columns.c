@@ -0,0 +1,160 @@
+#include "rdf_columns.h"
+
+#include <string.h>
+
+void RDFColumns_init(RDFColumns *columns, void *block, size_t size)
+{
+    size_t capacity = size / (4 * sizeof(RDFTermId));
+    if (capacity > INT32_MAX) capacity = INT32_MAX;
+    columns->subject = (RDFTermId *)block;
+    columns->predicate = columns->subject + capacity;
+    columns->object = columns->predicate + capacity;
+    columns->graph = columns->object + capacity;
+    columns->size = 0;
+    columns->capacity = (int)capacity;
+}
+
+RDFStatus RDFColumns_add(RDFColumns *columns, RDFTermId subject, RDFTermId predicate, RDFTermId object,
+                         RDFTermId graphName)
+{
+    if (columns->size >= columns->capacity) {
+        return RDF_ERR_GRAPH_FULL;
+    }
+    int i = columns->size++;
+    columns->subject[i] = subject;
+    columns->predicate[i] = predicate;
+    columns->object[i] = object;
+    columns->graph[i] = graphName;
+    return RDF_OK;
+}
+
+RDFStatus RDFColumns_load(RDFColumns *columns, const RDFGraph *graph)
+{
+    if (graph->size > columns->capacity) {
+        return RDF_ERR_GRAPH_FULL;
+    }
+    for (int i = 0; i < graph->size; i++) {
+        const RDFTriple *quad = RDFGraph_triple(graph, i);
+        columns->subject[i] = quad->subject;
+        columns->predicate[i] = quad->predicate;
+        columns->object[i] = quad->object;
+        columns->graph[i] = quad->graph;
+    }
+    columns->size = graph->size;
+    return RDF_OK;
+}
+
+RDFStatus RDFColumns_store(const RDFColumns *columns, RDFGraph *graph)
+{
+    RDFStatus status = RDFGraph_reserve(graph, columns->size);
+    if (status != RDF_OK) {
+        return status;
+    }
+    RDFGraph_truncate(graph, 0);
+    for (int i = 0; i < columns->size; i++) {
+        RDFTriple quad = RDFColumns_quad(columns, i);
+        RDFGraph_addQuadIds(graph, quad.subject, quad.predicate, quad.object, quad.graph);
+    }
+    graph->reordered = 1;
+    return RDF_OK;
+}
+
+// Position of the first id at or after from in column[0..size), size if
+// there is none. Compares four ids per 64-bit word: a halfword of x is
+// zero exactly where the id matches.
+static int findId(const RDFTermId *column, int from, int size, RDFTermId id)
+{
+    const uint64_t ones = 0x0001000100010001u, highs = 0x8000800080008000u;
+    uint64_t pattern = ones * id;
+    int i = from;
+    for (; i + 4 <= size; i += 4) {
+        uint64_t word;
+        memcpy(&word, column + i, sizeof(word));
+        uint64_t x = word ^ pattern;
+        if (((x - ones) & ~x & highs) != 0) break;
+    }
+    while (i < size && column[i] != id) i++;
+    return i;
+}
+
+// Only the most selective bound column is scanned, on its own: subjects
+// and objects tend to repeat less than predicates. The others are read
+// at its matches alone.
+int RDFColumns_next(const RDFColumns *columns, int from, RDFTermId subject, RDFTermId predicate, RDFTermId object)
+{
+    const RDFTermId *scan = subject != RDF_NO_TERM ? columns->subject
+                          : object != RDF_NO_TERM ? columns->object
+                          : predicate != RDF_NO_TERM ? columns->predicate : NULL;
+    RDFTermId id = subject != RDF_NO_TERM ? subject : object != RDF_NO_TERM ? object : predicate;
+    if (!scan) {
+        return from < columns->size ? from : -1;
+    }
+
+    for (int i = findId(scan, from, columns->size, id); i < columns->size;
+         i = findId(scan, i + 1, columns->size, id)) {
+        if ((subject == RDF_NO_TERM || columns->subject[i] == subject)
+            && (predicate == RDF_NO_TERM || columns->predicate[i] == predicate)
+            && (object == RDF_NO_TERM || columns->object[i] == object)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+RDFStatus RDFColumns_sort(RDFColumns *columns, int termCount, RDFTermCompare compare, const void *ctx,
+                          RDFArena *scratch, int unique)
+{
+    int count = columns->size;
+    if (count < 2) return RDF_OK;
+
+    size_t mark = scratch->used;
+    RDFTermRanks ranks;
+    uint64_t *keys = NULL, *buf = NULL;
+    if (RDFGraph_rankTerms(&ranks, termCount, compare, ctx, scratch)) {
+        keys = (uint64_t *)RDFArena_alloc(scratch, (size_t)count * sizeof(uint64_t), sizeof(uint64_t));
+        buf = (uint64_t *)RDFArena_alloc(scratch, (size_t)count * sizeof(uint64_t), sizeof(uint64_t));
+    }
+    if (!keys || !buf) {
+        RDFArena_release(scratch, mark);
+        return RDF_ERR_ARENA_FULL;
+    }
+
+    for (int i = 0; i < count; i++) {
+        keys[i] = RDFTermRanks_key(&ranks, columns->subject[i], columns->predicate[i],
+                                   columns->object[i], columns->graph[i]);
+    }
+    const uint64_t *sorted = RDFGraph_radixSort(keys, buf, count, 4 * ranks.bits);
+
+    // Equal keys are equal quads, so duplicates go before unpacking
+    int bits = ranks.bits;
+    uint64_t mask = ((uint64_t)1 << bits) - 1;
+    int kept = 0;
+    for (int i = 0; i < count; i++) {
+        uint64_t key = sorted[i];
+        if (unique && i > 0 && key == sorted[i - 1]) continue;
+        columns->subject[kept] = ranks.termOf[(key >> (3 * bits)) & mask];
+        columns->predicate[kept] = ranks.termOf[(key >> (2 * bits)) & mask];
+        columns->object[kept] = ranks.termOf[(key >> bits) & mask];
+        columns->graph[kept] = ranks.termOf[key & mask];
+        kept++;
+    }
+    columns->size = kept;
+    RDFArena_release(scratch, mark);
+    return RDF_OK;
+}
+
+void RDFColumns_filter(RDFColumns *columns, RDFQuadFilter keep, void *ctx)
+{
+    int kept = 0;
+    for (int i = 0; i < columns->size; i++) {
+        RDFTriple quad = RDFColumns_quad(columns, i);
+        if (keep(ctx, &quad)) {
+            columns->subject[kept] = quad.subject;
+            columns->predicate[kept] = quad.predicate;
+            columns->object[kept] = quad.object;
+            columns->graph[kept] = quad.graph;
+            kept++;
+        }
+    }
+    columns->size = kept;
+}
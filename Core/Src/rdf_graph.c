@@ -0,0 +1,724 @@
+#include "rdf_graph.h"
+
+#include <ctype.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+void RDFArena_init(RDFArena *arena, void *buffer, size_t capacity)
+{
+    arena->base = (uint8_t *)buffer;
+    arena->capacity = capacity;
+    arena->used = 0;
+}
+
+// Returns NULL when the arena is exhausted; align must be a power of two
+void *RDFArena_alloc(RDFArena *arena, size_t size, size_t align)
+{
+    size_t start = (arena->used + (align - 1)) & ~(align - 1);
+    if (start > arena->capacity || size > arena->capacity - start) {
+        return NULL;
+    }
+    arena->used = start + size;
+    return arena->base + start;
+}
+
+// Drop everything allocated after mark (a previous value of arena->used)
+void RDFArena_release(RDFArena *arena, size_t mark)
+{
+    if (mark < arena->used) {
+        arena->used = mark;
+    }
+}
+
+// FNV-1a over the prefix id and the suffix, good enough for a few dozen
+// short terms
+static uint32_t hashTerm(uint8_t prefix, const char *str, size_t len)
+{
+    uint32_t h = (2166136261u ^ prefix) * 16777619u;
+    for (size_t i = 0; i < len; i++) {
+        h ^= (uint8_t)str[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static size_t prefixLength(uint8_t prefix)
+{
+    return prefix == RDF_VOCAB_NO_PREFIX ? 0 : RDFVocab_prefixes[prefix].length;
+}
+
+// Versions come from one counter for all graphs, so a re-initialized graph
+// never repeats a version an index took from its earlier contents
+static uint32_t lastVersion;
+
+static void bumpVersion(RDFGraph *graph)
+{
+    graph->version = ++lastVersion;
+}
+
+// RDFGraph "constructor": the graph never touches the heap, every term
+// and triple page lives in the caller supplied arena
+void RDFGraph_init(RDFGraph *graph, void *arena, size_t arenaSize)
+{
+    RDFArena_init(&graph->arena, arena, arenaSize);
+    memset(graph->buckets, 0xFF, sizeof(graph->buckets));
+    graph->termCount = 0;
+    graph->pages = NULL;
+    graph->pageCount = 0;
+    graph->pageSlots = 0;
+    graph->size = 0;
+    graph->reordered = 1;
+    bumpVersion(graph);
+}
+
+static RDFTriple *tripleAt(RDFGraph *graph, int index)
+{
+    return &graph->pages[index / RDF_TRIPLE_PAGE]->triples[index % RDF_TRIPLE_PAGE];
+}
+
+static void markDirty(RDFGraph *graph, int index)
+{
+    graph->pages[index / RDF_TRIPLE_PAGE]->dirty |= 1u << (index % RDF_TRIPLE_PAGE);
+    bumpVersion(graph);
+}
+
+// Make room for count triples in all. Pages come from the arena and stay
+// with the graph until RDFGraph_free(); the page directory doubles when it
+// fills, leaving the old one behind, which costs under 4 bytes per page.
+RDFStatus RDFGraph_reserve(RDFGraph *graph, int count)
+{
+    if (count < 0 || count > INT_MAX - RDF_TRIPLE_PAGE) {
+        return RDF_ERR_GRAPH_FULL;
+    }
+    int pages = (count + RDF_TRIPLE_PAGE - 1) / RDF_TRIPLE_PAGE;
+    if (pages > graph->pageSlots) {
+        int slots = graph->pageSlots > 0 ? graph->pageSlots : 4;
+        while (slots < pages) slots *= 2;
+        RDFTriplePage **directory = (RDFTriplePage **)RDFArena_alloc(&graph->arena, (size_t)slots * sizeof(RDFTriplePage *),
+                                                                     sizeof(RDFTriplePage *));
+        if (!directory) {
+            return RDF_ERR_ARENA_FULL;
+        }
+        if (graph->pageCount > 0) {
+            memcpy(directory, graph->pages, (size_t)graph->pageCount * sizeof(RDFTriplePage *));
+        }
+        graph->pages = directory;
+        graph->pageSlots = slots;
+    }
+    while (graph->pageCount < pages) {
+        RDFTriplePage *page = (RDFTriplePage *)RDFArena_alloc(&graph->arena, sizeof(RDFTriplePage), sizeof(uint32_t));
+        if (!page) {
+            return RDF_ERR_ARENA_FULL;
+        }
+        page->dirty = 0;
+        graph->pages[graph->pageCount++] = page;
+    }
+    return RDF_OK;
+}
+
+// Room for one more triple, taking a page from the arena when the last
+// one is full
+static RDFStatus reserveNext(RDFGraph *graph)
+{
+    if (graph->size < graph->pageCount * RDF_TRIPLE_PAGE) {
+        return RDF_OK;
+    }
+    return RDFGraph_reserve(graph, graph->size + 1);
+}
+
+// Slot of the term with this prefix and suffix in the interning table:
+// either the bucket holding it or the empty bucket where it would go
+static uint32_t findSlot(const RDFGraph *graph, uint8_t prefix, const char *suffix, size_t len)
+{
+    uint32_t slot = hashTerm(prefix, suffix, len) & (RDF_TERM_BUCKETS - 1);
+
+    while (graph->buckets[slot] != RDF_NO_TERM) {
+        const RDFTerm *term = &graph->terms[graph->buckets[slot]];
+        if (term->prefix == prefix && term->length == len && memcmp(term->text, suffix, len) == 0) {
+            break;
+        }
+        slot = (slot + 1) & (RDF_TERM_BUCKETS - 1);
+    }
+    return slot;
+}
+
+// Kind and lexical form of a term from its text. A typed literal's
+// datatype IRI is text[*datatypeStart..len - 1).
+static void decodeTerm(RDFTerm *term, const char *text, size_t len, size_t *datatypeStart)
+{
+    term->kind = RDF_TERM_IRI;
+    term->lexicalLength = 0;
+    term->datatype = RDF_NO_TERM;
+    if (len >= 2 && text[0] == '_' && text[1] == ':') {
+        term->kind = RDF_TERM_BLANK;
+    }
+    if (len < 2 || text[0] != '"') return;
+
+    // The lexical form escapes its quotes, so the last quote closes it;
+    // without one, the last character is taken to close it
+    size_t close = len - 1;
+    while (close > 0 && text[close] != '"') close--;
+    if (close == 0) close = len - 1;
+    term->kind = RDF_TERM_LITERAL;
+    term->lexicalLength = (uint16_t)(close - 1);
+    if (close + 1 < len && text[close + 1] == '@') {
+        term->kind = RDF_TERM_LANG_LITERAL;
+    } else if (close + 4 < len && memcmp(text + close + 1, "^^<", 3) == 0 && text[len - 1] == '>') {
+        term->kind = RDF_TERM_TYPED_LITERAL;
+        *datatypeStart = close + 4;
+    }
+}
+
+// A known prefix is matched once, here, and only the suffix is stored. A
+// typed literal's datatype is interned too, by reference to the literal.
+static RDFTermId internTerm(RDFGraph *graph, const char *str, size_t len, int copy)
+{
+    uint8_t prefix = RDFVocab_matchPrefix(str, len);
+    size_t skip = prefixLength(prefix);
+    const char *suffix = str + skip;
+    len -= skip;
+
+    uint32_t slot = findSlot(graph, prefix, suffix, len);
+    if (graph->buckets[slot] != RDF_NO_TERM) {
+        return graph->buckets[slot];
+    }
+
+    if (graph->termCount >= RDF_MAX_TERMS || len > UINT16_MAX) {
+        return RDF_NO_TERM;
+    }
+    size_t mark = graph->arena.used;
+    const char *text = suffix;
+    if (copy) {
+        char *dup = (char *)RDFArena_alloc(&graph->arena, len + 1, 1);
+        if (!dup) {
+            return RDF_NO_TERM;
+        }
+        memcpy(dup, suffix, len);
+        dup[len] = '\0';
+        text = dup;
+    }
+
+    RDFTerm term = { text, (uint16_t)len, RDF_TERM_IRI, prefix, 0, RDF_NO_TERM };
+    size_t datatypeStart = 0;
+    if (prefix == RDF_VOCAB_NO_PREFIX) {
+        decodeTerm(&term, text, len, &datatypeStart);
+    }
+    if (term.kind == RDF_TERM_TYPED_LITERAL) {
+        const char *datatype = text + datatypeStart;
+        size_t datatypeLength = len - datatypeStart - 1;
+        // A new datatype points into the copy, so both must fit before
+        // either is interned: releasing the copy would leave it dangling
+        if (graph->termCount + 2 > RDF_MAX_TERMS && RDFGraph_find(graph, datatype, datatypeLength) == RDF_NO_TERM) {
+            RDFArena_release(&graph->arena, mark);
+            return RDF_NO_TERM;
+        }
+        term.datatype = internTerm(graph, datatype, datatypeLength, 0);
+        if (term.datatype == RDF_NO_TERM || graph->termCount >= RDF_MAX_TERMS) {
+            RDFArena_release(&graph->arena, mark);
+            return RDF_NO_TERM;
+        }
+        slot = findSlot(graph, prefix, suffix, len);  // the datatype may have taken it
+    }
+
+    RDFTermId id = (RDFTermId)graph->termCount++;
+    graph->terms[id] = term;
+    graph->buckets[slot] = id;
+    return id;
+}
+
+// Return the id of str[0..len), copying it into the arena the first time
+// it is seen. Returns RDF_NO_TERM when the term table or arena is full.
+RDFTermId RDFGraph_intern(RDFGraph *graph, const char *str, size_t len)
+{
+    return internTerm(graph, str, len, 1);
+}
+
+// Like RDFGraph_intern(), but a new term keeps pointing at str, which is
+// not copied and need not be NUL-terminated. str must stay unchanged for
+// as long as the graph is in use, e.g. a receive buffer or flash.
+RDFTermId RDFGraph_internRef(RDFGraph *graph, const char *str, size_t len)
+{
+    return internTerm(graph, str, len, 0);
+}
+
+// Id of an already interned term, RDF_NO_TERM if the graph has none
+RDFTermId RDFGraph_find(const RDFGraph *graph, const char *str, size_t len)
+{
+    uint8_t prefix = RDFVocab_matchPrefix(str, len);
+    size_t skip = prefixLength(prefix);
+    return graph->buckets[findSlot(graph, prefix, str + skip, len - skip)];
+}
+
+// Intern str with leading and trailing whitespace stripped
+static RDFTermId internTrimmed(RDFGraph *graph, const char *str)
+{
+    if (!str) return RDF_NO_TERM;
+
+    const char *end = str + strlen(str);
+    while (isspace((unsigned char)*str)) str++;
+    while (end > str && isspace((unsigned char)end[-1])) end--;
+
+    return RDFGraph_intern(graph, str, (size_t)(end - str));
+}
+
+// Report why interning failed so callers can tell a full table from a full arena
+static RDFStatus internFailure(const RDFGraph *graph)
+{
+    return graph->termCount >= RDF_MAX_TERMS ? RDF_ERR_TERMS_FULL : RDF_ERR_ARENA_FULL;
+}
+
+// Add a quad to the RDF graph; graphName NULL means the default graph
+RDFStatus RDFGraph_addQuad(RDFGraph *graph, const char *subject, const char *predicate, const char *object, const char *graphName)
+{
+    if (!subject || !predicate || !object) {
+        return RDF_ERR_INVALID;
+    }
+    RDFStatus status = reserveNext(graph);
+    if (status != RDF_OK) {
+        return status;
+    }
+
+    // Nothing is rolled back on failure: a partially interned triple
+    // only leaves unused terms behind, which RDFGraph_free() reclaims
+    RDFTriple triple;
+    triple.subject = internTrimmed(graph, subject);
+    if (triple.subject == RDF_NO_TERM) return internFailure(graph);
+    triple.predicate = internTrimmed(graph, predicate);
+    if (triple.predicate == RDF_NO_TERM) return internFailure(graph);
+    triple.object = internTrimmed(graph, object);
+    if (triple.object == RDF_NO_TERM) return internFailure(graph);
+    triple.graph = RDF_NO_TERM;
+    if (graphName) {
+        triple.graph = internTrimmed(graph, graphName);
+        if (triple.graph == RDF_NO_TERM) return internFailure(graph);
+    }
+
+    markDirty(graph, graph->size);
+    *tripleAt(graph, graph->size++) = triple;
+    return RDF_OK;
+}
+
+// Add a quad whose terms are already interned
+RDFStatus RDFGraph_addQuadIds(RDFGraph *graph, RDFTermId subject, RDFTermId predicate, RDFTermId object, RDFTermId graphName)
+{
+    if (subject == RDF_NO_TERM || predicate == RDF_NO_TERM || object == RDF_NO_TERM) {
+        return RDF_ERR_INVALID;
+    }
+    RDFStatus status = reserveNext(graph);
+    if (status != RDF_OK) {
+        return status;
+    }
+
+    markDirty(graph, graph->size);
+    RDFTriple *triple = tripleAt(graph, graph->size++);
+    triple->subject = subject;
+    triple->predicate = predicate;
+    triple->object = object;
+    triple->graph = graphName;
+    return RDF_OK;
+}
+
+// Add a triple to the RDF graph
+RDFStatus RDFGraph_addTriple(RDFGraph *graph, const char *subject, const char *predicate, const char *object)
+{
+    return RDFGraph_addQuad(graph, subject, predicate, object, NULL);
+}
+
+// Replace the object of triple index in place, e.g. the timestamp of a
+// credential that is otherwise signed unchanged. The old object stays in
+// the term table; on failure the triple is left as it was.
+RDFStatus RDFGraph_setObject(RDFGraph *graph, int index, const char *object)
+{
+    if (index < 0 || index >= graph->size) {
+        return RDF_ERR_INVALID;
+    }
+    RDFTermId id = internTrimmed(graph, object);
+    if (id == RDF_NO_TERM) {
+        return object ? internFailure(graph) : RDF_ERR_INVALID;
+    }
+    RDFTriple *triple = tripleAt(graph, index);
+    if (triple->object != id) {
+        triple->object = id;
+        markDirty(graph, index);
+    }
+    return RDF_OK;
+}
+
+// Drop the triples from index size on; the ones before keep their places
+void RDFGraph_truncate(RDFGraph *graph, int size)
+{
+    for (int i = size; i < graph->size; i++) {
+        graph->pages[i / RDF_TRIPLE_PAGE]->dirty &= ~(1u << (i % RDF_TRIPLE_PAGE));
+    }
+    if (size < graph->size) {
+        graph->size = size;
+        bumpVersion(graph);
+    }
+}
+
+// Forget what changed so far; called by whoever consumed the changes
+void RDFGraph_clearChanges(RDFGraph *graph)
+{
+    for (int p = 0; p < graph->pageCount; p++) {
+        graph->pages[p]->dirty = 0;
+    }
+    graph->reordered = 0;
+}
+
+// Non-zero if the term's text is str[0..len)
+int RDFGraph_termEquals(const RDFGraph *graph, RDFTermId id, const char *str, size_t len)
+{
+    const RDFTerm *term = &graph->terms[id];
+    size_t skip = prefixLength(term->prefix);
+    return len == skip + term->length
+        && memcmp(str, RDFGraph_termPrefix(graph, id), skip) == 0
+        && memcmp(str + skip, term->text, term->length) == 0;
+}
+
+// Copy the term's text to out[0..size), NUL-terminated and truncated if
+// need be; returns its full length like snprintf()
+size_t RDFGraph_copyTerm(const RDFGraph *graph, RDFTermId id, char *out, size_t size)
+{
+    const RDFTerm *term = &graph->terms[id];
+    size_t skip = prefixLength(term->prefix);
+    size_t len = skip + term->length;
+    if (size == 0) return len;
+
+    size_t n = len < size - 1 ? len : size - 1;
+    size_t head = n < skip ? n : skip;
+    memcpy(out, RDFGraph_termPrefix(graph, id), head);
+    memcpy(out + head, term->text, n - head);
+    out[n] = '\0';
+    return len;
+}
+
+// Byte order of a and b, each followed by end; end is '>' for IRIs, which
+// N-Quads closes with it, and 0 (the end of the text) otherwise
+static int compareBytes(const char *a, size_t lenA, const char *b, size_t lenB, char end)
+{
+    int cmp = memcmp(a, b, lenA < lenB ? lenA : lenB);
+    if (cmp != 0 || lenA == lenB) return cmp;
+    if (end == 0) return (lenA > lenB) - (lenA < lenB);
+    uint8_t next = lenA < lenB ? (uint8_t)b[lenA] : (uint8_t)a[lenB];
+    if (next == (uint8_t)end) return (lenA > lenB) - (lenA < lenB);
+    return (lenA < lenB) == ((uint8_t)end < next) ? -1 : 1;
+}
+
+// Byte order of two IRIs across the prefix/suffix boundary
+static int compareSplit(const RDFGraph *graph, RDFTermId a, RDFTermId b)
+{
+    const char *partA[2] = { RDFGraph_termPrefix(graph, a), graph->terms[a].text };
+    const char *partB[2] = { RDFGraph_termPrefix(graph, b), graph->terms[b].text };
+    size_t lenA[2] = { prefixLength(graph->terms[a].prefix), graph->terms[a].length };
+    size_t lenB[2] = { prefixLength(graph->terms[b].prefix), graph->terms[b].length };
+    int ia = 0, ib = 0;
+    size_t oa = 0, ob = 0;
+    for (;;) {
+        while (ia < 2 && oa == lenA[ia]) { ia++; oa = 0; }
+        while (ib < 2 && ob == lenB[ib]) { ib++; ob = 0; }
+        if (ia == 2 || ib == 2) {
+            const char *rest = ia == 2 ? partB[ib] + ob : partA[ia] + oa;
+            return compareBytes(rest, ia == 2 ? 0 : 1, rest, ib == 2 ? 0 : 1, '>');
+        }
+
+        size_t n = lenA[ia] - oa < lenB[ib] - ob ? lenA[ia] - oa : lenB[ib] - ob;
+        int cmp = memcmp(partA[ia] + oa, partB[ib] + ob, n);
+        if (cmp != 0) return cmp;
+        oa += n;
+        ob += n;
+    }
+}
+
+// Order of the first character N-Quads writes for each kind of term:
+// '"' for literals, '<' for IRIs, '_' for blank nodes
+static const uint8_t kindOrder[] = {
+    [RDF_TERM_IRI] = 1,
+    [RDF_TERM_BLANK] = 2,
+    [RDF_TERM_LITERAL] = 0,
+    [RDF_TERM_TYPED_LITERAL] = 0,
+    [RDF_TERM_LANG_LITERAL] = 0,
+};
+
+// Code point order of two interned terms as N-Quads writes them, the
+// order canonical N-Quads lines are sorted in. Terms with the same prefix
+// compare on their suffixes, and two different prefixes mostly decide
+// the order by themselves.
+int RDFGraph_compareTerms(const void *ctx, RDFTermId a, RDFTermId b)
+{
+    const RDFGraph *graph = (const RDFGraph *)ctx;
+    const RDFTerm *termA = &graph->terms[a];
+    const RDFTerm *termB = &graph->terms[b];
+    if (kindOrder[termA->kind] != kindOrder[termB->kind]) {
+        return kindOrder[termA->kind] < kindOrder[termB->kind] ? -1 : 1;
+    }
+    char end = termA->kind == RDF_TERM_IRI ? '>' : 0;
+    if (termA->prefix == termB->prefix) {
+        return compareBytes(termA->text, termA->length, termB->text, termB->length, end);
+    }
+    if (termA->prefix != RDF_VOCAB_NO_PREFIX && termB->prefix != RDF_VOCAB_NO_PREFIX
+        && RDFVocab_prefixOrder[termA->prefix][termB->prefix] != 0) {
+        return RDFVocab_prefixOrder[termA->prefix][termB->prefix];
+    }
+    return compareSplit(graph, a, b);
+}
+
+// Bottom-up merge sort of term ids, O(T log T) comparisons
+static void sortTermIds(RDFTermCompare compare, const void *ctx, RDFTermId *ids, RDFTermId *tmp, int count)
+{
+    for (int width = 1; width < count; width *= 2) {
+        for (int lo = 0; lo < count; lo += 2 * width) {
+            int mid = lo + width < count ? lo + width : count;
+            int hi = lo + 2 * width < count ? lo + 2 * width : count;
+            int i = lo, j = mid, k = lo;
+            while (i < mid && j < hi) {
+                tmp[k++] = compare(ctx, ids[j], ids[i]) < 0 ? ids[j++] : ids[i++];
+            }
+            while (i < mid) tmp[k++] = ids[i++];
+            while (j < hi) tmp[k++] = ids[j++];
+        }
+        memcpy(ids, tmp, (size_t)count * sizeof(RDFTermId));
+    }
+}
+
+// LSD radix sort, 8 bits per pass; passes whose digit is constant are
+// skipped. Returns whichever of the two buffers holds the sorted keys.
+uint64_t *RDFGraph_radixSort(uint64_t *keys, uint64_t *buf, int count, int keyBits)
+{
+    for (int shift = 0; shift < keyBits; shift += 8) {
+        uint32_t histogram[256] = {0};
+        for (int i = 0; i < count; i++) {
+            histogram[(keys[i] >> shift) & 0xFF]++;
+        }
+        if (histogram[keys[0] >> shift & 0xFF] == (uint32_t)count) {
+            continue;
+        }
+        uint32_t offset = 0;
+        for (int d = 0; d < 256; d++) {
+            uint32_t c = histogram[d];
+            histogram[d] = offset;
+            offset += c;
+        }
+        for (int i = 0; i < count; i++) {
+            buf[histogram[(keys[i] >> shift) & 0xFF]++] = keys[i];
+        }
+        uint64_t *swap = keys;
+        keys = buf;
+        buf = swap;
+    }
+    return keys;
+}
+
+static int bitsFor(int values)
+{
+    int bits = 1;
+    while (bits < 32 && (1L << bits) < values) bits++;
+    return bits;
+}
+
+// Rank every term once under compare, so that a quad packs into a single
+// integer key. Returns 0 if the ranks do not fit scratch or a key.
+int RDFGraph_rankTerms(RDFTermRanks *ranks, int termCount, RDFTermCompare compare, const void *ctx, RDFArena *scratch)
+{
+    ranks->bits = bitsFor(termCount + 1);
+    if (4 * ranks->bits > 64) return 0;
+
+    size_t count = (size_t)termCount + 1;
+    RDFTermId *ids = (RDFTermId *)RDFArena_alloc(scratch, count * sizeof(RDFTermId), sizeof(RDFTermId));
+    RDFTermId *tmp = (RDFTermId *)RDFArena_alloc(scratch, count * sizeof(RDFTermId), sizeof(RDFTermId));
+    if (!ids || !tmp) return 0;
+
+    // ids[] maps rank -> term, tmp[] becomes term -> rank
+    ids[0] = RDF_NO_TERM;
+    for (int i = 0; i < termCount; i++) ids[i + 1] = (RDFTermId)i;
+    sortTermIds(compare, ctx, ids + 1, tmp, termCount);
+    for (int i = 1; i <= termCount; i++) tmp[ids[i]] = (RDFTermId)i;
+    ranks->termOf = ids;
+    ranks->rankOf = tmp;
+    return 1;
+}
+
+// Sort quads on packed (subject, predicate, object, graph) rank keys. Terms
+// are ranked once, after which a quad is a single integer and the sort
+// never compares terms again.
+static int sortByRankKeys(RDFTriple *quads, int count, int termCount, RDFTermCompare compare, const void *ctx, RDFArena *scratch)
+{
+    RDFTermRanks ranks;
+    if (!RDFGraph_rankTerms(&ranks, termCount, compare, ctx, scratch)) return 0;
+    uint64_t *keys = (uint64_t *)RDFArena_alloc(scratch, (size_t)count * sizeof(uint64_t), sizeof(uint64_t));
+    uint64_t *buf = (uint64_t *)RDFArena_alloc(scratch, (size_t)count * sizeof(uint64_t), sizeof(uint64_t));
+    if (!keys || !buf) return 0;
+
+    for (int i = 0; i < count; i++) {
+        const RDFTriple *q = &quads[i];
+        keys[i] = RDFTermRanks_key(&ranks, q->subject, q->predicate, q->object, q->graph);
+    }
+
+    const uint64_t *sorted = RDFGraph_radixSort(keys, buf, count, 4 * ranks.bits);
+
+    int bits = ranks.bits;
+    uint64_t mask = ((uint64_t)1 << bits) - 1;
+    for (int i = 0; i < count; i++) {
+        uint64_t key = sorted[i];
+        quads[i].subject = ranks.termOf[(key >> (3 * bits)) & mask];
+        quads[i].predicate = ranks.termOf[(key >> (2 * bits)) & mask];
+        quads[i].object = ranks.termOf[(key >> bits) & mask];
+        quads[i].graph = ranks.termOf[key & mask];
+    }
+    return 1;
+}
+
+// qsort() has no context argument, the fallback sort is not reentrant
+static RDFTermCompare sortCompare;
+static const void *sortContext;
+
+static int compareGraphNames(RDFTermCompare compare, const void *ctx, RDFTermId a, RDFTermId b)
+{
+    if (a == b) return 0;
+    if (a == RDF_NO_TERM) return -1;
+    if (b == RDF_NO_TERM) return 1;
+    return compare(ctx, a, b);
+}
+
+static int compareQuads(RDFTermCompare compare, const void *ctx, const RDFTriple *a, const RDFTriple *b)
+{
+    int subjectCmp = compare(ctx, a->subject, b->subject);
+    if (subjectCmp != 0) return subjectCmp;
+    int predicateCmp = compare(ctx, a->predicate, b->predicate);
+    if (predicateCmp != 0) return predicateCmp;
+    int objectCmp = compare(ctx, a->object, b->object);
+    if (objectCmp != 0) return objectCmp;
+    return compareGraphNames(compare, ctx, a->graph, b->graph);
+}
+
+static int compareTriples(const void *a, const void *b)
+{
+    return compareQuads(sortCompare, sortContext, (const RDFTriple *)a, (const RDFTriple *)b);
+}
+
+// Sort quads by (subject, predicate, object, graph) under the given term
+// order, optionally dropping duplicates; returns the resulting count.
+// Scratch space for the radix sort is taken from the top of scratch and
+// released again; when it does not fit, qsort() is used instead, so the
+// sort itself never fails.
+int RDFGraph_sortQuads(RDFTriple *quads, int count, int termCount, RDFTermCompare compare, const void *ctx, RDFArena *scratch, int unique)
+{
+    if (count < 2) return count;
+
+    size_t mark = scratch->used;
+    int sorted = sortByRankKeys(quads, count, termCount, compare, ctx, scratch);
+    RDFArena_release(scratch, mark);
+    if (!sorted) {
+        sortCompare = compare;
+        sortContext = ctx;
+        qsort(quads, (size_t)count, sizeof(RDFTriple), compareTriples);
+        sortCompare = NULL;
+        sortContext = NULL;
+    }
+
+    if (!unique) return count;
+    int kept = 1;
+    for (int i = 1; i < count; i++) {
+        if (memcmp(&quads[i], &quads[kept - 1], sizeof(RDFTriple)) != 0) {
+            quads[kept++] = quads[i];
+        }
+    }
+    return kept;
+}
+
+// The graph's triples sorted in place on rank keys, as sortByRankKeys()
+// sorts an array
+static int sortPagesByRankKeys(RDFGraph *graph, RDFArena *scratch)
+{
+    int count = graph->size;
+    RDFTermRanks ranks;
+    if (!RDFGraph_rankTerms(&ranks, graph->termCount, RDFGraph_compareTerms, graph, scratch)) return 0;
+    uint64_t *keys = (uint64_t *)RDFArena_alloc(scratch, (size_t)count * sizeof(uint64_t), sizeof(uint64_t));
+    uint64_t *buf = (uint64_t *)RDFArena_alloc(scratch, (size_t)count * sizeof(uint64_t), sizeof(uint64_t));
+    if (!keys || !buf) return 0;
+
+    for (int i = 0; i < count; i++) {
+        const RDFTriple *q = RDFGraph_triple(graph, i);
+        keys[i] = RDFTermRanks_key(&ranks, q->subject, q->predicate, q->object, q->graph);
+    }
+    const uint64_t *sorted = RDFGraph_radixSort(keys, buf, count, 4 * ranks.bits);
+
+    int bits = ranks.bits;
+    uint64_t mask = ((uint64_t)1 << bits) - 1;
+    for (int i = 0; i < count; i++) {
+        uint64_t key = sorted[i];
+        RDFTriple *q = tripleAt(graph, i);
+        q->subject = ranks.termOf[(key >> (3 * bits)) & mask];
+        q->predicate = ranks.termOf[(key >> (2 * bits)) & mask];
+        q->object = ranks.termOf[(key >> bits) & mask];
+        q->graph = ranks.termOf[key & mask];
+    }
+    return 1;
+}
+
+static void siftDown(RDFGraph *graph, int root, int count)
+{
+    RDFTriple value = *tripleAt(graph, root);
+    for (;;) {
+        int child = 2 * root + 1;
+        if (child >= count) break;
+        if (child + 1 < count
+            && compareQuads(RDFGraph_compareTerms, graph, tripleAt(graph, child), tripleAt(graph, child + 1)) < 0) {
+            child++;
+        }
+        if (compareQuads(RDFGraph_compareTerms, graph, &value, tripleAt(graph, child)) >= 0) break;
+        *tripleAt(graph, root) = *tripleAt(graph, child);
+        root = child;
+    }
+    *tripleAt(graph, root) = value;
+}
+
+// Heap sort across the pages, for when the arena has no room for keys
+static void heapSortPages(RDFGraph *graph)
+{
+    int count = graph->size;
+    for (int i = count / 2 - 1; i >= 0; i--) siftDown(graph, i, count);
+    for (int end = count - 1; end > 0; end--) {
+        RDFTriple top = *tripleAt(graph, 0);
+        *tripleAt(graph, 0) = *tripleAt(graph, end);
+        *tripleAt(graph, end) = top;
+        siftDown(graph, 0, end);
+    }
+}
+
+// Canonicalize the RDF graph: triples end up in (subject, predicate,
+// object) order of their N-Quads form. Blank node labels are taken as they are, graphs
+// that contain blank nodes need RDFCanon_run() instead.
+void RDFGraph_canonicalize(RDFGraph *graph)
+{
+    if (graph->size > 1) {
+        size_t mark = graph->arena.used;
+        int sorted = sortPagesByRankKeys(graph, &graph->arena);
+        RDFArena_release(&graph->arena, mark);
+        if (!sorted) heapSortPages(graph);
+    }
+    graph->reordered = 1;
+    bumpVersion(graph);
+}
+
+// Keep the quads keep() returns non-zero for, in their current order.
+// keep() may rewrite the quad it is given. Terms are not reclaimed.
+void RDFGraph_filter(RDFGraph *graph, RDFQuadFilter keep, void *ctx)
+{
+    int kept = 0;
+    for (int i = 0; i < graph->size; i++) {
+        RDFTriple quad = *tripleAt(graph, i);
+        if (keep(ctx, &quad)) {
+            *tripleAt(graph, kept++) = quad;
+        }
+    }
+    graph->size = kept;
+    graph->reordered = 1;
+    bumpVersion(graph);
+}
+
+// Drop every triple and term in O(1); the arena itself belongs to the caller
+void RDFGraph_free(RDFGraph *graph)
+{
+    RDFGraph_init(graph, graph->arena.base, graph->arena.capacity);
+}
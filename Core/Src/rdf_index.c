@@ -0,0 +1,108 @@
+#include "rdf_index.h"
+
+#include <string.h>
+
+// Components (0 subject, 1 predicate, 2 object) in the order each index
+// sorts by
+static const uint8_t sortKeys[RDF_INDEX_COUNT][3] = {
+    [RDF_INDEX_SPO] = { 0, 1, 2 },
+    [RDF_INDEX_POS] = { 1, 2, 0 },
+    [RDF_INDEX_OSP] = { 2, 0, 1 }
+};
+
+// Index serving a pattern, by its bound components (bit 0 subject, bit 1
+// predicate, bit 2 object): they have to be the index's leading keys
+static const uint8_t orderFor[8] = {
+    RDF_INDEX_SPO, RDF_INDEX_SPO, RDF_INDEX_POS, RDF_INDEX_SPO,
+    RDF_INDEX_OSP, RDF_INDEX_OSP, RDF_INDEX_POS, RDF_INDEX_SPO
+};
+
+static RDFTermId component(const RDFTriple *triple, int key)
+{
+    return key == 0 ? triple->subject : key == 1 ? triple->predicate : triple->object;
+}
+
+void RDFIndex_init(RDFIndex *index, const RDFGraph *graph)
+{
+    index->graph = graph;
+    index->built = 0;
+}
+
+// LSD counting sort of the triple positions, one stable pass per key with
+// the last key first. Three passes starting from tmp end in order[].
+static void build(RDFIndex *index, int order)
+{
+    const RDFGraph *graph = index->graph;
+    int count = graph->size;
+    RDFTriplePos *from = index->tmp;
+    RDFTriplePos *to = index->order[order];
+
+    for (int i = 0; i < count; i++) from[i] = (RDFTriplePos)i;
+    for (int pass = 2; pass >= 0; pass--) {
+        int key = sortKeys[order][pass];
+        RDFTriplePos *counts = index->counts;
+        memset(counts, 0, (size_t)(graph->termCount + 1) * sizeof(RDFTriplePos));
+        for (int i = 0; i < count; i++) {
+            counts[component(RDFGraph_triple(graph, from[i]), key) + 1]++;
+        }
+        for (int t = 0; t < graph->termCount; t++) {
+            counts[t + 1] = (RDFTriplePos)(counts[t + 1] + counts[t]);
+        }
+        for (int i = 0; i < count; i++) {
+            to[counts[component(RDFGraph_triple(graph, from[i]), key)]++] = from[i];
+        }
+        RDFTriplePos *swap = from;
+        from = to;
+        to = swap;
+    }
+
+    index->version[order] = graph->version;
+    index->built |= (uint8_t)(1u << order);
+}
+
+// Order of a triple against the bound leading keys of a pattern
+static int comparePrefix(const RDFTriple *triple, const uint8_t *keys, const RDFTermId *pattern, int bound)
+{
+    for (int k = 0; k < bound; k++) {
+        RDFTermId id = component(triple, keys[k]);
+        if (id != pattern[keys[k]]) return id < pattern[keys[k]] ? -1 : 1;
+    }
+    return 0;
+}
+
+RDFTripleRange RDFIndex_match(RDFIndex *index, RDFTermId subject, RDFTermId predicate, RDFTermId object)
+{
+    const RDFGraph *graph = index->graph;
+    const RDFTermId pattern[3] = { subject, predicate, object };
+    int mask = (subject != RDF_NO_TERM) | (predicate != RDF_NO_TERM) << 1 | (object != RDF_NO_TERM) << 2;
+    int order = orderFor[mask];
+    int bound = (mask & 1) + (mask >> 1 & 1) + (mask >> 2);
+
+    if (graph->size > MAX_TRIPLES) {
+        RDFTripleRange none = { NULL, -1 };
+        return none;
+    }
+    if (!(index->built & (1u << order)) || index->version[order] != graph->version) {
+        build(index, order);
+    }
+
+    // Binary search for both ends of the range of matching triples
+    const RDFTriplePos *pos = index->order[order];
+    const uint8_t *keys = sortKeys[order];
+    int lo = 0, hi = graph->size;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (comparePrefix(RDFGraph_triple(graph, pos[mid]), keys, pattern, bound) < 0) lo = mid + 1;
+        else hi = mid;
+    }
+    int end = lo;
+    hi = graph->size;
+    while (end < hi) {
+        int mid = end + (hi - end) / 2;
+        if (comparePrefix(RDFGraph_triple(graph, pos[mid]), keys, pattern, bound) <= 0) end = mid + 1;
+        else hi = mid;
+    }
+
+    RDFTripleRange range = { pos + lo, end - lo };
+    return range;
+}
@@ -0,0 +1,317 @@
+/* Generated by Tools/gen_vocab.py from Tools/vocab.txt, do not edit. */
+
+#include "rdf_vocab.h"
+
+#include <string.h>
+
+const RDFVocabPrefix RDFVocab_prefixes[RDF_VOCAB_PREFIX_COUNT] = {
+    { "http://www.w3.org/1999/02/22-rdf-syntax-ns#", 43 },
+    { "http://purl.org/dc/terms/", 25 },
+    { "http://www.w3.org/2001/XMLSchema#", 33 },
+    { "https://w3id.org/security#", 26 },
+    { "https://www.w3.org/2018/credentials#", 36 },
+    { "http://schema.org/", 18 },
+    { "did:example:", 12 },
+    { "did:key:", 8 },
+};
+
+const int8_t RDFVocab_prefixOrder[RDF_VOCAB_PREFIX_COUNT][RDF_VOCAB_PREFIX_COUNT] = {
+    {  0,  1, -1, -1, -1,  1,  1,  1 },
+    { -1,  0, -1, -1, -1, -1,  1,  1 },
+    {  1,  1,  0, -1, -1,  1,  1,  1 },
+    {  1,  1,  1,  0, -1,  1,  1,  1 },
+    {  1,  1,  1,  1,  0,  1,  1,  1 },
+    { -1,  1, -1, -1, -1,  0,  1,  1 },
+    { -1, -1, -1, -1, -1, -1,  0, -1 },
+    { -1, -1, -1, -1, -1, -1,  1,  0 },
+};
+
+// Prefix trie: a node's label is the text on the edge leading to it;
+// 0 links to nothing, since the root is nobody's child or sibling
+typedef struct {
+    const char *label;
+    uint8_t labelLength;
+    uint8_t child;
+    uint8_t sibling;
+    uint8_t prefix;
+} TrieNode;
+
+static const TrieNode prefixTrie[14] = {
+    { "", 0, 1, 0, RDF_VOCAB_NO_PREFIX },
+    { "did:", 4, 2, 4, RDF_VOCAB_NO_PREFIX },
+    { "example:", 8, 0, 3, 6 },
+    { "key:", 4, 0, 0, 7 },
+    { "http", 4, 5, 0, RDF_VOCAB_NO_PREFIX },
+    { "://", 3, 6, 11, RDF_VOCAB_NO_PREFIX },
+    { "purl.org/dc/terms/", 18, 0, 7, 1 },
+    { "schema.org/", 11, 0, 8, 5 },
+    { "www.w3.org/", 11, 9, 0, RDF_VOCAB_NO_PREFIX },
+    { "1999/02/22-rdf-syntax-ns#", 25, 0, 10, 0 },
+    { "2001/XMLSchema#", 15, 0, 0, 2 },
+    { "s://w", 5, 12, 0, RDF_VOCAB_NO_PREFIX },
+    { "3id.org/security#", 17, 0, 13, 3 },
+    { "ww.w3.org/2018/credentials#", 27, 0, 0, 4 },
+};
+
+const RDFVocabEntry RDFVocab_terms[RDF_VOCAB_COUNT] = {
+    [RDF_VOCAB_RDF_TYPE] = { RDF_IRI_RDF_TYPE, 47, 4, 0 },
+    [RDF_VOCAB_DC_CREATED] = { RDF_IRI_DC_CREATED, 32, 7, 1 },
+    [RDF_VOCAB_XSD_DATE_TIME] = { RDF_IRI_XSD_DATE_TIME, 41, 8, 2 },
+    [RDF_VOCAB_XSD_INTEGER] = { RDF_IRI_XSD_INTEGER, 40, 7, 2 },
+    [RDF_VOCAB_XSD_DOUBLE] = { RDF_IRI_XSD_DOUBLE, 39, 6, 2 },
+    [RDF_VOCAB_XSD_BOOLEAN] = { RDF_IRI_XSD_BOOLEAN, 40, 7, 2 },
+    [RDF_VOCAB_SEC_ECDSA_KOBLITZ_SIGNATURE2016] = { RDF_IRI_SEC_ECDSA_KOBLITZ_SIGNATURE2016, 51, 25, 3 },
+    [RDF_VOCAB_SEC_ECDSA_SECP256K1_SIGNATURE2019] = { RDF_IRI_SEC_ECDSA_SECP256K1_SIGNATURE2019, 53, 27, 3 },
+    [RDF_VOCAB_SEC_ECDSA_SECP256K1_VERIFICATION_KEY2019] = { RDF_IRI_SEC_ECDSA_SECP256K1_VERIFICATION_KEY2019, 59, 33, 3 },
+    [RDF_VOCAB_SEC_ED25519_SIGNATURE2018] = { RDF_IRI_SEC_ED25519_SIGNATURE2018, 46, 20, 3 },
+    [RDF_VOCAB_SEC_ED25519_VERIFICATION_KEY2018] = { RDF_IRI_SEC_ED25519_VERIFICATION_KEY2018, 52, 26, 3 },
+    [RDF_VOCAB_SEC_ENCRYPTED_MESSAGE] = { RDF_IRI_SEC_ENCRYPTED_MESSAGE, 42, 16, 3 },
+    [RDF_VOCAB_SEC_GRAPH_SIGNATURE2012] = { RDF_IRI_SEC_GRAPH_SIGNATURE2012, 44, 18, 3 },
+    [RDF_VOCAB_SEC_LINKED_DATA_SIGNATURE2015] = { RDF_IRI_SEC_LINKED_DATA_SIGNATURE2015, 49, 23, 3 },
+    [RDF_VOCAB_SEC_LINKED_DATA_SIGNATURE2016] = { RDF_IRI_SEC_LINKED_DATA_SIGNATURE2016, 49, 23, 3 },
+    [RDF_VOCAB_SEC_RSA_SIGNATURE2018] = { RDF_IRI_SEC_RSA_SIGNATURE2018, 42, 16, 3 },
+    [RDF_VOCAB_SEC_RSA_VERIFICATION_KEY2018] = { RDF_IRI_SEC_RSA_VERIFICATION_KEY2018, 48, 22, 3 },
+    [RDF_VOCAB_SEC_SCHNORR_SECP256K1_SIGNATURE2019] = { RDF_IRI_SEC_SCHNORR_SECP256K1_SIGNATURE2019, 55, 29, 3 },
+    [RDF_VOCAB_SEC_SCHNORR_SECP256K1_VERIFICATION_KEY2019] = { RDF_IRI_SEC_SCHNORR_SECP256K1_VERIFICATION_KEY2019, 61, 35, 3 },
+    [RDF_VOCAB_SEC_CRYPTOGRAPHIC_KEY] = { RDF_IRI_SEC_CRYPTOGRAPHIC_KEY, 42, 16, 3 },
+    [RDF_VOCAB_SEC_ALLOWED_ACTION] = { RDF_IRI_SEC_ALLOWED_ACTION, 39, 13, 3 },
+    [RDF_VOCAB_SEC_ASSERTION_METHOD] = { RDF_IRI_SEC_ASSERTION_METHOD, 41, 15, 3 },
+    [RDF_VOCAB_SEC_AUTHENTICATION] = { RDF_IRI_SEC_AUTHENTICATION, 40, 14, 3 },
+    [RDF_VOCAB_SEC_AUTHENTICATION_TAG] = { RDF_IRI_SEC_AUTHENTICATION_TAG, 43, 17, 3 },
+    [RDF_VOCAB_SEC_CANONICALIZATION_ALGORITHM] = { RDF_IRI_SEC_CANONICALIZATION_ALGORITHM, 51, 25, 3 },
+    [RDF_VOCAB_SEC_CAPABILITY] = { RDF_IRI_SEC_CAPABILITY, 36, 10, 3 },
+    [RDF_VOCAB_SEC_CAPABILITY_ACTION] = { RDF_IRI_SEC_CAPABILITY_ACTION, 42, 16, 3 },
+    [RDF_VOCAB_SEC_CAPABILITY_CHAIN] = { RDF_IRI_SEC_CAPABILITY_CHAIN, 41, 15, 3 },
+    [RDF_VOCAB_SEC_CAPABILITY_DELEGATION] = { RDF_IRI_SEC_CAPABILITY_DELEGATION, 46, 20, 3 },
+    [RDF_VOCAB_SEC_CAPABILITY_INVOCATION] = { RDF_IRI_SEC_CAPABILITY_INVOCATION, 46, 20, 3 },
+    [RDF_VOCAB_SEC_CAVEAT] = { RDF_IRI_SEC_CAVEAT, 32, 6, 3 },
+    [RDF_VOCAB_SEC_CHALLENGE] = { RDF_IRI_SEC_CHALLENGE, 35, 9, 3 },
+    [RDF_VOCAB_SEC_CIPHER_ALGORITHM] = { RDF_IRI_SEC_CIPHER_ALGORITHM, 41, 15, 3 },
+    [RDF_VOCAB_SEC_CIPHER_DATA] = { RDF_IRI_SEC_CIPHER_DATA, 36, 10, 3 },
+    [RDF_VOCAB_SEC_CIPHER_KEY] = { RDF_IRI_SEC_CIPHER_KEY, 35, 9, 3 },
+    [RDF_VOCAB_SEC_CIPHERTEXT] = { RDF_IRI_SEC_CIPHERTEXT, 36, 10, 3 },
+    [RDF_VOCAB_SEC_CONTROLLER] = { RDF_IRI_SEC_CONTROLLER, 36, 10, 3 },
+    [RDF_VOCAB_SEC_CREATOR] = { RDF_IRI_SEC_CREATOR, 33, 7, 3 },
+    [RDF_VOCAB_SEC_DELEGATOR] = { RDF_IRI_SEC_DELEGATOR, 35, 9, 3 },
+    [RDF_VOCAB_SEC_DIGEST_ALGORITHM] = { RDF_IRI_SEC_DIGEST_ALGORITHM, 41, 15, 3 },
+    [RDF_VOCAB_SEC_DIGEST_VALUE] = { RDF_IRI_SEC_DIGEST_VALUE, 37, 11, 3 },
+    [RDF_VOCAB_SEC_DOMAIN] = { RDF_IRI_SEC_DOMAIN, 32, 6, 3 },
+    [RDF_VOCAB_SEC_ENCRYPTION_KEY] = { RDF_IRI_SEC_ENCRYPTION_KEY, 39, 13, 3 },
+    [RDF_VOCAB_SEC_EXPIRATION] = { RDF_IRI_SEC_EXPIRATION, 36, 10, 3 },
+    [RDF_VOCAB_SEC_EXPIRES] = { RDF_IRI_SEC_EXPIRES, 33, 7, 3 },
+    [RDF_VOCAB_SEC_INITIALIZATION_VECTOR] = { RDF_IRI_SEC_INITIALIZATION_VECTOR, 46, 20, 3 },
+    [RDF_VOCAB_SEC_INVOCATION_TARGET] = { RDF_IRI_SEC_INVOCATION_TARGET, 42, 16, 3 },
+    [RDF_VOCAB_SEC_INVOKER] = { RDF_IRI_SEC_INVOKER, 33, 7, 3 },
+    [RDF_VOCAB_SEC_ITERATION_COUNT] = { RDF_IRI_SEC_ITERATION_COUNT, 40, 14, 3 },
+    [RDF_VOCAB_SEC_JWS] = { RDF_IRI_SEC_JWS, 29, 3, 3 },
+    [RDF_VOCAB_SEC_KEY_AGREEMENT] = { RDF_IRI_SEC_KEY_AGREEMENT, 38, 12, 3 },
+    [RDF_VOCAB_SEC_NONCE] = { RDF_IRI_SEC_NONCE, 31, 5, 3 },
+    [RDF_VOCAB_SEC_NORMALIZATION_ALGORITHM] = { RDF_IRI_SEC_NORMALIZATION_ALGORITHM, 48, 22, 3 },
+    [RDF_VOCAB_SEC_OWNER] = { RDF_IRI_SEC_OWNER, 31, 5, 3 },
+    [RDF_VOCAB_SEC_PARENT_CAPABILITY] = { RDF_IRI_SEC_PARENT_CAPABILITY, 42, 16, 3 },
+    [RDF_VOCAB_SEC_PASSWORD] = { RDF_IRI_SEC_PASSWORD, 34, 8, 3 },
+    [RDF_VOCAB_SEC_PLAINTEXT] = { RDF_IRI_SEC_PLAINTEXT, 35, 9, 3 },
+    [RDF_VOCAB_SEC_PRIVATE_KEY] = { RDF_IRI_SEC_PRIVATE_KEY, 36, 10, 3 },
+    [RDF_VOCAB_SEC_PRIVATE_KEY_PEM] = { RDF_IRI_SEC_PRIVATE_KEY_PEM, 39, 13, 3 },
+    [RDF_VOCAB_SEC_PROOF] = { RDF_IRI_SEC_PROOF, 31, 5, 3 },
+    [RDF_VOCAB_SEC_PROOF_PURPOSE] = { RDF_IRI_SEC_PROOF_PURPOSE, 38, 12, 3 },
+    [RDF_VOCAB_SEC_PROOF_VALUE] = { RDF_IRI_SEC_PROOF_VALUE, 36, 10, 3 },
+    [RDF_VOCAB_SEC_PUBLIC_KEY] = { RDF_IRI_SEC_PUBLIC_KEY, 35, 9, 3 },
+    [RDF_VOCAB_SEC_PUBLIC_KEY_BASE58] = { RDF_IRI_SEC_PUBLIC_KEY_BASE58, 41, 15, 3 },
+    [RDF_VOCAB_SEC_PUBLIC_KEY_PEM] = { RDF_IRI_SEC_PUBLIC_KEY_PEM, 38, 12, 3 },
+    [RDF_VOCAB_SEC_PUBLIC_KEY_WIF] = { RDF_IRI_SEC_PUBLIC_KEY_WIF, 38, 12, 3 },
+    [RDF_VOCAB_SEC_REVOKED] = { RDF_IRI_SEC_REVOKED, 33, 7, 3 },
+    [RDF_VOCAB_SEC_SALT] = { RDF_IRI_SEC_SALT, 30, 4, 3 },
+    [RDF_VOCAB_SEC_SIGNATURE] = { RDF_IRI_SEC_SIGNATURE, 35, 9, 3 },
+    [RDF_VOCAB_SEC_SIGNATURE_ALGORITHM] = { RDF_IRI_SEC_SIGNATURE_ALGORITHM, 44, 18, 3 },
+    [RDF_VOCAB_SEC_SIGNATURE_VALUE] = { RDF_IRI_SEC_SIGNATURE_VALUE, 40, 14, 3 },
+    [RDF_VOCAB_SEC_VERIFICATION_METHOD] = { RDF_IRI_SEC_VERIFICATION_METHOD, 44, 18, 3 },
+    [RDF_VOCAB_SEC_VERIFY_DATA] = { RDF_IRI_SEC_VERIFY_DATA, 36, 10, 3 },
+    [RDF_VOCAB_SEC_ECDSA_SIGNATURE2018] = { RDF_IRI_SEC_ECDSA_SIGNATURE2018, 44, 18, 3 },
+    [RDF_VOCAB_SEC_ED25519_SIGNATURE2020] = { RDF_IRI_SEC_ED25519_SIGNATURE2020, 46, 20, 3 },
+    [RDF_VOCAB_CRED_VERIFIABLE_CREDENTIAL] = { RDF_IRI_CRED_VERIFIABLE_CREDENTIAL, 56, 20, 4 },
+    [RDF_VOCAB_CRED_VERIFIABLE_PRESENTATION] = { RDF_IRI_CRED_VERIFIABLE_PRESENTATION, 58, 22, 4 },
+    [RDF_VOCAB_CRED_CREDENTIAL_SUBJECT] = { RDF_IRI_CRED_CREDENTIAL_SUBJECT, 53, 17, 4 },
+    [RDF_VOCAB_CRED_CREDENTIAL_STATUS] = { RDF_IRI_CRED_CREDENTIAL_STATUS, 52, 16, 4 },
+    [RDF_VOCAB_CRED_CREDENTIAL_SCHEMA] = { RDF_IRI_CRED_CREDENTIAL_SCHEMA, 52, 16, 4 },
+    [RDF_VOCAB_CRED_EVIDENCE] = { RDF_IRI_CRED_EVIDENCE, 44, 8, 4 },
+    [RDF_VOCAB_CRED_EXPIRATION_DATE] = { RDF_IRI_CRED_EXPIRATION_DATE, 50, 14, 4 },
+    [RDF_VOCAB_CRED_HOLDER] = { RDF_IRI_CRED_HOLDER, 42, 6, 4 },
+    [RDF_VOCAB_CRED_ISSUANCE_DATE] = { RDF_IRI_CRED_ISSUANCE_DATE, 48, 12, 4 },
+    [RDF_VOCAB_CRED_ISSUER] = { RDF_IRI_CRED_ISSUER, 42, 6, 4 },
+    [RDF_VOCAB_CRED_REFRESH_SERVICE] = { RDF_IRI_CRED_REFRESH_SERVICE, 50, 14, 4 },
+    [RDF_VOCAB_CRED_TERMS_OF_USE] = { RDF_IRI_CRED_TERMS_OF_USE, 46, 10, 4 },
+    [RDF_VOCAB_CRED_VERIFIABLE_CREDENTIAL_PROPERTY] = { RDF_IRI_CRED_VERIFIABLE_CREDENTIAL_PROPERTY, 56, 20, 4 },
+    [RDF_VOCAB_SCHEMA_PERSON] = { RDF_IRI_SCHEMA_PERSON, 24, 6, 5 },
+    [RDF_VOCAB_SCHEMA_ORGANIZATION] = { RDF_IRI_SCHEMA_ORGANIZATION, 30, 12, 5 },
+    [RDF_VOCAB_SCHEMA_PLACE] = { RDF_IRI_SCHEMA_PLACE, 23, 5, 5 },
+    [RDF_VOCAB_SCHEMA_POSTAL_ADDRESS] = { RDF_IRI_SCHEMA_POSTAL_ADDRESS, 31, 13, 5 },
+    [RDF_VOCAB_SCHEMA_THING] = { RDF_IRI_SCHEMA_THING, 23, 5, 5 },
+    [RDF_VOCAB_SCHEMA_NAME] = { RDF_IRI_SCHEMA_NAME, 22, 4, 5 },
+    [RDF_VOCAB_SCHEMA_DESCRIPTION] = { RDF_IRI_SCHEMA_DESCRIPTION, 29, 11, 5 },
+    [RDF_VOCAB_SCHEMA_IDENTIFIER] = { RDF_IRI_SCHEMA_IDENTIFIER, 28, 10, 5 },
+    [RDF_VOCAB_SCHEMA_URL] = { RDF_IRI_SCHEMA_URL, 21, 3, 5 },
+    [RDF_VOCAB_SCHEMA_IMAGE] = { RDF_IRI_SCHEMA_IMAGE, 23, 5, 5 },
+    [RDF_VOCAB_SCHEMA_EMAIL] = { RDF_IRI_SCHEMA_EMAIL, 23, 5, 5 },
+    [RDF_VOCAB_SCHEMA_TELEPHONE] = { RDF_IRI_SCHEMA_TELEPHONE, 27, 9, 5 },
+    [RDF_VOCAB_SCHEMA_GIVEN_NAME] = { RDF_IRI_SCHEMA_GIVEN_NAME, 27, 9, 5 },
+    [RDF_VOCAB_SCHEMA_FAMILY_NAME] = { RDF_IRI_SCHEMA_FAMILY_NAME, 28, 10, 5 },
+    [RDF_VOCAB_SCHEMA_ADDITIONAL_NAME] = { RDF_IRI_SCHEMA_ADDITIONAL_NAME, 32, 14, 5 },
+    [RDF_VOCAB_SCHEMA_BIRTH_DATE] = { RDF_IRI_SCHEMA_BIRTH_DATE, 27, 9, 5 },
+    [RDF_VOCAB_SCHEMA_GENDER] = { RDF_IRI_SCHEMA_GENDER, 24, 6, 5 },
+    [RDF_VOCAB_SCHEMA_NATIONALITY] = { RDF_IRI_SCHEMA_NATIONALITY, 29, 11, 5 },
+    [RDF_VOCAB_SCHEMA_ADDRESS] = { RDF_IRI_SCHEMA_ADDRESS, 25, 7, 5 },
+    [RDF_VOCAB_SCHEMA_ADDRESS_COUNTRY] = { RDF_IRI_SCHEMA_ADDRESS_COUNTRY, 32, 14, 5 },
+    [RDF_VOCAB_SCHEMA_ADDRESS_LOCALITY] = { RDF_IRI_SCHEMA_ADDRESS_LOCALITY, 33, 15, 5 },
+    [RDF_VOCAB_SCHEMA_ADDRESS_REGION] = { RDF_IRI_SCHEMA_ADDRESS_REGION, 31, 13, 5 },
+    [RDF_VOCAB_SCHEMA_POSTAL_CODE] = { RDF_IRI_SCHEMA_POSTAL_CODE, 28, 10, 5 },
+    [RDF_VOCAB_SCHEMA_STREET_ADDRESS] = { RDF_IRI_SCHEMA_STREET_ADDRESS, 31, 13, 5 },
+    [RDF_VOCAB_SCHEMA_ALUMNI_OF] = { RDF_IRI_SCHEMA_ALUMNI_OF, 26, 8, 5 },
+    [RDF_VOCAB_SCHEMA_AFFILIATION] = { RDF_IRI_SCHEMA_AFFILIATION, 29, 11, 5 },
+    [RDF_VOCAB_SCHEMA_MEMBER_OF] = { RDF_IRI_SCHEMA_MEMBER_OF, 26, 8, 5 },
+    [RDF_VOCAB_SCHEMA_JOB_TITLE] = { RDF_IRI_SCHEMA_JOB_TITLE, 26, 8, 5 },
+    [RDF_VOCAB_SCHEMA_WORKS_FOR] = { RDF_IRI_SCHEMA_WORKS_FOR, 26, 8, 5 },
+    [RDF_VOCAB_SCHEMA_HAS_CREDENTIAL] = { RDF_IRI_SCHEMA_HAS_CREDENTIAL, 31, 13, 5 },
+    [RDF_VOCAB_SCHEMA_DATE_CREATED] = { RDF_IRI_SCHEMA_DATE_CREATED, 29, 11, 5 },
+    [RDF_VOCAB_SCHEMA_DATE_MODIFIED] = { RDF_IRI_SCHEMA_DATE_MODIFIED, 30, 12, 5 },
+    [RDF_VOCAB_SCHEMA_DATE_PUBLISHED] = { RDF_IRI_SCHEMA_DATE_PUBLISHED, 31, 13, 5 },
+    [RDF_VOCAB_SCHEMA_VALID_FROM] = { RDF_IRI_SCHEMA_VALID_FROM, 27, 9, 5 },
+    [RDF_VOCAB_SCHEMA_VALID_THROUGH] = { RDF_IRI_SCHEMA_VALID_THROUGH, 30, 12, 5 },
+};
+
+// Minimal perfect hashes (hash and displace): with h = vocabHash(key),
+// bucket h % 123 holds d; d < 0 places the key in slot -d - 1, otherwise
+// in slot vocabMix(h, d) % 123
+#define HASH_TAIL 20
+
+static const int16_t iriDisplacement[RDF_VOCAB_COUNT] = {
+    2, -123, 1, 0, -121, -120, 4, 1, 2, 3, -119, -115,
+    -110, 0, -101, 1, 0, -100, -96, 0, -95, 0, -91, 0,
+    1, -90, -89, 2, -87, 0, 0, -84, 0, -82, 0, 3,
+    -81, 2, 0, 1, 0, 8, 0, 0, 0, 4, 0, 0,
+    -79, -65, 15, 4, 10, 6, 0, -64, 0, 0, 0, 7,
+    9, 0, 1, 0, -63, 1, 0, 3, 0, -62, -61, 0,
+    -57, 1, 0, 0, -52, 2, 19, -51, -48, -46, 0, 1,
+    0, -45, -43, 5, 0, 0, -38, 2, -33, -32, -31, 0,
+    0, -30, -28, -25, 0, -23, -21, 0, 2, -19, 0, 0,
+    0, -16, 0, 0, 5, 0, 3, -12, -8, -7, 0, 0,
+    -3, 0, 0,
+};
+
+static const uint8_t iriSlots[RDF_VOCAB_COUNT] = {
+    19, 80, 13, 95, 38, 8, 32, 119, 79, 109, 68, 122,
+    72, 70, 117, 3, 110, 54, 65, 33, 16, 112, 104, 62,
+    116, 46, 96, 2, 21, 49, 106, 48, 0, 76, 47, 118,
+    84, 81, 74, 59, 25, 103, 121, 88, 100, 35, 44, 63,
+    98, 61, 11, 111, 69, 85, 114, 66, 60, 78, 41, 30,
+    14, 73, 31, 24, 75, 39, 10, 6, 91, 9, 108, 17,
+    22, 55, 64, 45, 42, 52, 94, 29, 83, 1, 20, 86,
+    23, 37, 43, 40, 57, 27, 51, 53, 71, 58, 97, 36,
+    67, 87, 102, 82, 120, 99, 26, 115, 7, 89, 5, 50,
+    90, 15, 34, 92, 93, 107, 113, 101, 4, 18, 12, 28,
+    56, 77, 105,
+};
+
+static const int16_t compactDisplacement[RDF_VOCAB_COUNT] = {
+    -123, -122, -120, -118, -110, 2, 3, 0, 0, -109, 2, 0,
+    -108, 0, 2, -106, 0, -105, 0, 2, -103, 0, 1, 0,
+    -100, -96, 0, -93, 1, -92, -90, -88, 1, -84, 0, 1,
+    -80, 4, 0, 4, 3, 4, -78, 1, -76, 0, 0, 0,
+    0, 0, 0, -75, 1, 3, 0, -70, 0, 0, 0, -68,
+    -60, 1, 0, -59, -56, -53, 0, 0, -52, -49, 1, -47,
+    -45, 0, 1, 0, 0, 0, -42, -41, 0, 1, 0, 1,
+    0, 0, 0, 0, 0, -40, -37, -35, -34, -33, 8, 1,
+    -31, -28, 4, 1, -27, 0, -23, 0, -18, 0, 0, -12,
+    1, 0, 0, 4, 0, -5, -4, 1, 9, 0, 11, 0,
+    -2, -1, 8,
+};
+
+static const uint8_t compactSlots[RDF_VOCAB_COUNT] = {
+    40, 21, 15, 41, 106, 73, 35, 72, 20, 64, 11, 16,
+    110, 66, 37, 94, 28, 118, 50, 97, 116, 8, 80, 36,
+    32, 100, 43, 105, 52, 99, 120, 87, 91, 102, 58, 22,
+    25, 112, 62, 98, 53, 0, 23, 1, 82, 85, 7, 86,
+    26, 17, 44, 68, 93, 84, 60, 38, 111, 107, 96, 122,
+    88, 49, 30, 95, 74, 51, 109, 46, 3, 69, 61, 39,
+    115, 57, 47, 14, 5, 56, 24, 76, 33, 90, 70, 63,
+    113, 4, 104, 2, 48, 89, 27, 10, 77, 71, 31, 45,
+    19, 114, 108, 67, 119, 65, 6, 79, 13, 121, 81, 59,
+    9, 101, 103, 34, 83, 55, 29, 117, 18, 92, 12, 42,
+    78, 54, 75,
+};
+
+// Only the length and the last HASH_TAIL bytes are hashed: vocabulary
+// IRIs share long namespace prefixes and differ in their local names
+static uint32_t vocabHash(const char *str, size_t len)
+{
+    uint32_t h = 2166136261u ^ (uint32_t)len;
+    for (size_t i = len > HASH_TAIL ? len - HASH_TAIL : 0; i < len; i++) {
+        h ^= (uint8_t)str[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static uint32_t vocabMix(uint32_t h, uint32_t seed)
+{
+    h ^= seed * 0x9E3779B9u;
+    h ^= h >> 16;
+    h *= 0x7FEB352Du;
+    h ^= h >> 15;
+    h *= 0x846CA68Bu;
+    h ^= h >> 16;
+    return h;
+}
+
+static RDFVocabTerm candidate(const int16_t *displacement, const uint8_t *slots, const char *key, size_t len)
+{
+    uint32_t h = vocabHash(key, len);
+    int16_t d = displacement[h % RDF_VOCAB_COUNT];
+    uint32_t slot = d < 0 ? (uint32_t)(-d - 1) : vocabMix(h, (uint32_t)d) % RDF_VOCAB_COUNT;
+    return (RDFVocabTerm)slots[slot];
+}
+
+RDFVocabTerm RDFVocab_lookupIRI(const char *iri, size_t len)
+{
+    RDFVocabTerm term = candidate(iriDisplacement, iriSlots, iri, len);
+    const RDFVocabEntry *entry = &RDFVocab_terms[term];
+
+    if (len != entry->length || memcmp(iri, entry->iri, len) != 0) {
+        return RDF_VOCAB_NONE;
+    }
+    return term;
+}
+
+RDFVocabTerm RDFVocab_lookupCompact(const char *name, size_t len)
+{
+    RDFVocabTerm term = candidate(compactDisplacement, compactSlots, name, len);
+
+    if (len != RDFVocab_terms[term].nameLength || memcmp(name, RDFVocab_compact(term), len) != 0) {
+        return RDF_VOCAB_NONE;
+    }
+    return term;
+}
+
+// Siblings differ in the first byte of their label, so at most one of
+// them can match and the walk never backtracks
+uint8_t RDFVocab_matchPrefix(const char *iri, size_t len)
+{
+    uint8_t match = RDF_VOCAB_NO_PREFIX;
+    size_t depth = 0;
+    uint8_t node = prefixTrie[0].child;
+
+    while (node != 0 && depth < len) {
+        const TrieNode *n = &prefixTrie[node];
+        if (iri[depth] != n->label[0]) {
+            node = n->sibling;
+            continue;
+        }
+        if (len - depth < n->labelLength || memcmp(iri + depth, n->label, n->labelLength) != 0) {
+            break;
+        }
+        depth += n->labelLength;
+        if (n->prefix != RDF_VOCAB_NO_PREFIX) match = n->prefix;
+        node = n->child;
+    }
+    return match;
+}
@@ -0,0 +1,137 @@
+#include "sha256.h"
+
+#include <string.h>
+
+static const uint32_t K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+#define ROTR(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+
+// Compress one 64-byte block; the message schedule is kept in a rolling
+// 16-word window to save stack on the M4
+static void compress(uint32_t state[8], const uint8_t block[SHA256_BLOCK_SIZE])
+{
+    uint32_t w[16];
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+
+    for (int i = 0; i < 64; i++) {
+        uint32_t wi;
+        if (i < 16) {
+            wi = (uint32_t)block[4 * i] << 24 | (uint32_t)block[4 * i + 1] << 16
+               | (uint32_t)block[4 * i + 2] << 8 | block[4 * i + 3];
+        } else {
+            uint32_t w15 = w[(i - 15) & 15], w2 = w[(i - 2) & 15];
+            uint32_t s0 = ROTR(w15, 7) ^ ROTR(w15, 18) ^ (w15 >> 3);
+            uint32_t s1 = ROTR(w2, 17) ^ ROTR(w2, 19) ^ (w2 >> 10);
+            wi = w[i & 15] + s0 + w[(i - 7) & 15] + s1;
+        }
+        w[i & 15] = wi;
+
+        uint32_t t1 = h + (ROTR(e, 6) ^ ROTR(e, 11) ^ ROTR(e, 25)) + ((e & f) ^ (~e & g)) + K[i] + wi;
+        uint32_t t2 = (ROTR(a, 2) ^ ROTR(a, 13) ^ ROTR(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+        h = g; g = f; f = e; e = d + t1;
+        d = c; c = b; b = a; a = t1 + t2;
+    }
+
+    state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+    state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+}
+
+void SHA256_init(SHA256Context *ctx)
+{
+    static const uint32_t iv[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+    };
+    memcpy(ctx->state, iv, sizeof(iv));
+    ctx->length = 0;
+    ctx->digestSize = SHA256_DIGEST_SIZE;
+}
+
+void SHA224_init(SHA256Context *ctx)
+{
+    static const uint32_t iv[8] = {
+        0xc1059ed8, 0x367cd507, 0x3070dd17, 0xf70e5939, 0xffc00b31, 0x68581511, 0x64f98fa7, 0xbefa4fa4
+    };
+    memcpy(ctx->state, iv, sizeof(iv));
+    ctx->length = 0;
+    ctx->digestSize = SHA224_DIGEST_SIZE;
+}
+
+void SHA256_update(SHA256Context *ctx, const void *data, size_t len)
+{
+    const uint8_t *in = (const uint8_t *)data;
+    size_t used = (size_t)(ctx->length % SHA256_BLOCK_SIZE);
+    ctx->length += len;
+
+    if (used) {
+        size_t fill = SHA256_BLOCK_SIZE - used;
+        if (len < fill) {
+            memcpy(ctx->block + used, in, len);
+            return;
+        }
+        memcpy(ctx->block + used, in, fill);
+        compress(ctx->state, ctx->block);
+        in += fill;
+        len -= fill;
+    }
+    while (len >= SHA256_BLOCK_SIZE) {
+        compress(ctx->state, in);
+        in += SHA256_BLOCK_SIZE;
+        len -= SHA256_BLOCK_SIZE;
+    }
+    memcpy(ctx->block, in, len);
+}
+
+void SHA256_final(SHA256Context *ctx, uint8_t *digest)
+{
+    size_t used = (size_t)(ctx->length % SHA256_BLOCK_SIZE);
+    uint64_t bits = ctx->length * 8;
+
+    ctx->block[used++] = 0x80;
+    if (used > SHA256_BLOCK_SIZE - 8) {
+        memset(ctx->block + used, 0, SHA256_BLOCK_SIZE - used);
+        compress(ctx->state, ctx->block);
+        used = 0;
+    }
+    memset(ctx->block + used, 0, SHA256_BLOCK_SIZE - 8 - used);
+    for (int i = 0; i < 8; i++) {
+        ctx->block[SHA256_BLOCK_SIZE - 1 - i] = (uint8_t)(bits >> (8 * i));
+    }
+    compress(ctx->state, ctx->block);
+
+    for (int i = 0; i < ctx->digestSize; i++) {
+        digest[i] = (uint8_t)(ctx->state[i / 4] >> (24 - 8 * (i % 4)));
+    }
+    memset(ctx, 0, sizeof(*ctx));
+}
+
+void SHA256_saveMidstate(const SHA256Context *ctx, SHA256Midstate *mid)
+{
+    memcpy(mid->state, ctx->state, sizeof(mid->state));
+    mid->length = (uint32_t)(ctx->length - ctx->length % SHA256_BLOCK_SIZE);
+    mid->digestSize = ctx->digestSize;
+}
+
+void SHA256_resume(SHA256Context *ctx, const SHA256Midstate *mid)
+{
+    memcpy(ctx->state, mid->state, sizeof(ctx->state));
+    ctx->length = mid->length;
+    ctx->digestSize = mid->digestSize;
+}
+
+void SHA256_compute(const void *data, size_t len, uint8_t digest[SHA256_DIGEST_SIZE])
+{
+    SHA256Context ctx;
+    SHA256_init(&ctx);
+    SHA256_update(&ctx, data, len);
+    SHA256_final(&ctx, digest);
+}
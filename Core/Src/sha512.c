@@ -0,0 +1,181 @@
+#include "sha512.h"
+
+#include <string.h>
+
+// Round constants as high and low halves; const, so they stay in flash
+static const uint32_t K[160] = {
+    0x428a2f98, 0xd728ae22, 0x71374491, 0x23ef65cd, 0xb5c0fbcf, 0xec4d3b2f, 0xe9b5dba5, 0x8189dbbc,
+    0x3956c25b, 0xf348b538, 0x59f111f1, 0xb605d019, 0x923f82a4, 0xaf194f9b, 0xab1c5ed5, 0xda6d8118,
+    0xd807aa98, 0xa3030242, 0x12835b01, 0x45706fbe, 0x243185be, 0x4ee4b28c, 0x550c7dc3, 0xd5ffb4e2,
+    0x72be5d74, 0xf27b896f, 0x80deb1fe, 0x3b1696b1, 0x9bdc06a7, 0x25c71235, 0xc19bf174, 0xcf692694,
+    0xe49b69c1, 0x9ef14ad2, 0xefbe4786, 0x384f25e3, 0x0fc19dc6, 0x8b8cd5b5, 0x240ca1cc, 0x77ac9c65,
+    0x2de92c6f, 0x592b0275, 0x4a7484aa, 0x6ea6e483, 0x5cb0a9dc, 0xbd41fbd4, 0x76f988da, 0x831153b5,
+    0x983e5152, 0xee66dfab, 0xa831c66d, 0x2db43210, 0xb00327c8, 0x98fb213f, 0xbf597fc7, 0xbeef0ee4,
+    0xc6e00bf3, 0x3da88fc2, 0xd5a79147, 0x930aa725, 0x06ca6351, 0xe003826f, 0x14292967, 0x0a0e6e70,
+    0x27b70a85, 0x46d22ffc, 0x2e1b2138, 0x5c26c926, 0x4d2c6dfc, 0x5ac42aed, 0x53380d13, 0x9d95b3df,
+    0x650a7354, 0x8baf63de, 0x766a0abb, 0x3c77b2a8, 0x81c2c92e, 0x47edaee6, 0x92722c85, 0x1482353b,
+    0xa2bfe8a1, 0x4cf10364, 0xa81a664b, 0xbc423001, 0xc24b8b70, 0xd0f89791, 0xc76c51a3, 0x0654be30,
+    0xd192e819, 0xd6ef5218, 0xd6990624, 0x5565a910, 0xf40e3585, 0x5771202a, 0x106aa070, 0x32bbd1b8,
+    0x19a4c116, 0xb8d2d0c8, 0x1e376c08, 0x5141ab53, 0x2748774c, 0xdf8eeb99, 0x34b0bcb5, 0xe19b48a8,
+    0x391c0cb3, 0xc5c95a63, 0x4ed8aa4a, 0xe3418acb, 0x5b9cca4f, 0x7763e373, 0x682e6ff3, 0xd6b2b8a3,
+    0x748f82ee, 0x5defb2fc, 0x78a5636f, 0x43172f60, 0x84c87814, 0xa1f0ab72, 0x8cc70208, 0x1a6439ec,
+    0x90befffa, 0x23631e28, 0xa4506ceb, 0xde82bde9, 0xbef9a3f7, 0xb2c67915, 0xc67178f2, 0xe372532b,
+    0xca273ece, 0xea26619c, 0xd186b8c7, 0x21c0c207, 0xeada7dd6, 0xcde0eb1e, 0xf57d4f7f, 0xee6ed178,
+    0x06f067aa, 0x72176fba, 0x0a637dc5, 0xa2c898a6, 0x113f9804, 0xbef90dae, 0x1b710b35, 0x131c471b,
+    0x28db77f5, 0x23047d84, 0x32caab7b, 0x40c72493, 0x3c9ebe0a, 0x15c9bebc, 0x431d67c4, 0x9c100d4c,
+    0x4cc5d4be, 0xcb3e42b6, 0x597f299c, 0xfc657e2a, 0x5fcb6fab, 0x3ad6faec, 0x6c44198c, 0x4a475817
+};
+
+// A 64-bit word as the two registers the M4 holds it in
+typedef struct {
+    uint32_t hi, lo;
+} Word;
+
+static inline Word add(Word a, Word b)
+{
+    Word r;
+    r.lo = a.lo + b.lo;
+    r.hi = a.hi + b.hi + (r.lo < a.lo);
+    return r;
+}
+
+// Rotate right by 0 < n < 32; by 32 + n is the same on swapped halves
+static inline Word rotr(uint32_t hi, uint32_t lo, int n)
+{
+    Word r = { hi >> n | lo << (32 - n), lo >> n | hi << (32 - n) };
+    return r;
+}
+
+static inline Word shr(Word x, int n)
+{
+    Word r = { x.hi >> n, x.lo >> n | x.hi << (32 - n) };
+    return r;
+}
+
+static inline Word xor3(Word a, Word b, Word c)
+{
+    Word r = { a.hi ^ b.hi ^ c.hi, a.lo ^ b.lo ^ c.lo };
+    return r;
+}
+
+static inline Word bigSigma0(Word x) { return xor3(rotr(x.hi, x.lo, 28), rotr(x.lo, x.hi, 2), rotr(x.lo, x.hi, 7)); }
+static inline Word bigSigma1(Word x) { return xor3(rotr(x.hi, x.lo, 14), rotr(x.hi, x.lo, 18), rotr(x.lo, x.hi, 9)); }
+static inline Word smallSigma0(Word x) { return xor3(rotr(x.hi, x.lo, 1), rotr(x.hi, x.lo, 8), shr(x, 7)); }
+static inline Word smallSigma1(Word x) { return xor3(rotr(x.hi, x.lo, 19), rotr(x.lo, x.hi, 29), shr(x, 6)); }
+
+static inline Word load(const uint8_t *p)
+{
+    Word r = {
+        (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 8 | p[3],
+        (uint32_t)p[4] << 24 | (uint32_t)p[5] << 16 | (uint32_t)p[6] << 8 | p[7]
+    };
+    return r;
+}
+
+// Compress one 128-byte block; the message schedule is computed as the
+// rounds go, in a rolling 16-word window, as SHA-256 does
+static void compress(uint32_t state[16], const uint8_t block[SHA512_BLOCK_SIZE])
+{
+    Word w[16];
+    Word a = { state[0], state[1] }, b = { state[2], state[3] };
+    Word c = { state[4], state[5] }, d = { state[6], state[7] };
+    Word e = { state[8], state[9] }, f = { state[10], state[11] };
+    Word g = { state[12], state[13] }, h = { state[14], state[15] };
+
+    for (int i = 0; i < 80; i++) {
+        Word wi;
+        if (i < 16) {
+            wi = load(block + 8 * i);
+        } else {
+            wi = add(add(w[i & 15], smallSigma0(w[(i - 15) & 15])),
+                     add(w[(i - 7) & 15], smallSigma1(w[(i - 2) & 15])));
+        }
+        w[i & 15] = wi;
+
+        Word ch = { (e.hi & f.hi) ^ (~e.hi & g.hi), (e.lo & f.lo) ^ (~e.lo & g.lo) };
+        Word maj = { (a.hi & b.hi) ^ (a.hi & c.hi) ^ (b.hi & c.hi), (a.lo & b.lo) ^ (a.lo & c.lo) ^ (b.lo & c.lo) };
+        Word k = { K[2 * i], K[2 * i + 1] };
+        Word t1 = add(add(add(h, bigSigma1(e)), add(ch, k)), wi);
+        Word t2 = add(bigSigma0(a), maj);
+        h = g; g = f; f = e; e = add(d, t1);
+        d = c; c = b; b = a; a = add(t1, t2);
+    }
+
+    Word v[8] = { a, b, c, d, e, f, g, h };
+    for (int i = 0; i < 8; i++) {
+        Word s = add((Word){ state[2 * i], state[2 * i + 1] }, v[i]);
+        state[2 * i] = s.hi;
+        state[2 * i + 1] = s.lo;
+    }
+}
+
+void SHA512_init(SHA512Context *ctx)
+{
+    static const uint32_t iv[16] = {
+        0x6a09e667, 0xf3bcc908, 0xbb67ae85, 0x84caa73b, 0x3c6ef372, 0xfe94f82b, 0xa54ff53a, 0x5f1d36f1,
+        0x510e527f, 0xade682d1, 0x9b05688c, 0x2b3e6c1f, 0x1f83d9ab, 0xfb41bd6b, 0x5be0cd19, 0x137e2179
+    };
+    memcpy(ctx->state, iv, sizeof(iv));
+    ctx->length = 0;
+}
+
+void SHA512_update(SHA512Context *ctx, const void *data, size_t len)
+{
+    const uint8_t *in = (const uint8_t *)data;
+    size_t used = (size_t)(ctx->length % SHA512_BLOCK_SIZE);
+
+    if (len == 0) {
+        return;   // data may be NULL
+    }
+    ctx->length += len;
+
+    if (used) {
+        size_t fill = SHA512_BLOCK_SIZE - used;
+        if (len < fill) {
+            memcpy(ctx->block + used, in, len);
+            return;
+        }
+        memcpy(ctx->block + used, in, fill);
+        compress(ctx->state, ctx->block);
+        in += fill;
+        len -= fill;
+    }
+    while (len >= SHA512_BLOCK_SIZE) {
+        compress(ctx->state, in);
+        in += SHA512_BLOCK_SIZE;
+        len -= SHA512_BLOCK_SIZE;
+    }
+    memcpy(ctx->block, in, len);
+}
+
+void SHA512_final(SHA512Context *ctx, uint8_t digest[SHA512_DIGEST_SIZE])
+{
+    size_t used = (size_t)(ctx->length % SHA512_BLOCK_SIZE);
+    uint64_t bits = ctx->length * 8;
+
+    // The length field is 128 bits; messages stay below 2^61 bytes
+    ctx->block[used++] = 0x80;
+    if (used > SHA512_BLOCK_SIZE - 16) {
+        memset(ctx->block + used, 0, SHA512_BLOCK_SIZE - used);
+        compress(ctx->state, ctx->block);
+        used = 0;
+    }
+    memset(ctx->block + used, 0, SHA512_BLOCK_SIZE - 8 - used);
+    for (int i = 0; i < 8; i++) {
+        ctx->block[SHA512_BLOCK_SIZE - 1 - i] = (uint8_t)(bits >> (8 * i));
+    }
+    compress(ctx->state, ctx->block);
+
+    for (int i = 0; i < SHA512_DIGEST_SIZE; i++) {
+        digest[i] = (uint8_t)(ctx->state[i / 4] >> (24 - 8 * (i % 4)));
+    }
+    memset(ctx, 0, sizeof(*ctx));
+}
+
+void SHA512_compute(const void *data, size_t len, uint8_t digest[SHA512_DIGEST_SIZE])
+{
+    SHA512Context ctx;
+    SHA512_init(&ctx);
+    SHA512_update(&ctx, data, len);
+    SHA512_final(&ctx, digest);
+}
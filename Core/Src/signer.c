@@ -0,0 +1,214 @@
+#include "signer.h"
+
+#include <string.h>
+
+#include "main.h"
+#include "sha256.h"
+
+#define SIGNER_MATH_FUNCS CMOX_ECC256_MATH_FUNCS
+
+// memset() the compiler may not drop for a buffer that is dead afterwards
+static void wipe(void *data, size_t length)
+{
+    volatile uint8_t *p = (volatile uint8_t *)data;
+    while (length--) *p++ = 0;
+}
+
+/* Nonce DRBG ---------------------------------------------------------------*/
+
+// HMAC-SHA256 of the concatenation of up to three parts; out may alias key
+static void hmac(const uint8_t key[32], const void *a, size_t aLength, const void *b, size_t bLength,
+                 const void *c, size_t cLength, uint8_t out[32])
+{
+    uint8_t pad[SHA256_BLOCK_SIZE], inner[SHA256_DIGEST_SIZE];
+    SHA256Context md;
+
+    memset(pad, 0x36, sizeof(pad));
+    for (int i = 0; i < 32; i++) pad[i] ^= key[i];
+    SHA256_init(&md);
+    SHA256_update(&md, pad, sizeof(pad));
+    if (aLength) SHA256_update(&md, a, aLength);
+    if (bLength) SHA256_update(&md, b, bLength);
+    if (cLength) SHA256_update(&md, c, cLength);
+    SHA256_final(&md, inner);
+
+    memset(pad, 0x5c, sizeof(pad));
+    for (int i = 0; i < 32; i++) pad[i] ^= key[i];
+    SHA256_init(&md);
+    SHA256_update(&md, pad, sizeof(pad));
+    SHA256_update(&md, inner, sizeof(inner));
+    SHA256_final(&md, out);
+    wipe(pad, sizeof(pad));
+    wipe(inner, sizeof(inner));
+}
+
+// HMAC_DRBG_Update
+static void drbgUpdate(Signer *signer, const void *data, size_t length)
+{
+    static const uint8_t zero = 0x00, one = 0x01;
+    hmac(signer->drbgKey, signer->drbgValue, 32, &zero, 1, data, length, signer->drbgKey);
+    hmac(signer->drbgKey, signer->drbgValue, 32, NULL, 0, NULL, 0, signer->drbgValue);
+    if (length) {
+        hmac(signer->drbgKey, signer->drbgValue, 32, &one, 1, data, length, signer->drbgKey);
+        hmac(signer->drbgKey, signer->drbgValue, 32, NULL, 0, NULL, 0, signer->drbgValue);
+    }
+}
+
+// 32 bytes never output before: the state moves on with every call
+static void drbgGenerate(Signer *signer, uint8_t out[32])
+{
+    hmac(signer->drbgKey, signer->drbgValue, 32, NULL, 0, NULL, 0, signer->drbgValue);
+    memcpy(out, signer->drbgValue, 32);
+    drbgUpdate(signer, NULL, 0);
+}
+
+/* Signer -------------------------------------------------------------------*/
+
+cmox_ecc_retval_t Signer_init(Signer *signer, const uint8_t *seed, size_t seedLength)
+{
+    size_t privateLength = sizeof(signer->privateKey), publicLength = sizeof(signer->publicKey);
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    uint32_t start = DWT->CYCCNT;
+    cmox_ecc_construct(&signer->ecc, SIGNER_MATH_FUNCS, signer->working, sizeof(signer->working));
+    cmox_ecc_retval_t retval = cmox_ecdsa_keyGen(&signer->ecc, SIGNER_CURVE, seed, seedLength,
+                                                 signer->privateKey, &privateLength,
+                                                 signer->publicKey, &publicLength);
+    if (retval == CMOX_ECC_SUCCESS
+        && (privateLength != sizeof(signer->privateKey) || publicLength != sizeof(signer->publicKey))) {
+        retval = CMOX_ECC_ERR_INTERNAL;
+    }
+
+    // Keyed with the private key, nonces stay secret even when the
+    // entropy is weak; the entropy keeps them from repeating across boots
+    memset(signer->drbgKey, 0x00, sizeof(signer->drbgKey));
+    memset(signer->drbgValue, 0x01, sizeof(signer->drbgValue));
+    drbgUpdate(signer, signer->privateKey, sizeof(signer->privateKey));
+    drbgUpdate(signer, seed, seedLength);
+    signer->presignCount = 0;
+    signer->cycles = DWT->CYCCNT - start;
+    return retval;
+}
+
+void Signer_addEntropy(Signer *signer, const void *data, size_t length)
+{
+    if (length) drbgUpdate(signer, data, length);
+}
+
+int Signer_presign(Signer *signer)
+{
+    uint8_t bytes[P256_BYTES];
+    P256Int k, d, rd;
+
+    if (signer->presignCount >= SIGNER_PRESIGN_POOL) {
+        return 0;
+    }
+    uint32_t start = DWT->CYCCNT;
+    SignerPresign *entry = &signer->presign[signer->presignCount];
+    for (;;) {
+        drbgGenerate(signer, bytes);
+        P256Int_fromBytes(&k, bytes);
+        if (!P256_scalarIsValid(&k)) continue;
+        P256_baseMultiplyX(&entry->r, &k);
+        if (!P256Int_isZero(&entry->r)) break;
+    }
+    P256_scalarInvert(&entry->kInverse, &k);
+    P256Int_fromBytes(&d, signer->privateKey);
+    P256_scalarMul(&rd, &entry->r, &d);
+    P256_scalarMul(&entry->kInverseRD, &entry->kInverse, &rd);
+    signer->presignCount++;
+
+    wipe(bytes, sizeof(bytes));
+    wipe(&k, sizeof(k));
+    wipe(&d, sizeof(d));
+    wipe(&rd, sizeof(rd));
+    signer->cycles = DWT->CYCCNT - start;
+    return 1;
+}
+
+int Signer_presignCount(const Signer *signer)
+{
+    return signer->presignCount;
+}
+
+// The digest as an integer mod n, its leftmost 256 bits when it is longer
+static void digestScalar(P256Int *e, const uint8_t *digest, size_t digestLength)
+{
+    uint8_t bytes[P256_BYTES] = { 0 };
+    if (digestLength >= P256_BYTES) {
+        memcpy(bytes, digest, P256_BYTES);
+    } else {
+        memcpy(bytes + P256_BYTES - digestLength, digest, digestLength);
+    }
+    P256Int_fromBytes(e, bytes);
+    P256_scalarReduce(e);
+}
+
+cmox_ecc_retval_t Signer_sign(Signer *signer, const uint8_t *digest, size_t digestLength,
+                              uint8_t signature[CMOX_ECC_SECP256R1_SIG_LEN])
+{
+    uint32_t start = DWT->CYCCNT;
+
+    // Online half: the pre-signature leaves the pool before it is used
+    while (signer->presignCount > 0) {
+        SignerPresign *entry = &signer->presign[--signer->presignCount];
+        P256Int e, s;
+        digestScalar(&e, digest, digestLength);
+        P256_scalarMul(&s, &entry->kInverse, &e);
+        P256_scalarAdd(&s, &s, &entry->kInverseRD);
+        int usable = !P256Int_isZero(&s);
+        P256Int_toBytes(signature, &entry->r);
+        P256Int_toBytes(signature + P256_BYTES, &s);
+        wipe(entry, sizeof(*entry));
+        wipe(&s, sizeof(s));
+        if (usable) {
+            signer->cycles = DWT->CYCCNT - start;
+            return CMOX_ECC_SUCCESS;
+        }
+    }
+
+    // Empty pool: cmox with a nonce from the DRBG, drawn again if cmox
+    // finds it out of range
+    uint8_t random[P256_BYTES];
+    size_t signatureLength;
+    cmox_ecc_retval_t retval;
+    do {
+        drbgGenerate(signer, random);
+        signatureLength = CMOX_ECC_SECP256R1_SIG_LEN;
+        retval = cmox_ecdsa_sign(&signer->ecc, SIGNER_CURVE, random, sizeof(random),
+                                 signer->privateKey, sizeof(signer->privateKey),
+                                 digest, digestLength, signature, &signatureLength);
+    } while (retval == CMOX_ECC_ERR_WRONG_RANDOM);
+    wipe(random, sizeof(random));
+    signer->cycles = DWT->CYCCNT - start;
+    if (retval == CMOX_ECC_SUCCESS && signatureLength != CMOX_ECC_SECP256R1_SIG_LEN) {
+        retval = CMOX_ECC_ERR_INTERNAL;
+    }
+    return retval;
+}
+
+cmox_ecc_retval_t Signer_verify(Signer *signer, const uint8_t *publicKey, const uint8_t *digest, size_t digestLength,
+                                const uint8_t signature[CMOX_ECC_SECP256R1_SIG_LEN])
+{
+    uint32_t faultCheck = CMOX_ECC_AUTH_FAIL;
+
+    uint32_t start = DWT->CYCCNT;
+    cmox_ecc_retval_t retval = cmox_ecdsa_verify(&signer->ecc, SIGNER_CURVE,
+                                                 publicKey ? publicKey : signer->publicKey, CMOX_ECC_SECP256R1_PUBKEY_LEN,
+                                                 digest, digestLength,
+                                                 signature, CMOX_ECC_SECP256R1_SIG_LEN, &faultCheck);
+    signer->cycles = DWT->CYCCNT - start;
+    return retval == CMOX_ECC_AUTH_SUCCESS && faultCheck == CMOX_ECC_AUTH_SUCCESS ? CMOX_ECC_AUTH_SUCCESS : CMOX_ECC_AUTH_FAIL;
+}
+
+void Signer_free(Signer *signer)
+{
+    cmox_ecc_cleanup(&signer->ecc);
+    wipe(signer->privateKey, sizeof(signer->privateKey));
+    wipe(signer->drbgKey, sizeof(signer->drbgKey));
+    wipe(signer->drbgValue, sizeof(signer->drbgValue));
+    wipe(signer->presign, sizeof(signer->presign));
+    signer->presignCount = 0;
+}
@@ -0,0 +1,244 @@
+#!/usr/bin/env python3
+"""Compile the JSON-LD contexts of Tools/contexts into binary term tables.
+
+Writes Core/Inc/jsonld_context_tables.h and Core/Src/jsonld_context_tables.c:
+per context, the coercion of every vocabulary term it defines under the
+term's compact name, and a table of its other term definitions sorted by
+name and by IRI. The firmware then expands and compacts with these tables
+and never parses a context at run time. Run from the repository root after
+editing Tools/contexts or Tools/vocab.txt:
+
+    python3 Tools/gen_context.py
+
+Type-scoped and property-scoped contexts are merged into the context that
+holds them; where they redefine a term, the outer definition is kept.
+"""
+
+import json
+import os
+import re
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import gen_vocab  # noqa: E402
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+CONTEXTS = os.path.join(ROOT, "Tools", "contexts")
+MANIFEST = os.path.join(CONTEXTS, "contexts.txt")
+HEADER = os.path.join(ROOT, "Core", "Inc", "jsonld_context_tables.h")
+SOURCE_C = os.path.join(ROOT, "Core", "Src", "jsonld_context_tables.c")
+
+XSD_DATE_TIME = "http://www.w3.org/2001/XMLSchema#dateTime"
+
+# Must match JSONLDCoercion in jsonld_context.h, where 0 is JSONLD_UNDEFINED
+COERCIONS = ["JSONLD_COERCE_NONE", "JSONLD_COERCE_ID", "JSONLD_COERCE_VOCAB",
+             "JSONLD_COERCE_DATETIME", "JSONLD_COERCE_GRAPH", "JSONLD_COERCE_UNSUPPORTED"]
+NONE, ID, VOCAB, DATETIME, GRAPH, UNSUPPORTED = COERCIONS
+
+# Keywords a context may alias, and the JSONLD_ALIAS_* flag of each
+ALIASES = {"@id": "JSONLD_ALIAS_ID", "@type": "JSONLD_ALIAS_TYPE"}
+
+
+def fail(message):
+    sys.exit("gen_context: " + message)
+
+
+def read_manifest():
+    contexts = []
+    with open(MANIFEST) as f:
+        for line in f:
+            line = re.sub(r"(^|\s)#.*", "", line).split()
+            if not line:
+                continue
+            if len(line) != 2:
+                fail("expected <file> <url>: %s" % " ".join(line))
+            contexts.append((line[0], line[1]))
+    return contexts
+
+
+class Context:
+    def __init__(self, url):
+        self.url = url
+        self.vocab = None
+        self.aliases = set()
+        self.terms = {}       # name -> (IRI, coercion)
+        self.prefixes = {}    # name -> IRI of plain string definitions
+
+    def expand(self, value, name=None):
+        """Expand a compact IRI, term or absolute IRI given in the context."""
+        if value in self.terms:
+            return self.terms[value][0]
+        if ":" in value:
+            prefix, rest = value.split(":", 1)
+            if not rest.startswith("//") and prefix in self.prefixes:
+                return self.prefixes[prefix] + rest
+            return value
+        if self.vocab:
+            return self.vocab + value
+        fail("%s: cannot expand %s%s" % (self.url, value, " for " + name if name else ""))
+
+
+def coercion(context, name, definition):
+    container = definition.get("@container", "@set")
+    if isinstance(container, list):
+        container = container[0] if len(container) == 1 else "@list"
+    kind = definition.get("@type")
+    if "@reverse" in definition or "@language" in definition or container not in ("@set", "@graph"):
+        return UNSUPPORTED
+    if container == "@graph":
+        return GRAPH if kind in (None, "@id") else UNSUPPORTED
+    if kind is None:
+        return NONE
+    if kind == "@id":
+        return ID
+    if kind == "@vocab":
+        return VOCAB
+    return DATETIME if context.expand(kind, name) == XSD_DATE_TIME else UNSUPPORTED
+
+
+def define(context, name, iri, kind):
+    if name in context.terms and context.terms[name] != (iri, kind):
+        print("gen_context: %s: keeping the outer definition of %s" % (context.url, name))
+        return
+    context.terms[name] = (iri, kind)
+
+
+def process(context, value, documents, seen):
+    """Merge one @context value into context."""
+    if isinstance(value, list):
+        for item in value:
+            process(context, item, documents, seen)
+        return
+    if isinstance(value, str):
+        if value not in documents:
+            fail("%s imports %s, which is not in contexts.txt" % (context.url, value))
+        if value in seen:
+            fail("%s imports itself" % value)
+        process(context, documents[value]["@context"], documents, seen | {value})
+        return
+    if value is None:
+        fail("%s: a null context is not supported" % context.url)
+
+    if "@vocab" in value:
+        context.vocab = value["@vocab"]
+    # Prefixes first: definitions may use prefixes defined after them
+    for name, definition in value.items():
+        if not name.startswith("@") and isinstance(definition, str) and not definition.startswith("@"):
+            context.prefixes[name] = context.expand(definition, name) if ":" in definition else definition
+
+    scoped = []
+    for name, definition in value.items():
+        if name.startswith("@") or definition is None:
+            continue
+        if isinstance(definition, str):
+            if definition.startswith("@"):
+                if definition not in ALIASES:
+                    fail("%s: alias %s of %s is not supported" % (context.url, name, definition))
+                context.aliases.add(definition)
+                continue
+            define(context, name, context.expand(definition, name), NONE)
+            continue
+        iri = context.expand(definition.get("@id", name), name)
+        define(context, name, iri, coercion(context, name, definition))
+        if "@context" in definition:
+            scoped.append(definition["@context"])
+    for value in scoped:
+        process(context, value, documents, seen)
+
+
+def c_string(text):
+    return '"%s"' % text.replace("\\", "\\\\").replace('"', '\\"')
+
+
+def enum_name(path):
+    return "JSONLD_CONTEXT_" + re.sub(r"[^A-Za-z0-9]", "_", os.path.splitext(path)[0]).upper()
+
+
+def main():
+    prefixes, vocab_terms = gen_vocab.parse(gen_vocab.SOURCE)
+    vocab_enums = gen_vocab.enum_names(prefixes, vocab_terms)
+    vocab_iris = {prefixes[p][1] + name: i for i, (p, name) in enumerate(vocab_terms)}
+
+    manifest = read_manifest()
+    documents = {}
+    for path, url in manifest:
+        with open(os.path.join(CONTEXTS, path)) as f:
+            documents[url] = json.load(f)
+
+    contexts = []
+    for path, url in manifest:
+        context = Context(url)
+        process(context, documents[url]["@context"], documents, {url})
+        contexts.append(context)
+
+    enums = [enum_name(path) for path, _ in manifest]
+    h = []
+    h.append("/* Generated by Tools/gen_context.py from Tools/contexts, do not edit. */\n")
+    h.append("#ifndef JSONLD_CONTEXT_TABLES_H\n#define JSONLD_CONTEXT_TABLES_H\n")
+    h.append("typedef enum {")
+    for i, e in enumerate(enums):
+        h.append("    %s = %d," % (e, i))
+    h.append("    JSONLD_CONTEXT_COUNT = %d" % len(enums))
+    h.append("} JSONLDContextId;\n")
+    for (_, url), e in zip(manifest, enums):
+        h.append("#define %s %s" % (e.replace("JSONLD_CONTEXT_", "JSONLD_URL_"), c_string(url)))
+    h.append("\n#endif /* JSONLD_CONTEXT_TABLES_H */")
+
+    c = []
+    c.append("/* Generated by Tools/gen_context.py from Tools/contexts, do not edit. */\n")
+    c.append('#include "jsonld_context.h"\n')
+    summary = []
+    for context, e in zip(contexts, enums):
+        table = ["JSONLD_UNDEFINED"] * len(vocab_terms)
+        others = []
+        for name, (iri, kind) in sorted(context.terms.items()):
+            term = vocab_iris.get(iri)
+            if term is not None and vocab_terms[term][1] == name:
+                table[term] = kind
+            else:
+                others.append((name, iri, kind))
+        for name, iri, _ in others:
+            if len(name) > 255 or len(iri) > 255:
+                fail("%s: %s is too long" % (context.url, name))
+        if len(others) > 255:
+            fail("%s: too many term definitions" % context.url)
+
+        lower = e.replace("JSONLD_CONTEXT_", "").lower()
+        ident = re.sub(r"_([a-z0-9])", lambda m: m.group(1).upper(), lower)
+        c.append("static const uint8_t %sCoercions[RDF_VOCAB_COUNT] = {" % ident)
+        for term, kind in enumerate(table):
+            if kind != "JSONLD_UNDEFINED":
+                c.append("    [RDF_VOCAB_%s] = %s," % (vocab_enums[term], kind))
+        c.append("};\n")
+        if others:
+            c.append("static const JSONLDTermDefinition %sTerms[%d] = {" % (ident, len(others)))
+            for name, iri, kind in others:
+                c.append("    { %s, %s, %d, %d, %s }," % (c_string(name), c_string(iri), len(name), len(iri), kind))
+            c.append("};\n")
+            by_iri = sorted(range(len(others)), key=lambda i: others[i][1].encode())
+            c.append("static const uint8_t %sTermsByIri[%d] = {" % (ident, len(others)))
+            c.append(gen_vocab.c_table(by_iri))
+            c.append("};\n")
+        summary.append((context, e, ident, len(others)))
+
+    c.append("const JSONLDContextEntry JSONLD_contexts[JSONLD_CONTEXT_COUNT] = {")
+    for context, e, ident, count in summary:
+        aliases = " | ".join(ALIASES[a] for a in sorted(context.aliases)) or "0"
+        vocab = "%s, %d" % (c_string(context.vocab), len(context.vocab)) if context.vocab else "NULL, 0"
+        terms = "%sTerms, %sTermsByIri, %d" % (ident, ident, count) if count else "NULL, NULL, 0"
+        c.append("    [%s] = {" % e)
+        c.append("        %s, %d, %s," % (e.replace("JSONLD_CONTEXT_", "JSONLD_URL_"), len(context.url), aliases))
+        c.append("        %s, %sCoercions, %s" % (vocab, ident, terms))
+        c.append("    },")
+    c.append("};")
+
+    with open(HEADER, "w") as f:
+        f.write("\n".join(h) + "\n")
+    with open(SOURCE_C, "w") as f:
+        f.write("\n".join(c) + "\n")
+    for context, _, _, count in summary:
+        print("gen_context: %s: %d terms, %d outside the vocabulary" % (context.url, len(context.terms), count))
+
+
+if __name__ == "__main__":
+    main()
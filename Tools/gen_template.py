@@ -0,0 +1,152 @@
+#!/usr/bin/env python3
+"""Compile the credential skeleton Tools/credential_template.json into a
+flash-resident blob with fixed-offset patch holes.
+
+Writes Core/Inc/credential_template_tables.h and
+Core/Src/credential_template_tables.c: the document with CRLF line breaks,
+as JSONLD_writeDocument() prints it, and the offset of every hole. A hole
+is a string value {{name}} in the skeleton; it is reserved at the fixed
+width HOLES gives it, so issuing a credential copies the blob and writes
+each value in place.
+
+The JCS signing input, the document without its jws in RFC 8785 form, is
+compiled the same way, so that the digest can resume after its constant
+prefix. Python's sorted, compact json.dumps() is JCS for the skeleton's
+strings: ASCII keys and no numbers. Run from the repository root after
+editing the skeleton:
+
+    python3 Tools/gen_template.py
+"""
+
+import json
+import os
+import re
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SOURCE = os.path.join(ROOT, "Tools", "credential_template.json")
+HEADER = os.path.join(ROOT, "Core", "Inc", "credential_template_tables.h")
+SOURCE_C = os.path.join(ROOT, "Core", "Src", "credential_template_tables.c")
+
+# Every hole the firmware fills, in CredentialHoleId order, with its width
+HOLES = [
+    ("created", 20),    # xsd:dateTime in UTC: YYYY-MM-DDThh:mm:ssZ
+    ("jws", 128),       # hex ECDSA P-256 signature
+]
+
+# Holes hold no JSON escapes, so their values go in verbatim
+FILLER = "0"
+
+# The member the signing input leaves out, as hashCredential() does
+SIGNING_OMIT = "jws"
+
+
+def fail(message):
+    sys.exit("gen_template: " + message)
+
+
+def c_string(text):
+    return text.replace("\\", "\\\\").replace('"', '\\"').replace("\r", "\\r").replace("\n", "\\n")
+
+
+def remove_member(value, key):
+    if isinstance(value, dict):
+        return {k: remove_member(v, key) for k, v in value.items() if k != key}
+    if isinstance(value, list):
+        return [remove_member(v, key) for v in value]
+    return value
+
+
+# Reserve every hole of text at its width; returns the text and the offset
+# of each hole found
+def fill_holes(text):
+    widths = dict(HOLES)
+    blob, offsets = "", {}
+    pos = 0
+    for m in re.finditer(r'"\{\{(\w+)\}\}"', text):
+        name = m.group(1)
+        if name not in widths:
+            fail("unknown hole {{%s}}" % name)
+        if name in offsets:
+            fail("hole {{%s}} appears twice" % name)
+        blob += text[pos:m.start()] + '"'
+        offsets[name] = len(blob.encode())
+        blob += FILLER * widths[name] + '"'
+        pos = m.end()
+    blob += text[pos:]
+    if len(blob.encode()) > 0xFFFF:
+        fail("template is too large")
+    return blob, offsets
+
+
+def c_text(name, size, pieces):
+    c = ["const char %s[%s + 1] =" % (name, size)]
+    for i, piece in enumerate(pieces):
+        c.append('    "%s"%s' % (c_string(piece), ";" if i == len(pieces) - 1 else ""))
+    return c
+
+
+def c_holes(name, offsets):
+    c = ["const CredentialHole %s[CREDENTIAL_HOLE_COUNT] = {" % name]
+    for hole, width in HOLES:
+        if hole in offsets:
+            c.append("    [CREDENTIAL_HOLE_%s] = { %d, %d }," % (hole.upper(), offsets[hole], width))
+    c.append("};")
+    return c
+
+
+def main():
+    with open(SOURCE) as f:
+        skeleton = f.read()
+    try:
+        document = json.loads(skeleton)
+    except ValueError as e:
+        fail("%s: %s" % (SOURCE, e))
+
+    blob, offsets = fill_holes(skeleton.replace("\r\n", "\n").replace("\n", "\r\n"))
+    for name, _ in HOLES:
+        if name not in offsets:
+            fail("hole {{%s}} is missing" % name)
+    size = len(blob.encode())
+
+    signing, signingOffsets = fill_holes(json.dumps(remove_member(document, SIGNING_OMIT), sort_keys=True,
+                                                    separators=(",", ":"), ensure_ascii=False))
+    signingSize = len(signing.encode())
+
+    h = []
+    h.append("/* Generated by Tools/gen_template.py from Tools/credential_template.json, do not edit. */\n")
+    h.append("#ifndef CREDENTIAL_TEMPLATE_TABLES_H\n#define CREDENTIAL_TEMPLATE_TABLES_H\n")
+    h.append("typedef enum {")
+    for i, (name, _) in enumerate(HOLES):
+        h.append("    CREDENTIAL_HOLE_%s = %d," % (name.upper(), i))
+    h.append("    CREDENTIAL_HOLE_COUNT = %d" % len(HOLES))
+    h.append("} CredentialHoleId;\n")
+    h.append("// Bytes of the document and of its signing input, without a terminating NUL")
+    h.append("#define CREDENTIAL_TEMPLATE_SIZE %d" % size)
+    h.append("#define CREDENTIAL_SIGNING_SIZE %d" % signingSize)
+    for name, width in HOLES:
+        h.append("#define CREDENTIAL_%s_SIZE %d" % (name.upper(), width))
+    h.append("\n#endif /* CREDENTIAL_TEMPLATE_TABLES_H */")
+
+    c = []
+    c.append("/* Generated by Tools/gen_template.py from Tools/credential_template.json, do not edit. */\n")
+    c.append('#include "credential_template.h"\n')
+    c += c_text("CredentialTemplate_text", "CREDENTIAL_TEMPLATE_SIZE", re.findall(r".*?\r\n|.+$", blob))
+    c.append("")
+    c += c_holes("CredentialTemplate_holes", offsets)
+    c.append("")
+    c.append("// One line per SHA-256 block")
+    c += c_text("CredentialTemplate_signingText", "CREDENTIAL_SIGNING_SIZE",
+                [signing[i:i + 64] for i in range(0, len(signing), 64)])
+    c.append("")
+    c += c_holes("CredentialTemplate_signingHoles", signingOffsets)
+
+    with open(HEADER, "w") as f:
+        f.write("\n".join(h) + "\n")
+    with open(SOURCE_C, "w") as f:
+        f.write("\n".join(c) + "\n")
+    print("gen_template: %d bytes, %d holes; signing input %d bytes" % (size, len(HOLES), signingSize))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,379 @@
+#!/usr/bin/env python3
+"""Compile Tools/vocab.txt into Core/Inc/rdf_vocab.h and Core/Src/rdf_vocab.c.
+
+Every term gets an enum id, and both its expanded IRI and its compact name
+get a minimal perfect hash, so a lookup costs one hash and one comparison.
+The namespace IRIs get a path-compressed trie for longest-prefix matching,
+and a table of how IRIs in two different namespaces compare.
+Run from the repository root after editing the vocabulary:
+
+    python3 Tools/gen_vocab.py
+"""
+
+import os
+import re
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SOURCE = os.path.join(ROOT, "Tools", "vocab.txt")
+HEADER = os.path.join(ROOT, "Core", "Inc", "rdf_vocab.h")
+SOURCE_C = os.path.join(ROOT, "Core", "Src", "rdf_vocab.c")
+
+MASK = 0xFFFFFFFF
+
+
+def vocab_hash(data, tail):
+    # Must match vocabHash() in the generated C: FNV-1a over the length and
+    # the last tail bytes, which is where vocabulary IRIs differ
+    h = 2166136261 ^ len(data)
+    for byte in data[-tail:]:
+        h ^= byte
+        h = (h * 16777619) & MASK
+    return h
+
+
+def vocab_mix(h, seed):
+    # Must match vocabMix(): a displaced slot rehashes the base hash only
+    h = (h ^ (seed * 0x9E3779B9)) & MASK
+    h ^= h >> 16
+    h = (h * 0x7FEB352D) & MASK
+    h ^= h >> 15
+    h = (h * 0x846CA68B) & MASK
+    h ^= h >> 16
+    return h
+
+
+def hash_tail(keys):
+    """Shortest tail length that, with the key length, tells all keys apart."""
+    for tail in range(1, max(len(k) for k in keys) + 1):
+        if len({(len(k), k[-tail:]) for k in keys}) == len(keys):
+            return tail
+    sys.exit("gen_vocab: keys are not distinct")
+
+
+def perfect_hash(keys, tail):
+    """Hash-and-displace: returns (displacement table, slot -> key index)."""
+    n = len(keys)
+    hashes = [vocab_hash(key, tail) for key in keys]
+    buckets = [[] for _ in range(n)]
+    for index, h in enumerate(hashes):
+        buckets[h % n].append(index)
+
+    displacement = [0] * n
+    slots = [None] * n
+    order = sorted(range(n), key=lambda b: -len(buckets[b]))
+    for b in order:
+        bucket = buckets[b]
+        if len(bucket) <= 1:
+            break
+        for seed in range(1, 1 << 15):
+            taken = set()
+            for index in bucket:
+                slot = vocab_mix(hashes[index], seed) % n
+                if slots[slot] is not None or slot in taken:
+                    break
+                taken.add(slot)
+            else:
+                for index in bucket:
+                    slots[vocab_mix(hashes[index], seed) % n] = index
+                displacement[b] = seed
+                break
+        else:
+            sys.exit("gen_vocab: no displacement found for bucket %d" % b)
+
+    free = [slot for slot in range(n) if slots[slot] is None]
+    for b in order:
+        if len(buckets[b]) == 1:
+            slot = free.pop()
+            slots[slot] = buckets[b][0]
+            displacement[b] = -slot - 1
+    return displacement, slots
+
+
+def enum_name(prefix, name):
+    snake = re.sub(r"(?<=[a-z0-9])([A-Z])", r"_\1", name)
+    return "%s_%s" % (prefix.upper(), snake.upper())
+
+
+def enum_names(prefixes, terms):
+    # A class and a property may differ only in the case of their first
+    # letter (VerifiableCredential, verifiableCredential); the property
+    # then gets a _PROPERTY suffix
+    names = [enum_name(prefixes[p][0], name) for p, name in terms]
+    for i, (_, name) in enumerate(terms):
+        if names.count(names[i]) > 1 and name[0].islower():
+            names[i] += "_PROPERTY"
+    duplicates = sorted({name for name in names if names.count(name) > 1})
+    if duplicates:
+        sys.exit("gen_vocab: enum names used twice: %s" % ", ".join(duplicates))
+    return names
+
+
+def parse(path):
+    prefixes, terms = [], []
+    with open(path) as f:
+        for line in f:
+            # '#' starts a comment unless it is part of an IRI
+            line = re.sub(r"(^|\s)#.*", "", line).split()
+            if not line:
+                continue
+            if line[0] == "prefix":
+                prefixes.append((line[1], line[2]))
+                continue
+            names = [p for p, _ in prefixes]
+            if line[0] not in names:
+                sys.exit("gen_vocab: unknown prefix %s" % line[0])
+            for name in line[1:]:
+                terms.append((names.index(line[0]), name))
+
+    compact = [name for _, name in terms]
+    duplicates = sorted({name for name in compact if compact.count(name) > 1})
+    if duplicates:
+        sys.exit("gen_vocab: compact names used twice: %s" % ", ".join(duplicates))
+    if len(set(iri for _, iri in prefixes)) != len(prefixes):
+        sys.exit("gen_vocab: namespace listed twice")
+    if len(terms) >= 255 or len(prefixes) >= 255:
+        sys.exit("gen_vocab: too many terms for 8-bit ids")
+    return prefixes, terms
+
+
+def prefix_trie(iris):
+    """Path-compressed trie of the namespace IRIs as [label, child, sibling,
+    prefix] nodes; node 0 is the root and 0 also means no child or sibling."""
+    nodes = [[b"", 0, 0, None]]
+
+    def add_children(parent, items, depth):
+        groups = {}
+        for iri, index in items:
+            groups.setdefault(iri[depth], []).append((iri, index))
+        previous = None
+        for first in sorted(groups):
+            group = groups[first]
+            # Every namespace in the group runs at least to the end of the
+            # common part, so one can only end right there
+            end = len(os.path.commonprefix([iri for iri, _ in group]))
+            ending = [index for iri, index in group if len(iri) == end]
+            node = len(nodes)
+            nodes.append([group[0][0][depth:end], 0, 0, ending[0] if ending else None])
+            if previous is None:
+                nodes[parent][1] = node
+            else:
+                nodes[previous][2] = node
+            previous = node
+            add_children(node, [(iri, index) for iri, index in group if len(iri) > end], end)
+
+    add_children(0, [(iri, index) for index, iri in enumerate(iris)], 0)
+    if len(nodes) > 255:
+        sys.exit("gen_vocab: prefix trie too large for 8-bit links")
+    return nodes
+
+
+def prefix_order(iris):
+    """Sign of comparing IRIs in namespaces a and b, 0 if one namespace
+    starts with the other and the rest of the IRIs decides."""
+    table = []
+    for a in iris:
+        row = []
+        for b in iris:
+            if a.startswith(b) or b.startswith(a):
+                row.append(0)
+            else:
+                row.append(-1 if a < b else 1)
+        table.append(row)
+    return table
+
+
+def c_table(values, per_line=12):
+    rows = []
+    for i in range(0, len(values), per_line):
+        rows.append("    " + ", ".join(str(v) for v in values[i:i + per_line]) + ",")
+    return "\n".join(rows)
+
+
+def main():
+    prefixes, terms = parse(SOURCE)
+    iris = [(prefixes[p][1] + name).encode() for p, name in terms]
+    names = [name.encode() for _, name in terms]
+    tail = max(hash_tail(iris), hash_tail(names))
+    iri_displacement, iri_slots = perfect_hash(iris, tail)
+    name_displacement, name_slots = perfect_hash(names, tail)
+    enums = enum_names(prefixes, terms)
+    count = len(terms)
+    namespaces = [iri.encode() for _, iri in prefixes]
+    trie = prefix_trie(namespaces)
+    order = prefix_order(namespaces)
+
+    h = []
+    h.append("/* Generated by Tools/gen_vocab.py from Tools/vocab.txt, do not edit. */\n")
+    h.append("#ifndef RDF_VOCAB_H\n#define RDF_VOCAB_H\n")
+    h.append("#include <stddef.h>\n#include <stdint.h>\n")
+    h.append("typedef enum {")
+    for i, e in enumerate(enums):
+        h.append("    RDF_VOCAB_%s = %d," % (e, i))
+    h.append("    RDF_VOCAB_COUNT = %d," % count)
+    h.append("    RDF_VOCAB_NONE = RDF_VOCAB_COUNT")
+    h.append("} RDFVocabTerm;\n")
+    h.append("#define RDF_VOCAB_PREFIX_COUNT %d" % len(prefixes))
+    h.append("#define RDF_VOCAB_NO_PREFIX 0xFF\n")
+    for (p, name), e in zip(terms, enums):
+        h.append('#define RDF_IRI_%s "%s%s"' % (e, prefixes[p][1], name))
+    h.append("")
+    h.append("typedef struct {")
+    h.append("    const char *iri;")
+    h.append("    uint8_t length;")
+    h.append("} RDFVocabPrefix;\n")
+    h.append("// The expanded IRI is the prefix's namespace followed by the term's local")
+    h.append("// name, which is also its compact form")
+    h.append("typedef struct {")
+    h.append("    const char *iri;")
+    h.append("    uint8_t length;")
+    h.append("    uint8_t nameLength;")
+    h.append("    uint8_t prefix;")
+    h.append("} RDFVocabEntry;\n")
+    h.append("extern const RDFVocabPrefix RDFVocab_prefixes[RDF_VOCAB_PREFIX_COUNT];")
+    h.append("extern const RDFVocabEntry RDFVocab_terms[RDF_VOCAB_COUNT];\n")
+    h.append("// How IRIs starting with prefixes a != b compare: -1 or 1 when the")
+    h.append("// prefixes alone decide, 0 when one prefix starts with the other")
+    h.append("extern const int8_t RDFVocab_prefixOrder[RDF_VOCAB_PREFIX_COUNT][RDF_VOCAB_PREFIX_COUNT];\n")
+    h.append("// Return the term with this expanded IRI or compact name, RDF_VOCAB_NONE")
+    h.append("// if there is none")
+    h.append("RDFVocabTerm RDFVocab_lookupIRI(const char *iri, size_t len);")
+    h.append("RDFVocabTerm RDFVocab_lookupCompact(const char *name, size_t len);\n")
+    h.append("// Index of the longest prefix iri[0..len) starts with, RDF_VOCAB_NO_PREFIX")
+    h.append("// if it starts with none")
+    h.append("uint8_t RDFVocab_matchPrefix(const char *iri, size_t len);\n")
+    h.append("static inline const char *RDFVocab_iri(RDFVocabTerm term)\n{\n    return RDFVocab_terms[term].iri;\n}\n")
+    h.append("static inline const char *RDFVocab_compact(RDFVocabTerm term)\n{\n    return RDFVocab_terms[term].iri + RDFVocab_terms[term].length - RDFVocab_terms[term].nameLength;\n}\n")
+    h.append("#endif /* RDF_VOCAB_H */")
+
+    c = []
+    c.append("/* Generated by Tools/gen_vocab.py from Tools/vocab.txt, do not edit. */\n")
+    c.append('#include "rdf_vocab.h"\n')
+    c.append("#include <string.h>\n")
+    c.append("const RDFVocabPrefix RDFVocab_prefixes[RDF_VOCAB_PREFIX_COUNT] = {")
+    for prefix, iri in prefixes:
+        c.append('    { "%s", %d },' % (iri, len(iri)))
+    c.append("};\n")
+    c.append("const int8_t RDFVocab_prefixOrder[RDF_VOCAB_PREFIX_COUNT][RDF_VOCAB_PREFIX_COUNT] = {")
+    for row in order:
+        c.append("    { %s }," % ", ".join("%2d" % v for v in row))
+    c.append("};\n")
+    c.append("// Prefix trie: a node's label is the text on the edge leading to it;")
+    c.append("// 0 links to nothing, since the root is nobody's child or sibling")
+    c.append("typedef struct {")
+    c.append("    const char *label;")
+    c.append("    uint8_t labelLength;")
+    c.append("    uint8_t child;")
+    c.append("    uint8_t sibling;")
+    c.append("    uint8_t prefix;")
+    c.append("} TrieNode;\n")
+    c.append("static const TrieNode prefixTrie[%d] = {" % len(trie))
+    for label, child, sibling, prefix in trie:
+        c.append('    { "%s", %d, %d, %d, %s },' % (label.decode(), len(label), child, sibling,
+                                                  "RDF_VOCAB_NO_PREFIX" if prefix is None else prefix))
+    c.append("};\n")
+    c.append("const RDFVocabEntry RDFVocab_terms[RDF_VOCAB_COUNT] = {")
+    for (p, name), e in zip(terms, enums):
+        c.append('    [RDF_VOCAB_%s] = { RDF_IRI_%s, %d, %d, %d },' % (e, e, len(prefixes[p][1] + name), len(name), p))
+    c.append("};\n")
+    c.append("// Minimal perfect hashes (hash and displace): with h = vocabHash(key),")
+    c.append("// bucket h %% %d holds d; d < 0 places the key in slot -d - 1, otherwise" % count)
+    c.append("// in slot vocabMix(h, d) %% %d" % count)
+    c.append("#define HASH_TAIL %d\n" % tail)
+    c.append("static const int16_t iriDisplacement[RDF_VOCAB_COUNT] = {")
+    c.append(c_table(iri_displacement))
+    c.append("};\n")
+    c.append("static const uint8_t iriSlots[RDF_VOCAB_COUNT] = {")
+    c.append(c_table(iri_slots))
+    c.append("};\n")
+    c.append("static const int16_t compactDisplacement[RDF_VOCAB_COUNT] = {")
+    c.append(c_table(name_displacement))
+    c.append("};\n")
+    c.append("static const uint8_t compactSlots[RDF_VOCAB_COUNT] = {")
+    c.append(c_table(name_slots))
+    c.append("};\n")
+    c.append(r'''// Only the length and the last HASH_TAIL bytes are hashed: vocabulary
+// IRIs share long namespace prefixes and differ in their local names
+static uint32_t vocabHash(const char *str, size_t len)
+{
+    uint32_t h = 2166136261u ^ (uint32_t)len;
+    for (size_t i = len > HASH_TAIL ? len - HASH_TAIL : 0; i < len; i++) {
+        h ^= (uint8_t)str[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static uint32_t vocabMix(uint32_t h, uint32_t seed)
+{
+    h ^= seed * 0x9E3779B9u;
+    h ^= h >> 16;
+    h *= 0x7FEB352Du;
+    h ^= h >> 15;
+    h *= 0x846CA68Bu;
+    h ^= h >> 16;
+    return h;
+}
+
+static RDFVocabTerm candidate(const int16_t *displacement, const uint8_t *slots, const char *key, size_t len)
+{
+    uint32_t h = vocabHash(key, len);
+    int16_t d = displacement[h % RDF_VOCAB_COUNT];
+    uint32_t slot = d < 0 ? (uint32_t)(-d - 1) : vocabMix(h, (uint32_t)d) % RDF_VOCAB_COUNT;
+    return (RDFVocabTerm)slots[slot];
+}
+
+RDFVocabTerm RDFVocab_lookupIRI(const char *iri, size_t len)
+{
+    RDFVocabTerm term = candidate(iriDisplacement, iriSlots, iri, len);
+    const RDFVocabEntry *entry = &RDFVocab_terms[term];
+
+    if (len != entry->length || memcmp(iri, entry->iri, len) != 0) {
+        return RDF_VOCAB_NONE;
+    }
+    return term;
+}
+
+RDFVocabTerm RDFVocab_lookupCompact(const char *name, size_t len)
+{
+    RDFVocabTerm term = candidate(compactDisplacement, compactSlots, name, len);
+
+    if (len != RDFVocab_terms[term].nameLength || memcmp(name, RDFVocab_compact(term), len) != 0) {
+        return RDF_VOCAB_NONE;
+    }
+    return term;
+}
+
+// Siblings differ in the first byte of their label, so at most one of
+// them can match and the walk never backtracks
+uint8_t RDFVocab_matchPrefix(const char *iri, size_t len)
+{
+    uint8_t match = RDF_VOCAB_NO_PREFIX;
+    size_t depth = 0;
+    uint8_t node = prefixTrie[0].child;
+
+    while (node != 0 && depth < len) {
+        const TrieNode *n = &prefixTrie[node];
+        if (iri[depth] != n->label[0]) {
+            node = n->sibling;
+            continue;
+        }
+        if (len - depth < n->labelLength || memcmp(iri + depth, n->label, n->labelLength) != 0) {
+            break;
+        }
+        depth += n->labelLength;
+        if (n->prefix != RDF_VOCAB_NO_PREFIX) match = n->prefix;
+        node = n->child;
+    }
+    return match;
+}''')
+
+    with open(HEADER, "w") as f:
+        f.write("\n".join(h) + "\n")
+    with open(SOURCE_C, "w") as f:
+        f.write("\n".join(c) + "\n")
+    print("gen_vocab: %d terms, %d prefixes" % (count, len(prefixes)))
+
+
+if __name__ == "__main__":
+    main()